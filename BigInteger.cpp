@@ -0,0 +1,455 @@
+#include "BigInteger.h"
+#include "NumberTheory.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+using Limbs = std::vector<std::uint64_t>;
+using Wide = unsigned __int128;
+using SignedWide = __int128;
+
+constexpr std::uint64_t DECIMAL_CHUNK = 1000000000000000000ULL; // 10^18
+constexpr int DECIMAL_CHUNK_DIGITS = 18;
+
+int compareMagnitude(const Limbs& a, const Limbs& b) {
+    if (a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+    for (std::size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// a += b
+void addMagnitude(Limbs& a, const Limbs& b) {
+    if (a.size() < b.size())
+        a.resize(b.size(), 0);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        Wide sum = static_cast<Wide>(a[i]) + (i < b.size() ? b[i] : 0) + carry;
+        a[i] = static_cast<std::uint64_t>(sum);
+        carry = static_cast<std::uint64_t>(sum >> 64);
+        if (carry == 0 && i >= b.size())
+            break;
+    }
+    if (carry)
+        a.push_back(carry);
+}
+
+// a -= b, requires |a| >= |b|; leading zeros are left for the caller to trim
+void subtractMagnitude(Limbs& a, const Limbs& b) {
+    std::uint64_t borrow = 0;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        std::uint64_t bi = i < b.size() ? b[i] : 0;
+        std::uint64_t diff = a[i] - bi - borrow;
+        borrow = (a[i] < bi || (a[i] == bi && borrow)) ? 1 : 0;
+        a[i] = diff;
+        if (borrow == 0 && i >= b.size())
+            break;
+    }
+}
+
+// Schoolbook product
+Limbs multiplyMagnitude(const Limbs& a, const Limbs& b) {
+    if (a.empty() || b.empty())
+        return {};
+    Limbs result(a.size() + b.size(), 0);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        std::uint64_t carry = 0;
+        std::uint64_t ai = a[i];
+        for (std::size_t j = 0; j < b.size(); j++) {
+            Wide t = static_cast<Wide>(ai) * b[j] + result[i + j] + carry;
+            result[i + j] = static_cast<std::uint64_t>(t);
+            carry = static_cast<std::uint64_t>(t >> 64);
+        }
+        result[i + b.size()] = carry;
+    }
+    return result;
+}
+
+// a /= d in place, returning a % d
+std::uint64_t divideSmall(Limbs& a, std::uint64_t d) {
+    Wide remainder = 0;
+    for (std::size_t i = a.size(); i-- > 0;) {
+        Wide current = (remainder << 64) | a[i];
+        a[i] = static_cast<std::uint64_t>(current / d);
+        remainder = current % d;
+    }
+    return static_cast<std::uint64_t>(remainder);
+}
+
+// Knuth's algorithm D on 64-bit limbs: q = a / b, r = a % b with b.size() >= 2 and
+// |a| >= |b|. The divisor is normalized so its top bit is set, which keeps every
+// trial quotient at most two above the true digit.
+void divideMagnitude(const Limbs& a, const Limbs& b, Limbs& q, Limbs& r) {
+    const std::size_t n = b.size();
+    const std::size_t m = a.size() - n;
+    const int shift = std::countl_zero(b.back());
+
+    Limbs v(n), u(a.size() + 1);
+    for (std::size_t i = n; i-- > 0;)
+        v[i] = (b[i] << shift) | (shift && i > 0 ? b[i - 1] >> (64 - shift) : 0);
+    u[a.size()] = shift ? a.back() >> (64 - shift) : 0;
+    for (std::size_t i = a.size(); i-- > 0;)
+        u[i] = (a[i] << shift) | (shift && i > 0 ? a[i - 1] >> (64 - shift) : 0);
+
+    q.assign(m + 1, 0);
+    const Wide base = static_cast<Wide>(1) << 64;
+    for (std::size_t j = m + 1; j-- > 0;) {
+        Wide numerator = (static_cast<Wide>(u[j + n]) << 64) | u[j + n - 1];
+        Wide qhat = numerator / v[n - 1];
+        Wide rhat = numerator % v[n - 1];
+        while (qhat >= base || qhat * v[n - 2] > ((rhat << 64) | u[j + n - 2])) {
+            qhat--;
+            rhat += v[n - 1];
+            if (rhat >= base)
+                break;
+        }
+
+        // u[j .. j + n] -= qhat * v
+        SignedWide borrow = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            Wide product = qhat * v[i];
+            SignedWide t = static_cast<SignedWide>(u[i + j]) - borrow - static_cast<std::uint64_t>(product);
+            u[i + j] = static_cast<std::uint64_t>(t);
+            borrow = static_cast<SignedWide>(product >> 64) - (t >> 64);
+        }
+        SignedWide top = static_cast<SignedWide>(u[j + n]) - borrow;
+        u[j + n] = static_cast<std::uint64_t>(top);
+
+        // The trial digit was one too large: add v back
+        if (top < 0) {
+            qhat--;
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < n; i++) {
+                Wide sum = static_cast<Wide>(u[i + j]) + v[i] + carry;
+                u[i + j] = static_cast<std::uint64_t>(sum);
+                carry = static_cast<std::uint64_t>(sum >> 64);
+            }
+            u[j + n] += carry;
+        }
+        q[j] = static_cast<std::uint64_t>(qhat);
+    }
+
+    r.resize(n);
+    for (std::size_t i = 0; i < n; i++)
+        r[i] = (u[i] >> shift) | (shift ? u[i + 1] << (64 - shift) : 0);
+}
+
+} // namespace
+
+// Constructors
+BigInteger::BigInteger(long long value) : negative(value < 0) {
+    if (value != 0) {
+        // Negate in unsigned arithmetic so LLONG_MIN is representable
+        std::uint64_t magnitude = static_cast<std::uint64_t>(value);
+        limbs.push_back(negative ? ~magnitude + 1 : magnitude);
+    }
+}
+
+BigInteger::BigInteger(const std::string& digits) : negative(false) {
+    std::size_t start = 0;
+    bool minus = false;
+    if (start < digits.size() && (digits[start] == '+' || digits[start] == '-'))
+        minus = digits[start++] == '-';
+    if (start == digits.size())
+        throw std::invalid_argument("Invalid integer: " + digits);
+
+    std::size_t firstChunk = (digits.size() - start) % DECIMAL_CHUNK_DIGITS;
+    if (firstChunk == 0)
+        firstChunk = DECIMAL_CHUNK_DIGITS;
+    for (std::size_t pos = start; pos < digits.size();) {
+        std::size_t end = pos == start ? pos + firstChunk : pos + DECIMAL_CHUNK_DIGITS;
+        std::uint64_t chunk = 0, scale = 1;
+        for (; pos < end; pos++) {
+            char c = digits[pos];
+            if (c < '0' || c > '9')
+                throw std::invalid_argument("Invalid integer: " + digits);
+            chunk = chunk * 10 + static_cast<std::uint64_t>(c - '0');
+            scale *= 10;
+        }
+        // *this = *this * scale + chunk
+        std::uint64_t carry = chunk;
+        for (std::uint64_t& limb : limbs) {
+            Wide t = static_cast<Wide>(limb) * scale + carry;
+            limb = static_cast<std::uint64_t>(t);
+            carry = static_cast<std::uint64_t>(t >> 64);
+        }
+        if (carry)
+            limbs.push_back(carry);
+    }
+    negative = minus && !limbs.empty();
+}
+
+BigInteger BigInteger::fromUnsigned(unsigned long long value) {
+    BigInteger result;
+    if (value != 0)
+        result.limbs.push_back(value);
+    return result;
+}
+
+void BigInteger::trim() {
+    while (!limbs.empty() && limbs.back() == 0)
+        limbs.pop_back();
+    if (limbs.empty())
+        negative = false;
+}
+
+// Properties
+std::size_t BigInteger::bitLength() const {
+    if (limbs.empty())
+        return 0;
+    return 64 * limbs.size() - static_cast<std::size_t>(std::countl_zero(limbs.back()));
+}
+
+bool BigInteger::fitsInt64() const {
+    if (limbs.size() > 1)
+        return false;
+    if (limbs.empty())
+        return true;
+    const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<long long>::max());
+    return limbs[0] <= limit + (negative ? 1 : 0);
+}
+
+long long BigInteger::toInt64() const {
+    if (!fitsInt64())
+        throw std::out_of_range("Integer does not fit in 64 bits");
+    if (limbs.empty())
+        return 0;
+    std::uint64_t magnitude = negative ? ~limbs[0] + 1 : limbs[0];
+    return static_cast<long long>(magnitude);
+}
+
+double BigInteger::toDouble() const {
+    // The top 64 bits carry every bit a double can hold
+    int shift = static_cast<int>(std::max<std::size_t>(bitLength(), 64) - 64);
+    BigInteger top = *this >> shift;
+    double value = top.limbs.empty() ? 0.0 : static_cast<double>(top.limbs[0]);
+    value = std::ldexp(value, shift);
+    return negative ? -value : value;
+}
+
+std::string BigInteger::toString() const {
+    if (limbs.empty())
+        return "0";
+    Limbs magnitude = limbs;
+    std::vector<std::uint64_t> chunks;
+    while (!magnitude.empty()) {
+        chunks.push_back(divideSmall(magnitude, DECIMAL_CHUNK));
+        while (!magnitude.empty() && magnitude.back() == 0)
+            magnitude.pop_back();
+    }
+    std::string result = negative ? "-" : "";
+    result += std::to_string(chunks.back());
+    for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string chunk = std::to_string(chunks[i]);
+        result.append(DECIMAL_CHUNK_DIGITS - chunk.size(), '0');
+        result += chunk;
+    }
+    return result;
+}
+
+// Arithmetic
+BigInteger BigInteger::operator-() const {
+    BigInteger result = *this;
+    if (!result.limbs.empty())
+        result.negative = !negative;
+    return result;
+}
+
+BigInteger BigInteger::abs() const {
+    BigInteger result = *this;
+    result.negative = false;
+    return result;
+}
+
+BigInteger& BigInteger::operator+=(const BigInteger& other) {
+    if (negative == other.negative) {
+        addMagnitude(limbs, other.limbs);
+        return *this;
+    }
+    if (compareMagnitude(limbs, other.limbs) >= 0) {
+        subtractMagnitude(limbs, other.limbs);
+    } else {
+        Limbs difference = other.limbs;
+        subtractMagnitude(difference, limbs);
+        limbs = std::move(difference);
+        negative = other.negative;
+    }
+    trim();
+    return *this;
+}
+
+BigInteger& BigInteger::operator-=(const BigInteger& other) {
+    if (this == &other) {
+        limbs.clear();
+        negative = false;
+        return *this;
+    }
+    negative = !negative;
+    *this += other;
+    if (!limbs.empty())
+        negative = !negative;
+    return *this;
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& other) {
+    bool sign = negative != other.negative;
+    limbs = multiplyMagnitude(limbs, other.limbs);
+    negative = sign;
+    trim();
+    return *this;
+}
+
+BigInteger& BigInteger::operator/=(const BigInteger& other) {
+    BigInteger remainder;
+    divMod(*this, other, *this, remainder);
+    return *this;
+}
+
+BigInteger& BigInteger::operator%=(const BigInteger& other) {
+    BigInteger quotient;
+    divMod(*this, other, quotient, *this);
+    return *this;
+}
+
+BigInteger& BigInteger::operator<<=(int bits) {
+    if (bits < 0)
+        return *this >>= -bits;
+    if (limbs.empty() || bits == 0)
+        return *this;
+    std::size_t words = static_cast<std::size_t>(bits) / 64;
+    int shift = bits % 64;
+    if (shift) {
+        std::uint64_t carry = 0;
+        for (std::uint64_t& limb : limbs) {
+            std::uint64_t next = limb >> (64 - shift);
+            limb = (limb << shift) | carry;
+            carry = next;
+        }
+        if (carry)
+            limbs.push_back(carry);
+    }
+    limbs.insert(limbs.begin(), words, 0);
+    return *this;
+}
+
+BigInteger& BigInteger::operator>>=(int bits) {
+    if (bits < 0)
+        return *this <<= -bits;
+    std::size_t words = static_cast<std::size_t>(bits) / 64;
+    int shift = bits % 64;
+    if (words >= limbs.size()) {
+        limbs.clear();
+        negative = false;
+        return *this;
+    }
+    limbs.erase(limbs.begin(), limbs.begin() + static_cast<std::ptrdiff_t>(words));
+    if (shift) {
+        for (std::size_t i = 0; i < limbs.size(); i++) {
+            std::uint64_t high = i + 1 < limbs.size() ? limbs[i + 1] << (64 - shift) : 0;
+            limbs[i] = (limbs[i] >> shift) | high;
+        }
+    }
+    trim();
+    return *this;
+}
+
+void BigInteger::divMod(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder) {
+    if (b.limbs.empty())
+        throw std::invalid_argument("Division by zero");
+    bool quotientNegative = a.negative != b.negative;
+    bool remainderNegative = a.negative;
+
+    Limbs q, r;
+    if (compareMagnitude(a.limbs, b.limbs) < 0) {
+        r = a.limbs;
+    } else if (b.limbs.size() == 1) {
+        q = a.limbs;
+        std::uint64_t rest = divideSmall(q, b.limbs[0]);
+        if (rest)
+            r.push_back(rest);
+    } else {
+        divideMagnitude(a.limbs, b.limbs, q, r);
+    }
+
+    quotient.limbs = std::move(q);
+    quotient.negative = quotientNegative;
+    quotient.trim();
+    remainder.limbs = std::move(r);
+    remainder.negative = remainderNegative;
+    remainder.trim();
+}
+
+BigInteger BigInteger::gcd(BigInteger a, BigInteger b) {
+    a.negative = false;
+    b.negative = false;
+    while (!b.limbs.empty()) {
+        // Finish in machine words once both operands fit
+        if (a.limbs.size() <= 1 && b.limbs.size() <= 1)
+            return fromUnsigned(numbertheory::gcd64(a.limbs.empty() ? 0 : a.limbs[0], b.limbs[0]));
+        a %= b;
+        std::swap(a, b);
+    }
+    return a;
+}
+
+// Comparison
+int BigInteger::compare(const BigInteger& a, const BigInteger& b) {
+    if (a.negative != b.negative)
+        return a.negative ? -1 : 1;
+    int magnitude = compareMagnitude(a.limbs, b.limbs);
+    return a.negative ? -magnitude : magnitude;
+}
+
+bool operator==(const BigInteger& a, const BigInteger& b) {
+    return a.negative == b.negative && a.limbs == b.limbs;
+}
+
+std::ostream& operator<<(std::ostream& out, const BigInteger& value) {
+    out << value.toString();
+    return out;
+}
+
+BigInteger operator+(BigInteger a, const BigInteger& b) {
+    a += b;
+    return a;
+}
+
+BigInteger operator-(BigInteger a, const BigInteger& b) {
+    a -= b;
+    return a;
+}
+
+BigInteger operator*(const BigInteger& a, const BigInteger& b) {
+    BigInteger result = a;
+    result *= b;
+    return result;
+}
+
+BigInteger operator/(const BigInteger& a, const BigInteger& b) {
+    BigInteger quotient, remainder;
+    BigInteger::divMod(a, b, quotient, remainder);
+    return quotient;
+}
+
+BigInteger operator%(const BigInteger& a, const BigInteger& b) {
+    BigInteger quotient, remainder;
+    BigInteger::divMod(a, b, quotient, remainder);
+    return remainder;
+}
+
+BigInteger operator<<(BigInteger a, int bits) {
+    a <<= bits;
+    return a;
+}
+
+BigInteger operator>>(BigInteger a, int bits) {
+    a >>= bits;
+    return a;
+}
@@ -0,0 +1,79 @@
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Arbitrary-precision signed integer in sign-magnitude form. The magnitude is stored
+// as 64-bit limbs, least significant first, without leading zero limbs; zero has no
+// limbs and is never negative. Division truncates toward zero like the built-in
+// integer types, so a % b takes the sign of a.
+class BigInteger {
+private:
+    bool negative;
+    std::vector<std::uint64_t> limbs;
+
+    void trim();
+
+public:
+    // Constructors
+    BigInteger(long long value = 0);
+    explicit BigInteger(const std::string& digits);
+
+    static BigInteger fromUnsigned(unsigned long long value);
+
+    // Properties
+    bool isZero() const { return limbs.empty(); }
+    bool isNegative() const { return negative; }
+    int sign() const { return negative ? -1 : (limbs.empty() ? 0 : 1); }
+    std::size_t bitLength() const;
+    std::size_t limbCount() const { return limbs.size(); }
+
+    // Conversions. toInt64() requires fitsInt64(); toDouble() is within one unit in
+    // the last place and overflows to infinity beyond the double range.
+    bool fitsInt64() const;
+    long long toInt64() const;
+    double toDouble() const;
+    std::string toString() const;
+
+    // Arithmetic
+    BigInteger operator-() const;
+    BigInteger abs() const;
+    BigInteger& operator+=(const BigInteger& other);
+    BigInteger& operator-=(const BigInteger& other);
+    BigInteger& operator*=(const BigInteger& other);
+    BigInteger& operator/=(const BigInteger& other);
+    BigInteger& operator%=(const BigInteger& other);
+    BigInteger& operator<<=(int bits);
+    BigInteger& operator>>=(int bits); // shifts the magnitude; the sign is kept
+
+    // Quotient and remainder in one pass
+    static void divMod(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder);
+
+    // Non-negative greatest common divisor; gcd(0, 0) == 0
+    static BigInteger gcd(BigInteger a, BigInteger b);
+
+    // Comparison: negative, zero or positive as a <, == or > b
+    static int compare(const BigInteger& a, const BigInteger& b);
+
+    friend bool operator==(const BigInteger& a, const BigInteger& b);
+    friend std::ostream& operator<<(std::ostream& out, const BigInteger& value);
+};
+
+BigInteger operator+(BigInteger a, const BigInteger& b);
+BigInteger operator-(BigInteger a, const BigInteger& b);
+BigInteger operator*(const BigInteger& a, const BigInteger& b);
+BigInteger operator/(const BigInteger& a, const BigInteger& b);
+BigInteger operator%(const BigInteger& a, const BigInteger& b);
+BigInteger operator<<(BigInteger a, int bits);
+BigInteger operator>>(BigInteger a, int bits);
+
+inline bool operator!=(const BigInteger& a, const BigInteger& b) { return !(a == b); }
+inline bool operator<(const BigInteger& a, const BigInteger& b) { return BigInteger::compare(a, b) < 0; }
+inline bool operator>(const BigInteger& a, const BigInteger& b) { return BigInteger::compare(a, b) > 0; }
+inline bool operator<=(const BigInteger& a, const BigInteger& b) { return BigInteger::compare(a, b) <= 0; }
+inline bool operator>=(const BigInteger& a, const BigInteger& b) { return BigInteger::compare(a, b) >= 0; }
+
+#endif // BIG_INTEGER_H
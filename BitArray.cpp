@@ -0,0 +1,460 @@
+#include "BitArray.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace {
+
+// Words per unrolled step; every kernel loop below runs over whole chunks so the
+// compiler vectorizes it with a constant trip count, then finishes the tail.
+constexpr std::size_t CHUNK = 8;
+
+// Arrays at least this many words long are split into tasks of TASK_WORDS words
+constexpr std::size_t PARALLEL_WORDS = std::size_t(1) << 18;
+constexpr std::size_t TASK_WORDS = std::size_t(1) << 16;
+
+// The elementwise loops are independent even when the output is one of the inputs
+#if defined(__clang__)
+#define BITARRAY_INDEPENDENT _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define BITARRAY_INDEPENDENT _Pragma("GCC ivdep")
+#else
+#define BITARRAY_INDEPENDENT
+#endif
+
+#if defined(__GNUC__)
+#define BITARRAY_INLINE inline __attribute__((always_inline))
+#else
+#define BITARRAY_INLINE inline
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITARRAY_HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// Arguments of one kernel call; each operation reads the operands it needs and
+// writes r
+struct Words {
+    const std::uint64_t* a;
+    const std::uint64_t* b;
+    const std::uint64_t* c;
+    std::uint64_t* r;
+};
+
+// Elementwise operations on word k
+struct And {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = p.a[k] & p.b[k]; }
+};
+
+struct Or {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = p.a[k] | p.b[k]; }
+};
+
+struct Xor {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = p.a[k] ^ p.b[k]; }
+};
+
+struct AndNot {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = p.a[k] & ~p.b[k]; }
+};
+
+struct Not {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = ~p.a[k]; }
+};
+
+struct OrAnd {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = p.a[k] | (p.b[k] & p.c[k]); }
+};
+
+struct XorAnd {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = p.a[k] ^ (p.b[k] & p.c[k]); }
+};
+
+struct AndOr {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) { p.r[k] = p.a[k] & (p.b[k] | p.c[k]); }
+};
+
+// a ? b : c, bit by bit
+struct Select {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) {
+        std::uint64_t c = p.c[k];
+        p.r[k] = c ^ (p.a[k] & (p.b[k] ^ c));
+    }
+};
+
+struct Majority {
+    static BITARRAY_INLINE void apply(const Words& p, std::size_t k) {
+        std::uint64_t a = p.a[k], b = p.b[k];
+        p.r[k] = (a & b) | (p.c[k] & (a | b));
+    }
+};
+
+template <typename Op>
+BITARRAY_INLINE void runBody(Words p, std::size_t n) {
+    std::size_t k = 0;
+    for (; k + CHUNK <= n; k += CHUNK) {
+        BITARRAY_INDEPENDENT
+        for (std::size_t l = 0; l < CHUNK; l++)
+            Op::apply(p, k + l);
+    }
+    for (; k < n; k++)
+        Op::apply(p, k);
+}
+
+using Kernel = void (*)(Words p, std::size_t n);
+
+template <typename Op>
+void runGeneric(Words p, std::size_t n) {
+    runBody<Op>(p, n);
+}
+
+#ifdef BITARRAY_HAVE_X86_DISPATCH
+template <typename Op>
+__attribute__((target("avx2")))
+void runAvx2(Words p, std::size_t n) {
+    runBody<Op>(p, n);
+}
+#endif
+
+const std::uint64_t* advance(const std::uint64_t* p, std::size_t k) {
+    return p ? p + k : nullptr;
+}
+
+// Pick the AVX2 instantiation once if the CPU supports it; long arrays are split
+// across the thread pool
+template <typename Op>
+void run(const Words& p, std::size_t n) {
+#ifdef BITARRAY_HAVE_X86_DISPATCH
+    static const Kernel kernel = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? runAvx2<Op> : runGeneric<Op>;
+    }();
+#else
+    static const Kernel kernel = runGeneric<Op>;
+#endif
+    if (n < PARALLEL_WORDS || ThreadPool::instance().threadCount() <= 1) {
+        kernel(p, n);
+        return;
+    }
+    int tasks = static_cast<int>((n + TASK_WORDS - 1) / TASK_WORDS);
+    ThreadPool::instance().parallelFor(tasks, [&](int t) {
+        std::size_t begin = static_cast<std::size_t>(t) * TASK_WORDS;
+        Words q{advance(p.a, begin), advance(p.b, begin), advance(p.c, begin), p.r + begin};
+        kernel(q, std::min(n, begin + TASK_WORDS) - begin);
+    });
+}
+
+// Counting and searching
+struct Kernels {
+    const char* name;
+    std::size_t (*popcount)(const std::uint64_t* w, std::size_t n);
+    std::size_t (*findNonZero)(const std::uint64_t* w, std::size_t n); // n if every word is 0
+};
+
+std::size_t popcountScalar(const std::uint64_t* w, std::size_t n) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++)
+        count += std::popcount(w[i]);
+    return count;
+}
+
+std::size_t findNonZeroScalar(const std::uint64_t* w, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+        if (w[i] != 0)
+            return i;
+    }
+    return n;
+}
+
+#ifdef BITARRAY_HAVE_X86_DISPATCH
+// Nibble lookup (Mula): pshufb counts the bits of each half byte, and the byte
+// counts (at most 8 per step) are widened with psadbw every 31 steps
+__attribute__((target("avx2")))
+std::size_t popcountAvx2(const std::uint64_t* w, std::size_t n) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    const std::size_t whole = n & ~std::size_t(3);
+    __m256i total = _mm256_setzero_si256();
+    std::size_t i = 0;
+    while (i < whole) {
+        __m256i bytes = _mm256_setzero_si256();
+        std::size_t end = std::min(whole, i + 4 * 31);
+        for (; i < end; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+            __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+            __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            bytes = _mm256_add_epi8(bytes, _mm256_add_epi8(lo, hi));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    std::size_t count = _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1)
+        + _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+    for (; i < n; i++)
+        count += _mm_popcnt_u64(w[i]);
+    return count;
+}
+
+// Eight words per test; the hit is located within its block by the scalar loop
+__attribute__((target("avx2")))
+std::size_t findNonZeroAvx2(const std::uint64_t* w, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i)),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i + 4)));
+        if (!_mm256_testz_si256(v, v))
+            break;
+    }
+    return i + findNonZeroScalar(w + i, n - i);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+std::size_t popcountAvx512(const std::uint64_t* w, std::size_t n) {
+    __m512i total = _mm512_setzero_si512();
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 mask = n - i >= 8 ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, w + i)));
+    }
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, total);
+    std::size_t count = 0;
+    for (std::uint64_t lane : lanes)
+        count += lane;
+    return count;
+}
+#endif
+
+Kernels selectKernels() {
+#ifdef BITARRAY_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+        return {"avx512", popcountAvx512, findNonZeroAvx2};
+    if (__builtin_cpu_supports("avx2"))
+        return {"avx2", popcountAvx2, findNonZeroAvx2};
+#endif
+    return {"scalar", popcountScalar, findNonZeroScalar};
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+std::size_t wordsFor(std::size_t bits) {
+    return (bits + 63) / 64;
+}
+
+} // namespace
+
+// Constructor
+BitArray::BitArray(std::size_t n) : bits(n), words(wordsFor(n), 0) {}
+
+void BitArray::clearPadding() {
+    if (bits % 64 != 0)
+        words.back() &= (std::uint64_t(1) << (bits % 64)) - 1;
+}
+
+// Resize, keeping the leading bits; new bits are 0
+void BitArray::resize(std::size_t n) {
+    bits = n;
+    words.resize(wordsFor(n), 0);
+    clearPadding();
+}
+
+void BitArray::fill(bool value) {
+    std::fill(words.begin(), words.end(), value ? ~std::uint64_t(0) : 0);
+    clearPadding();
+}
+
+// Counting and searching. Popcount sums per-task counts; the search stays serial so
+// that it can stop at the first hit.
+std::size_t BitArray::popcount() const {
+    std::size_t n = words.size();
+    if (n < PARALLEL_WORDS || ThreadPool::instance().threadCount() <= 1)
+        return kernels().popcount(words.data(), n);
+    int tasks = static_cast<int>((n + TASK_WORDS - 1) / TASK_WORDS);
+    std::vector<std::size_t> counts(tasks);
+    ThreadPool::instance().parallelFor(tasks, [&](int t) {
+        std::size_t begin = static_cast<std::size_t>(t) * TASK_WORDS;
+        counts[t] = kernels().popcount(words.data() + begin, std::min(n, begin + TASK_WORDS) - begin);
+    });
+    std::size_t total = 0;
+    for (std::size_t count : counts)
+        total += count;
+    return total;
+}
+
+std::size_t BitArray::findNextSet(std::size_t from) const {
+    if (from >= bits)
+        return bits;
+    std::size_t k = from / 64;
+    std::uint64_t first = words[k] & (~std::uint64_t(0) << (from % 64));
+    if (first != 0)
+        return k * 64 + std::countr_zero(first);
+    k++;
+    k += kernels().findNonZero(words.data() + k, words.size() - k);
+    return k < words.size() ? k * 64 + std::countr_zero(words[k]) : bits;
+}
+
+// In place
+BitArray& BitArray::operator&=(const BitArray& other) {
+    bitAnd(*this, other, *this);
+    return *this;
+}
+
+BitArray& BitArray::operator|=(const BitArray& other) {
+    bitOr(*this, other, *this);
+    return *this;
+}
+
+BitArray& BitArray::operator^=(const BitArray& other) {
+    bitXor(*this, other, *this);
+    return *this;
+}
+
+BitArray& BitArray::andNot(const BitArray& other) {
+    bitAndNot(*this, other, *this);
+    return *this;
+}
+
+BitArray& BitArray::invert() {
+    bitNot(*this, *this);
+    return *this;
+}
+
+// ~x + 1: the carry stops at the lowest non-zero word, so the words below it stay 0,
+// that word is negated and every word above it is inverted
+BitArray& BitArray::negate() {
+    std::size_t k = kernels().findNonZero(words.data(), words.size());
+    if (k == words.size())
+        return *this;
+    words[k] = 0 - words[k];
+    k++;
+    run<Not>(Words{words.data() + k, nullptr, nullptr, words.data() + k}, words.size() - k);
+    clearPadding();
+    return *this;
+}
+
+// Toward higher indices. Each word is built from two source words below it, so the
+// pass runs from the top down and never reads a word it has already written.
+BitArray& BitArray::operator<<=(std::size_t count) {
+    if (count >= bits) {
+        fill(false);
+        return *this;
+    }
+    std::size_t n = words.size(), wordShift = count / 64;
+    int bitShift = static_cast<int>(count % 64);
+    std::uint64_t* w = words.data();
+    if (bitShift == 0) {
+        std::copy_backward(w, w + n - wordShift, w + n);
+    } else {
+        for (std::size_t i = n - 1; i > wordShift; i--)
+            w[i] = (w[i - wordShift] << bitShift) | (w[i - wordShift - 1] >> (64 - bitShift));
+        w[wordShift] = w[0] << bitShift;
+    }
+    std::fill(w, w + wordShift, 0);
+    clearPadding();
+    return *this;
+}
+
+// Toward lower indices, bottom up
+BitArray& BitArray::operator>>=(std::size_t count) {
+    if (count >= bits) {
+        fill(false);
+        return *this;
+    }
+    std::size_t n = words.size(), wordShift = count / 64;
+    int bitShift = static_cast<int>(count % 64);
+    std::uint64_t* w = words.data();
+    if (bitShift == 0) {
+        std::copy(w + wordShift, w + n, w);
+    } else {
+        for (std::size_t i = 0; i + wordShift + 1 < n; i++)
+            w[i] = (w[i + wordShift] >> bitShift) | (w[i + wordShift + 1] << (64 - bitShift));
+        w[n - wordShift - 1] = w[n - 1] >> bitShift;
+    }
+    std::fill(w + n - wordShift, w + n, 0);
+    return *this;
+}
+
+// Fused in place
+BitArray& BitArray::orAnd(const BitArray& a, const BitArray& b) {
+    checkSameSize(a);
+    checkSameSize(b);
+    run<OrAnd>(Words{words.data(), a.words.data(), b.words.data(), words.data()}, words.size());
+    return *this;
+}
+
+BitArray& BitArray::xorAnd(const BitArray& a, const BitArray& b) {
+    checkSameSize(a);
+    checkSameSize(b);
+    run<XorAnd>(Words{words.data(), a.words.data(), b.words.data(), words.data()}, words.size());
+    return *this;
+}
+
+BitArray& BitArray::andOr(const BitArray& a, const BitArray& b) {
+    checkSameSize(a);
+    checkSameSize(b);
+    run<AndOr>(Words{words.data(), a.words.data(), b.words.data(), words.data()}, words.size());
+    return *this;
+}
+
+// Into a result array
+void BitArray::bitAnd(const BitArray& a, const BitArray& b, BitArray& result) {
+    a.checkSameSize(b);
+    result.resize(a.bits);
+    run<And>(Words{a.words.data(), b.words.data(), nullptr, result.words.data()}, a.words.size());
+}
+
+void BitArray::bitOr(const BitArray& a, const BitArray& b, BitArray& result) {
+    a.checkSameSize(b);
+    result.resize(a.bits);
+    run<Or>(Words{a.words.data(), b.words.data(), nullptr, result.words.data()}, a.words.size());
+}
+
+void BitArray::bitXor(const BitArray& a, const BitArray& b, BitArray& result) {
+    a.checkSameSize(b);
+    result.resize(a.bits);
+    run<Xor>(Words{a.words.data(), b.words.data(), nullptr, result.words.data()}, a.words.size());
+}
+
+void BitArray::bitAndNot(const BitArray& a, const BitArray& b, BitArray& result) {
+    a.checkSameSize(b);
+    result.resize(a.bits);
+    run<AndNot>(Words{a.words.data(), b.words.data(), nullptr, result.words.data()}, a.words.size());
+}
+
+void BitArray::bitNot(const BitArray& a, BitArray& result) {
+    result.resize(a.bits);
+    run<Not>(Words{a.words.data(), nullptr, nullptr, result.words.data()}, a.words.size());
+    result.clearPadding();
+}
+
+void BitArray::select(const BitArray& mask, const BitArray& a, const BitArray& b, BitArray& result) {
+    mask.checkSameSize(a);
+    mask.checkSameSize(b);
+    result.resize(mask.bits);
+    run<Select>(Words{mask.words.data(), a.words.data(), b.words.data(), result.words.data()}, mask.words.size());
+}
+
+void BitArray::majority(const BitArray& a, const BitArray& b, const BitArray& c, BitArray& result) {
+    a.checkSameSize(b);
+    a.checkSameSize(c);
+    result.resize(a.bits);
+    run<Majority>(Words{a.words.data(), b.words.data(), c.words.data(), result.words.data()}, a.words.size());
+}
+
+std::string BitArray::toString() const {
+    std::string text(bits, '0');
+    for (std::size_t i = 0; i < bits; i++) {
+        if ((words[i / 64] >> (i % 64)) & 1)
+            text[bits - 1 - i] = '1';
+    }
+    return text;
+}
+
+const char* BitArray::implementation() {
+    return kernels().name;
+}
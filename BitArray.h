@@ -0,0 +1,140 @@
+#ifndef BIT_ARRAY_H
+#define BIT_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "AlignedAllocator.h"
+
+// A fixed-length array of bits packed into 64-bit words, bit i in word i / 64 at
+// position i % 64. As an integer, bit 0 is the least significant: << moves bits toward
+// higher indices and negate() is two's-complement negation modulo 2^size().
+//
+// The bulk operations run word-parallel with SIMD (AVX2, and AVX-512 for popcount
+// where available) and split arrays of millions of words across the shared
+// ThreadPool. Like ComplexArray, every operation works in place or writes into a
+// caller-provided array, which is resized only when its size differs; the output may
+// be one of the operands. The fused three-operand forms (orAnd, select, majority, ...)
+// make one pass over memory where separate operators would need a temporary.
+class BitArray {
+private:
+    std::size_t bits;
+    AlignedVector<std::uint64_t> words; // bits past size() in the last word are always 0
+
+    void checkSameSize(const BitArray& other) const {
+        if (bits != other.bits)
+            throw std::invalid_argument("Bit arrays must have the same size");
+    }
+
+    void checkIndex(std::size_t i) const {
+        if (i >= bits)
+            throw std::out_of_range("Index out of range");
+    }
+
+    void clearPadding();
+
+public:
+    // n zero bits
+    explicit BitArray(std::size_t n = 0);
+
+    std::size_t size() const { return bits; }
+    std::size_t wordCount() const { return words.size(); }
+    void resize(std::size_t n); // keeps the leading bits; new bits are 0
+
+    // Packed storage, wordCount() words. Writers must leave the bits past size() at 0.
+    std::uint64_t* data() { return words.data(); }
+    const std::uint64_t* data() const { return words.data(); }
+
+    // Single bits (bounds-checked)
+    bool test(std::size_t i) const {
+        checkIndex(i);
+        return (words[i / 64] >> (i % 64)) & 1;
+    }
+    void set(std::size_t i, bool value = true) {
+        checkIndex(i);
+        std::uint64_t bit = std::uint64_t(1) << (i % 64);
+        words[i / 64] = value ? words[i / 64] | bit : words[i / 64] & ~bit;
+    }
+    void reset(std::size_t i) { set(i, false); }
+    void flip(std::size_t i) {
+        checkIndex(i);
+        words[i / 64] ^= std::uint64_t(1) << (i % 64);
+    }
+    void fill(bool value);
+
+    // Counting and searching. The find functions return size() when no bit is set.
+    std::size_t popcount() const;
+    std::size_t findFirstSet() const { return findNextSet(0); }
+    std::size_t findNextSet(std::size_t from) const; // first set bit at index >= from
+
+    // In place
+    BitArray& operator&=(const BitArray& other);
+    BitArray& operator|=(const BitArray& other);
+    BitArray& operator^=(const BitArray& other);
+    BitArray& andNot(const BitArray& other); // this &= ~other
+    BitArray& invert();                      // this = ~this
+    BitArray& negate();                      // this = -this = ~this + 1
+    BitArray& operator<<=(std::size_t count);
+    BitArray& operator>>=(std::size_t count);
+
+    // Fused in place, one pass over all three arrays
+    BitArray& orAnd(const BitArray& a, const BitArray& b);  // this |= a & b
+    BitArray& xorAnd(const BitArray& a, const BitArray& b); // this ^= a & b
+    BitArray& andOr(const BitArray& a, const BitArray& b);  // this &= a | b
+
+    // Into result
+    static void bitAnd(const BitArray& a, const BitArray& b, BitArray& result);
+    static void bitOr(const BitArray& a, const BitArray& b, BitArray& result);
+    static void bitXor(const BitArray& a, const BitArray& b, BitArray& result);
+    static void bitAndNot(const BitArray& a, const BitArray& b, BitArray& result); // a & ~b
+    static void bitNot(const BitArray& a, BitArray& result);
+
+    // Fused into result: bits of a where mask is set and of b elsewhere; and the
+    // bitwise majority of three arrays
+    static void select(const BitArray& mask, const BitArray& a, const BitArray& b, BitArray& result);
+    static void majority(const BitArray& a, const BitArray& b, const BitArray& c, BitArray& result);
+
+    // Bits from the highest index down to 0, like std::bitset::to_string
+    std::string toString() const;
+
+    // Name of the selected implementation: "avx512", "avx2" or "scalar"
+    static const char* implementation();
+
+    friend bool operator==(const BitArray& a, const BitArray& b) {
+        return a.bits == b.bits && a.words == b.words;
+    }
+};
+
+// Binary operators take the left operand by value and reuse it as the result
+inline BitArray operator&(BitArray a, const BitArray& b) {
+    a &= b;
+    return a;
+}
+
+inline BitArray operator|(BitArray a, const BitArray& b) {
+    a |= b;
+    return a;
+}
+
+inline BitArray operator^(BitArray a, const BitArray& b) {
+    a ^= b;
+    return a;
+}
+
+inline BitArray operator~(BitArray a) {
+    a.invert();
+    return a;
+}
+
+inline BitArray operator<<(BitArray a, std::size_t count) {
+    a <<= count;
+    return a;
+}
+
+inline BitArray operator>>(BitArray a, std::size_t count) {
+    a >>= count;
+    return a;
+}
+
+#endif // BIT_ARRAY_H
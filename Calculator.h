@@ -2,8 +2,13 @@
 #define CALCULATOR_H
 
 #include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
 #include <map>
 #include <string>
+#include "Combinatorics.h"
+#include "NumberTheory.h"
 
 // Trigonometric functions
 inline std::map<std::string, double> trigonometryFunctions(double angleRad)
@@ -105,6 +110,198 @@ inline std::map<std::string, double> exponentialFunctions(double value)
     return results;
 }
 
+// Selective bundles: the functions above build a string-keyed map and evaluate every
+// entry on each call. The *Values variants below take a bitmask of the functions
+// wanted, compute only those (plus what they are derived from) and return a flat
+// struct; members that were not requested are NaN.
+struct TrigFunctions
+{
+    enum : unsigned
+    {
+        Sin = 1u << 0,
+        Cos = 1u << 1,
+        Tan = 1u << 2,
+        Arcsin = 1u << 3,
+        Arccos = 1u << 4,
+        Arctan = 1u << 5,
+        Sinh = 1u << 6,
+        Cosh = 1u << 7,
+        Tanh = 1u << 8,
+        Arcsinh = 1u << 9,
+        Arccosh = 1u << 10,
+        Arctanh = 1u << 11,
+        All = (1u << 12) - 1
+    };
+};
+
+struct TrigValues
+{
+    double sin = NAN, cos = NAN, tan = NAN;
+    double arcsin = NAN, arccos = NAN, arctan = NAN;
+    double sinh = NAN, cosh = NAN, tanh = NAN;
+    double arcsinh = NAN, arccosh = NAN, arctanh = NAN;
+};
+
+// sin and cos of one argument; GCC and Clang fuse the adjacent calls into a single
+// sincos evaluation
+inline void sinCos(double x, double& s, double& c)
+{
+    s = std::sin(x);
+    c = std::cos(x);
+}
+
+inline TrigValues trigonometryValues(double angleRad, unsigned functions = TrigFunctions::All)
+{
+    TrigValues r;
+
+    // Circular functions share one argument reduction; tan is sin / cos, within a
+    // couple of ulps of std::tan
+    bool needSin = functions & (TrigFunctions::Sin | TrigFunctions::Tan | TrigFunctions::Arcsin | TrigFunctions::Arctan);
+    bool needCos = functions & (TrigFunctions::Cos | TrigFunctions::Tan | TrigFunctions::Arccos | TrigFunctions::Arctan);
+    if (needSin && needCos)
+    {
+        sinCos(angleRad, r.sin, r.cos);
+        r.tan = r.sin / r.cos;
+    }
+    else if (needSin)
+    {
+        r.sin = std::sin(angleRad);
+    }
+    else if (needCos)
+    {
+        r.cos = std::cos(angleRad);
+    }
+    if (functions & TrigFunctions::Arcsin)
+        r.arcsin = std::asin(r.sin);
+    if (functions & TrigFunctions::Arccos)
+        r.arccos = std::acos(r.cos);
+    if (functions & TrigFunctions::Arctan)
+        r.arctan = std::atan(r.tan);
+
+    // Hyperbolic functions share one expm1 when more than one is needed. The library
+    // routines take over beyond |x| = 350, where m (m + 2) below would overflow, and
+    // whenever an inverse is requested: acosh and atanh near 1 turn a last-bit
+    // difference in their argument into a large one in the result.
+    const unsigned sinhNeeded = TrigFunctions::Sinh | TrigFunctions::Arcsinh;
+    const unsigned coshNeeded = TrigFunctions::Cosh | TrigFunctions::Arccosh;
+    const unsigned tanhNeeded = TrigFunctions::Tanh | TrigFunctions::Arctanh;
+    int hyperbolicCount = ((functions & sinhNeeded) != 0) + ((functions & coshNeeded) != 0) + ((functions & tanhNeeded) != 0);
+    const unsigned inverses = TrigFunctions::Arcsinh | TrigFunctions::Arccosh | TrigFunctions::Arctanh;
+    if (hyperbolicCount > 1 && !(functions & inverses) && std::abs(angleRad) <= 350.0)
+    {
+        // With m = e^|x| - 1: sinh|x| = m (m + 2) / (2 (m + 1)), cosh x = (m + 1 + 1 / (m + 1)) / 2
+        // and tanh|x| = m (m + 2) / (m (m + 2) + 2), all free of cancellation
+        double m = std::expm1(std::abs(angleRad));
+        double p = m * (m + 2.0);
+        double sign = angleRad < 0 ? -1.0 : 1.0;
+        r.sinh = sign * p / (2.0 * (m + 1.0));
+        r.cosh = 0.5 * (m + 1.0 + 1.0 / (m + 1.0));
+        r.tanh = sign * p / (p + 2.0);
+    }
+    else
+    {
+        if (functions & sinhNeeded)
+            r.sinh = std::sinh(angleRad);
+        if (functions & coshNeeded)
+            r.cosh = std::cosh(angleRad);
+        if (functions & tanhNeeded)
+            r.tanh = std::tanh(angleRad);
+    }
+    if (functions & TrigFunctions::Arcsinh)
+        r.arcsinh = std::asinh(r.sinh);
+    if (functions & TrigFunctions::Arccosh)
+        r.arccosh = std::acosh(r.cosh);
+    if (functions & TrigFunctions::Arctanh)
+        r.arctanh = std::atanh(r.tanh);
+
+    // Clear intermediates that were computed but not asked for
+    if (!(functions & TrigFunctions::Sin))
+        r.sin = NAN;
+    if (!(functions & TrigFunctions::Cos))
+        r.cos = NAN;
+    if (!(functions & TrigFunctions::Tan))
+        r.tan = NAN;
+    if (!(functions & TrigFunctions::Sinh))
+        r.sinh = NAN;
+    if (!(functions & TrigFunctions::Cosh))
+        r.cosh = NAN;
+    if (!(functions & TrigFunctions::Tanh))
+        r.tanh = NAN;
+    return r;
+}
+
+struct LogFunctions
+{
+    enum : unsigned
+    {
+        Ln = 1u << 0,
+        Log10 = 1u << 1,
+        Log2 = 1u << 2,
+        LogBase = 1u << 3,
+        All = (1u << 4) - 1
+    };
+};
+
+struct LogValues
+{
+    double ln = NAN, log10 = NAN, log2 = NAN, logBase = NAN;
+};
+
+// logBase is the logarithm to `base` (5 in logarithmicFunctions), derived from ln
+inline LogValues logarithmicValues(double value, unsigned functions = LogFunctions::All, double base = 5.0)
+{
+    LogValues r;
+    if (!(value > 0))
+        return r;
+    if (functions & (LogFunctions::Ln | LogFunctions::LogBase))
+    {
+        double ln = std::log(value);
+        if (functions & LogFunctions::Ln)
+            r.ln = ln;
+        if ((functions & LogFunctions::LogBase) && base > 0 && base != 1)
+            r.logBase = ln / std::log(base);
+    }
+    if (functions & LogFunctions::Log10)
+        r.log10 = std::log10(value);
+    if (functions & LogFunctions::Log2)
+        r.log2 = std::log2(value);
+    return r;
+}
+
+struct ExpFunctions
+{
+    enum : unsigned
+    {
+        Exp = 1u << 0,
+        Pow2 = 1u << 1,
+        Pow10 = 1u << 2,
+        Square = 1u << 3,
+        Cube = 1u << 4,
+        All = (1u << 5) - 1
+    };
+};
+
+struct ExpValues
+{
+    double exp = NAN, pow2 = NAN, pow10 = NAN, square = NAN, cube = NAN;
+};
+
+inline ExpValues exponentialValues(double value, unsigned functions = ExpFunctions::All)
+{
+    ExpValues r;
+    if (functions & ExpFunctions::Exp)
+        r.exp = std::exp(value);
+    if (functions & ExpFunctions::Pow2)
+        r.pow2 = std::exp2(value);
+    if (functions & ExpFunctions::Pow10)
+        r.pow10 = std::pow(10.0, value);
+    if (functions & ExpFunctions::Square)
+        r.square = value * value;
+    if (functions & ExpFunctions::Cube)
+        r.cube = value * value * value;
+    return r;
+}
+
 // Logical operations
 inline std::map<std::string, bool> logicalOperations(bool a, bool b)
 {
@@ -135,33 +332,31 @@ inline std::map<std::string, int> bitwiseOperations(int x, int y)
     return results;
 }
 
-// Factorial function
+// Factorial function: exact up to 20!, std::overflow_error above; combinatorics::factorial
+// gives larger values as a BigInteger
 inline unsigned long long factorial(int n)
 {
-    unsigned long long result = 1;
-    for (int i = 1; i <= n; ++i)
-    {
-        result *= i;
-    }
-    return result;
+    return combinatorics::factorial64(n);
 }
 
-// GCD function
+// GCD function: non-negative, binary (Stein) algorithm. Exact int overloads are
+// preferred to the std::gcd template even under using namespace std; use
+// numbertheory::gcd64 for 64-bit operands.
 inline int gcd(int a, int b)
 {
-    while (b != 0)
-    {
-        int temp = b;
-        b = a % b;
-        a = temp;
-    }
-    return a;
+    std::uint64_t g = numbertheory::gcd64(numbertheory::detail::unsignedAbs(a), numbertheory::detail::unsignedAbs(b));
+    if (g > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+        throw std::overflow_error("Error: GCD exceeds the int range.");
+    return static_cast<int>(g);
 }
 
-// LCM function
+// LCM function: divides before multiplying, std::overflow_error if the result exceeds int
 inline int lcm(int a, int b)
 {
-    return std::abs(a * b) / gcd(a, b);
+    std::uint64_t l = numbertheory::lcm64(numbertheory::detail::unsignedAbs(a), numbertheory::detail::unsignedAbs(b));
+    if (l > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+        throw std::overflow_error("Error: LCM exceeds the int range.");
+    return static_cast<int>(l);
 }
 
 // Calculate roots and powers (square root, cube root, power)
@@ -182,20 +377,22 @@ inline void calculateRootsAndPowers(double value, double exponent)
               << std::fixed << std::setprecision(4) << std::pow(value, exponent) << std::endl;
 }
 
-// nCr (Combinations) function
+// nCr (Combinations) function: exact whenever the result fits in 64 bits,
+// std::overflow_error otherwise
 inline unsigned long long nCr(int n, int r)
 {
     if (r > n)
         return 0; // If r is greater than n, nCr is 0
-    return factorial(n) / (factorial(r) * factorial(n - r));
+    return combinatorics::binomial64(n, r);
 }
 
-// nPr (Permutations) function
+// nPr (Permutations) function: exact whenever the result fits in 64 bits,
+// std::overflow_error otherwise
 inline unsigned long long nPr(int n, int r)
 {
     if (r > n)
         return 0; // If r is greater than n, nPr is 0
-    return factorial(n) / factorial(n - r);
+    return combinatorics::permutations64(n, r);
 }
 
 #endif // CALCULATOR_H
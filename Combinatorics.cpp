@@ -0,0 +1,262 @@
+#include "Combinatorics.h"
+#include "ThreadPool.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace combinatorics {
+
+namespace {
+
+// Batches at least this long are split into tasks of TASK_QUERIES queries
+constexpr std::size_t PARALLEL_QUERIES = std::size_t(1) << 16;
+constexpr std::size_t TASK_QUERIES = std::size_t(1) << 14;
+
+// Primes up to n (sieve of Eratosthenes over odd numbers)
+std::vector<int> primesUpTo(int n) {
+    std::vector<int> primes;
+    if (n < 2)
+        return primes;
+    primes.push_back(2);
+    std::vector<bool> composite(n / 2 + 1, false); // index i stands for 2i + 1
+    for (long long i = 1; 2 * i + 1 <= n; i++) {
+        if (composite[i])
+            continue;
+        long long p = 2 * i + 1;
+        primes.push_back(static_cast<int>(p));
+        for (long long m = p * p; m <= n; m += 2 * p)
+            composite[m / 2] = true;
+    }
+    return primes;
+}
+
+// Exponent of the prime p in n! (Legendre's formula)
+long long legendre(long long n, long long p) {
+    long long e = 0;
+    while (n > 0) {
+        n /= p;
+        e += n;
+    }
+    return e;
+}
+
+// Factors of a product, packed into as few 64-bit words as possible
+class Factors {
+private:
+    std::vector<std::uint64_t> words;
+    std::uint64_t current = 1;
+
+public:
+    void multiply(std::uint64_t factor) {
+        std::uint64_t product;
+        if (__builtin_mul_overflow(current, factor, &product)) {
+            words.push_back(current);
+            current = factor;
+        } else {
+            current = product;
+        }
+    }
+
+    void multiplyPower(std::uint64_t p, long long e) {
+        for (long long k = 0; k < e; k++)
+            multiply(p);
+    }
+
+    // Balanced product tree over the words
+    BigInteger product() {
+        if (current != 1)
+            words.push_back(current);
+        current = 1;
+        if (words.empty())
+            return BigInteger(1);
+        return productOf(0, words.size());
+    }
+
+private:
+    BigInteger productOf(std::size_t begin, std::size_t end) const {
+        if (end - begin == 1)
+            return BigInteger::fromUnsigned(words[begin]);
+        std::size_t mid = begin + (end - begin) / 2;
+        return productOf(begin, mid) * productOf(mid, end);
+    }
+};
+
+bool isPrime(std::uint32_t n) {
+    if (n < 2)
+        return false;
+    if (n % 2 == 0)
+        return n == 2;
+    for (std::uint32_t d = 3; static_cast<std::uint64_t>(d) * d <= n; d += 2) {
+        if (n % d == 0)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// Exact values. Powers of two are applied as one shift at the end.
+BigInteger factorial(int n) {
+    detail::checkArguments(n, 0);
+    if (n <= MAX_FACTORIAL)
+        return BigInteger::fromUnsigned(FACTORIALS[n]);
+    Factors factors;
+    std::vector<int> primes = primesUpTo(n);
+    for (std::size_t i = 1; i < primes.size(); i++)
+        factors.multiplyPower(primes[i], legendre(n, primes[i]));
+    return factors.product() << static_cast<int>(legendre(n, 2));
+}
+
+BigInteger binomial(int n, int r) {
+    detail::checkArguments(n, r);
+    std::uint64_t small = 0;
+    if (detail::binomialFits(n, r, small))
+        return BigInteger::fromUnsigned(small);
+    // The exponent of p in C(n, r) is the number of carries when adding r and n - r
+    // in base p, which Legendre's formula gives as a difference of three sums
+    Factors factors;
+    std::vector<int> primes = primesUpTo(n);
+    for (std::size_t i = 1; i < primes.size(); i++)
+        factors.multiplyPower(primes[i], legendre(n, primes[i]) - legendre(r, primes[i]) - legendre(n - r, primes[i]));
+    return factors.product() << static_cast<int>(legendre(n, 2) - legendre(r, 2) - legendre(n - r, 2));
+}
+
+BigInteger permutations(int n, int r) {
+    detail::checkArguments(n, r);
+    std::uint64_t small = 0;
+    if (detail::permutationsFit(n, r, small))
+        return BigInteger::fromUnsigned(small);
+    // n! / (n - r)! directly when it has few factors, otherwise from the factorization
+    Factors factors;
+    if (r <= n / 2) {
+        for (long long k = n - r + 1; k <= n; k++)
+            factors.multiply(static_cast<std::uint64_t>(k));
+        return factors.product();
+    }
+    std::vector<int> primes = primesUpTo(n);
+    for (std::size_t i = 1; i < primes.size(); i++)
+        factors.multiplyPower(primes[i], legendre(n, primes[i]) - legendre(n - r, primes[i]));
+    return factors.product() << static_cast<int>(legendre(n, 2) - legendre(n - r, 2));
+}
+
+// Modular tables: factorials upward, then one Fermat inversion and inverse factorials
+// downward, 1/(k-1)! = k / k!
+ModularCombinatorics::ModularCombinatorics(std::uint32_t prime, std::uint32_t limit) : p(prime) {
+    if (!isPrime(prime)) {
+        throw std::invalid_argument("Error: Modulus must be prime.");
+    }
+    std::size_t size = static_cast<std::size_t>(std::min(limit, prime - 1)) + 1;
+    factorials.resize(size);
+    inverseFactorials.resize(size);
+    factorials[0] = 1;
+    for (std::size_t k = 1; k < size; k++)
+        factorials[k] = multiply(factorials[k - 1], k);
+
+    std::uint64_t inverse = 1, base = factorials[size - 1];
+    for (std::uint32_t e = p - 2; e > 0; e >>= 1) {
+        if (e & 1)
+            inverse = multiply(inverse, base);
+        base = multiply(base, base);
+    }
+    inverseFactorials[size - 1] = static_cast<std::uint32_t>(inverse);
+    for (std::size_t k = size - 1; k > 0; k--)
+        inverseFactorials[k - 1] = multiply(inverseFactorials[k], k);
+}
+
+std::shared_ptr<const ModularCombinatorics> ModularCombinatorics::get(std::uint32_t prime, std::uint32_t limit) {
+    static std::mutex mutex;
+    static std::unordered_map<std::uint32_t, std::shared_ptr<const ModularCombinatorics>> cache;
+    std::uint32_t covered = prime > 0 ? std::min(limit, prime - 1) : 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = cache.find(prime);
+        if (found != cache.end() && found->second->limit() >= covered)
+            return found->second;
+    }
+    // Built outside the lock; a larger table replaces a smaller one
+    auto table = std::make_shared<const ModularCombinatorics>(prime, limit);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const ModularCombinatorics>& entry = cache[prime];
+    if (!entry || entry->limit() < table->limit())
+        entry = table;
+    return entry;
+}
+
+void ModularCombinatorics::checkInTable(std::uint64_t n) const {
+    if (n >= factorials.size()) {
+        throw std::out_of_range("Error: Argument exceeds the table limit.");
+    }
+}
+
+std::uint32_t ModularCombinatorics::binomialInTable(std::uint64_t n, std::uint64_t r) const {
+    return multiply(multiply(factorials[n], inverseFactorials[r]), inverseFactorials[n - r]);
+}
+
+std::uint32_t ModularCombinatorics::factorial(std::uint64_t n) const {
+    if (n >= p)
+        return 0;
+    checkInTable(n);
+    return factorials[n];
+}
+
+std::uint32_t ModularCombinatorics::inverseFactorial(std::uint64_t n) const {
+    if (n >= p) {
+        throw std::invalid_argument("Error: Factorial is divisible by the modulus.");
+    }
+    checkInTable(n);
+    return inverseFactorials[n];
+}
+
+// Lucas: C(n, r) is the product of C(n_i, r_i) over the base-p digits of n and r
+std::uint32_t ModularCombinatorics::binomial(std::uint64_t n, std::uint64_t r) const {
+    if (r > n)
+        return 0;
+    if (n < factorials.size())
+        return binomialInTable(n, r);
+    checkInTable(p - 1);
+    std::uint32_t result = 1;
+    while (n > 0) {
+        std::uint64_t nDigit = n % p, rDigit = r % p;
+        if (rDigit > nDigit)
+            return 0;
+        result = multiply(result, binomialInTable(nDigit, rDigit));
+        n /= p;
+        r /= p;
+    }
+    return result;
+}
+
+// n (n - 1) ... (n - r + 1) vanishes when the run reaches a multiple of p, which it
+// does unless r <= n mod p; otherwise it equals the same run below n mod p
+std::uint32_t ModularCombinatorics::permutations(std::uint64_t n, std::uint64_t r) const {
+    if (r > n)
+        return 0;
+    if (n < factorials.size())
+        return multiply(factorials[n], inverseFactorials[n - r]);
+    std::uint64_t residue = n % p;
+    if (r > residue)
+        return 0;
+    checkInTable(residue);
+    return multiply(factorials[residue], inverseFactorials[residue - r]);
+}
+
+void ModularCombinatorics::binomial(std::span<const std::uint64_t> n, std::span<const std::uint64_t> r,
+                                    std::span<std::uint32_t> out) const {
+    if (n.size() != r.size() || n.size() != out.size()) {
+        throw std::invalid_argument("Error: Batch sizes do not match.");
+    }
+    auto run = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            out[i] = binomial(n[i], r[i]);
+    };
+    if (n.size() < PARALLEL_QUERIES || ThreadPool::instance().threadCount() <= 1) {
+        run(0, n.size());
+        return;
+    }
+    int tasks = static_cast<int>((n.size() + TASK_QUERIES - 1) / TASK_QUERIES);
+    ThreadPool::instance().parallelFor(tasks, [&](int t) {
+        std::size_t begin = static_cast<std::size_t>(t) * TASK_QUERIES;
+        run(begin, std::min(n.size(), begin + TASK_QUERIES));
+    });
+}
+
+} // namespace combinatorics
@@ -0,0 +1,179 @@
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "BigInteger.h"
+#include "NumberTheory.h"
+
+// Factorials, binomial coefficients C(n, r) and permutations P(n, r) = n! / (n - r)!.
+//
+// Three tiers: exact 64-bit values from compile-time tables and a multiplicative
+// formula that never forms a larger intermediate than the result; exact BigInteger
+// values from the prime factorization (Legendre's formula) for any size; and values
+// modulo a prime from precomputed factorial tables, for high query rates.
+//
+// Negative arguments throw std::invalid_argument. C(n, r) and P(n, r) are 0 for r > n.
+namespace combinatorics {
+
+// Largest n whose n! fits in 64 bits, and the number of rows of Pascal's triangle
+// whose entries all fit
+constexpr int MAX_FACTORIAL = 20;
+constexpr int BINOMIAL_TABLE_ROWS = 68;
+
+namespace detail {
+
+constexpr std::array<std::uint64_t, MAX_FACTORIAL + 1> makeFactorials() {
+    std::array<std::uint64_t, MAX_FACTORIAL + 1> table{};
+    table[0] = 1;
+    for (int n = 1; n <= MAX_FACTORIAL; n++)
+        table[n] = table[n - 1] * static_cast<std::uint64_t>(n);
+    return table;
+}
+
+// Row n of Pascal's triangle starts at n (n + 1) / 2
+constexpr std::array<std::uint64_t, BINOMIAL_TABLE_ROWS * (BINOMIAL_TABLE_ROWS + 1) / 2> makeBinomials() {
+    std::array<std::uint64_t, BINOMIAL_TABLE_ROWS * (BINOMIAL_TABLE_ROWS + 1) / 2> table{};
+    for (int n = 0; n < BINOMIAL_TABLE_ROWS; n++) {
+        std::size_t row = static_cast<std::size_t>(n) * (n + 1) / 2;
+        std::size_t above = static_cast<std::size_t>(n - 1) * n / 2;
+        table[row] = table[row + n] = 1;
+        for (int r = 1; r < n; r++)
+            table[row + r] = table[above + r - 1] + table[above + r];
+    }
+    return table;
+}
+
+constexpr void checkArguments(long long n, long long r) {
+    if (n < 0 || r < 0)
+        throw std::invalid_argument("Error: Arguments must be non-negative.");
+}
+
+} // namespace detail
+
+inline constexpr std::array<std::uint64_t, MAX_FACTORIAL + 1> FACTORIALS = detail::makeFactorials();
+inline constexpr auto BINOMIALS = detail::makeBinomials();
+
+namespace detail {
+
+// C(n, r) into result, or false if it does not fit in 64 bits. Beyond the table,
+// C(n - r + i, i) = C(n - r + i - 1, i - 1) (n - r + i) / i for i = 1..r with r <= n - r;
+// dividing out g = gcd(C, i) first leaves i / g dividing n - r + i, so every
+// intermediate is a smaller binomial coefficient and only the result can overflow.
+constexpr bool binomialFits(long long n, long long r, std::uint64_t& result) {
+    if (r > n) {
+        result = 0;
+        return true;
+    }
+    r = std::min(r, n - r);
+    if (n < BINOMIAL_TABLE_ROWS) {
+        result = BINOMIALS[static_cast<std::size_t>(n) * (n + 1) / 2 + r];
+        return true;
+    }
+    result = 1;
+    for (long long i = 1; i <= r; i++) {
+        std::uint64_t g = numbertheory::gcd64(result, static_cast<std::uint64_t>(i));
+        std::uint64_t factor = static_cast<std::uint64_t>(n - r + i) / (static_cast<std::uint64_t>(i) / g);
+        if (__builtin_mul_overflow(result / g, factor, &result))
+            return false;
+    }
+    return true;
+}
+
+// P(n, r) into result, or false if it does not fit in 64 bits
+constexpr bool permutationsFit(long long n, long long r, std::uint64_t& result) {
+    if (r > n) {
+        result = 0;
+        return true;
+    }
+    if (n <= MAX_FACTORIAL) {
+        result = FACTORIALS[n] / FACTORIALS[n - r];
+        return true;
+    }
+    result = 1;
+    for (long long k = n - r + 1; k <= n; k++) {
+        if (__builtin_mul_overflow(result, static_cast<std::uint64_t>(k), &result))
+            return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+// Exact 64-bit values; they throw std::overflow_error when the result does not fit
+
+constexpr std::uint64_t factorial64(long long n) {
+    detail::checkArguments(n, 0);
+    if (n > MAX_FACTORIAL)
+        throw std::overflow_error("Error: Factorial exceeds 64 bits.");
+    return FACTORIALS[n];
+}
+
+constexpr std::uint64_t binomial64(long long n, long long r) {
+    detail::checkArguments(n, r);
+    std::uint64_t result = 0;
+    if (!detail::binomialFits(n, r, result))
+        throw std::overflow_error("Error: Binomial coefficient exceeds 64 bits.");
+    return result;
+}
+
+constexpr std::uint64_t permutations64(long long n, long long r) {
+    detail::checkArguments(n, r);
+    std::uint64_t result = 0;
+    if (!detail::permutationsFit(n, r, result))
+        throw std::overflow_error("Error: Permutation count exceeds 64 bits.");
+    return result;
+}
+
+// Exact values of any size. Each is assembled as a product of prime powers whose
+// exponents come from Legendre's formula, multiplied in a balanced tree so that the
+// large multiplications happen last and on operands of equal size.
+BigInteger factorial(int n);
+BigInteger binomial(int n, int r);
+BigInteger permutations(int n, int r);
+
+// Values modulo a prime p < 2^32. The constructor tabulates k! and 1/k! mod p for
+// k <= min(limit, p - 1), after which factorial(), binomial() and permutations() cost
+// one or two multiplications. Arguments at or above p are reduced with Lucas's
+// theorem when the table covers every residue (limit >= p - 1); otherwise an argument
+// beyond the table throws std::out_of_range. get() shares tables between callers; a
+// table is immutable and may be used from several threads.
+class ModularCombinatorics {
+private:
+    std::uint32_t p;
+    std::vector<std::uint32_t> factorials;
+    std::vector<std::uint32_t> inverseFactorials;
+
+    std::uint32_t multiply(std::uint64_t a, std::uint64_t b) const { return static_cast<std::uint32_t>(a * b % p); }
+    std::uint32_t binomialInTable(std::uint64_t n, std::uint64_t r) const;
+    void checkInTable(std::uint64_t n) const;
+
+public:
+    // Throws std::invalid_argument unless prime is a prime
+    ModularCombinatorics(std::uint32_t prime, std::uint32_t limit);
+
+    // Shared table for prime covering at least limit, built on first use
+    static std::shared_ptr<const ModularCombinatorics> get(std::uint32_t prime, std::uint32_t limit);
+
+    std::uint32_t modulus() const { return p; }
+    std::uint32_t limit() const { return static_cast<std::uint32_t>(factorials.size() - 1); }
+
+    std::uint32_t factorial(std::uint64_t n) const;
+    std::uint32_t inverseFactorial(std::uint64_t n) const; // requires n < p
+    std::uint32_t binomial(std::uint64_t n, std::uint64_t r) const;
+    std::uint32_t permutations(std::uint64_t n, std::uint64_t r) const;
+
+    // out[i] = C(n[i], r[i]) mod p; all three spans have the same length. Large batches
+    // are split across the thread pool.
+    void binomial(std::span<const std::uint64_t> n, std::span<const std::uint64_t> r,
+                  std::span<std::uint32_t> out) const;
+};
+
+} // namespace combinatorics
+
+#endif // COMBINATORICS_H
@@ -30,6 +30,15 @@ Complex operator/(const Complex& c1, const Complex& c2) {
     return Complex(realPart, imagPart);
 }
 
+// Equality
+bool operator==(const Complex& c1, const Complex& c2) {
+    return c1.real == c2.real && c1.imag == c2.imag;
+}
+
+bool operator!=(const Complex& c1, const Complex& c2) {
+    return !(c1 == c2);
+}
+
 // Magnitude
 double magnitude(const Complex& c) {
     return std::sqrt(c.real * c.real + c.imag * c.imag);
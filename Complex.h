@@ -18,6 +18,8 @@ public:
     friend Complex operator-(const Complex& c1, const Complex& c2);
     friend Complex operator*(const Complex& c1, const Complex& c2);
     friend Complex operator/(const Complex& c1, const Complex& c2);
+    friend bool operator==(const Complex& c1, const Complex& c2);
+    friend bool operator!=(const Complex& c1, const Complex& c2);
 
     // Friend functions for complex properties
     friend double magnitude(const Complex& c);
@@ -0,0 +1,421 @@
+#include "ComplexArray.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// Elements per unrolled step; every kernel loop below runs over whole chunks so the
+// compiler vectorizes it with a constant trip count, then finishes the tail.
+constexpr int CHUNK = 8;
+
+// The elementwise loops are independent even when the output is one of the inputs
+#if defined(__clang__)
+#define COMPLEX_INDEPENDENT _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define COMPLEX_INDEPENDENT _Pragma("GCC ivdep")
+#else
+#define COMPLEX_INDEPENDENT
+#endif
+
+#if defined(__GNUC__)
+#define COMPLEX_INLINE inline __attribute__((always_inline))
+#else
+#define COMPLEX_INLINE inline
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COMPLEX_HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// Arguments of one kernel call; each operation uses the fields it needs. a and b are
+// the operands, r the result and s a scalar operand.
+struct Operands {
+    const double* ar;
+    const double* ai;
+    const double* br;
+    const double* bi;
+    double* rr;
+    double* ri;
+    double sr, si;
+};
+
+// Elementwise operations. apply() handles element k and returns flags that the
+// kernel ORs together (only used by the zero-divisor check).
+struct Add {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        double re = p.ar[k] + p.br[k], im = p.ai[k] + p.bi[k];
+        p.rr[k] = re;
+        p.ri[k] = im;
+        return 0;
+    }
+};
+
+struct Subtract {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        double re = p.ar[k] - p.br[k], im = p.ai[k] - p.bi[k];
+        p.rr[k] = re;
+        p.ri[k] = im;
+        return 0;
+    }
+};
+
+struct Multiply {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        double ar = p.ar[k], ai = p.ai[k], br = p.br[k], bi = p.bi[k];
+        p.rr[k] = ar * br - ai * bi;
+        p.ri[k] = ar * bi + ai * br;
+        return 0;
+    }
+};
+
+// Same formula as Complex division, so both give the same results
+struct Divide {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        double ar = p.ar[k], ai = p.ai[k], br = p.br[k], bi = p.bi[k];
+        double denominator = br * br + bi * bi;
+        p.rr[k] = (ar * br + ai * bi) / denominator;
+        p.ri[k] = (ai * br - ar * bi) / denominator;
+        return 0;
+    }
+};
+
+struct ZeroDivisor {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        return p.br[k] * p.br[k] + p.bi[k] * p.bi[k] == 0;
+    }
+};
+
+struct MultiplyAccumulate {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        double ar = p.ar[k], ai = p.ai[k], br = p.br[k], bi = p.bi[k];
+        p.rr[k] += ar * br - ai * bi;
+        p.ri[k] += ar * bi + ai * br;
+        return 0;
+    }
+};
+
+struct Scale {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        double ar = p.ar[k], ai = p.ai[k];
+        p.rr[k] = ar * p.sr - ai * p.si;
+        p.ri[k] = ar * p.si + ai * p.sr;
+        return 0;
+    }
+};
+
+struct Conjugate {
+    static COMPLEX_INLINE int apply(const Operands& p, int k) {
+        double re = p.ar[k], im = p.ai[k];
+        p.rr[k] = re;
+        p.ri[k] = -im;
+        return 0;
+    }
+};
+
+template <typename Op>
+COMPLEX_INLINE int runBody(Operands p, int n) {
+    int flags = 0;
+    int k = 0;
+    for (; k + CHUNK <= n; k += CHUNK) {
+        COMPLEX_INDEPENDENT
+        for (int l = 0; l < CHUNK; l++)
+            flags |= Op::apply(p, k + l);
+    }
+    for (; k < n; k++)
+        flags |= Op::apply(p, k);
+    return flags;
+}
+
+using Kernel = int (*)(Operands p, int n);
+
+template <typename Op>
+int runGeneric(Operands p, int n) {
+    return runBody<Op>(p, n);
+}
+
+#ifdef COMPLEX_HAVE_X86_DISPATCH
+template <typename Op>
+__attribute__((target("avx2,fma")))
+int runAvx2(Operands p, int n) {
+    return runBody<Op>(p, n);
+}
+#endif
+
+// Pick the AVX2 instantiation once if the CPU supports it
+template <typename Op>
+int run(const Operands& p, int n) {
+#ifdef COMPLEX_HAVE_X86_DISPATCH
+    static const Kernel kernel = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? runAvx2<Op> : runGeneric<Op>;
+    }();
+#else
+    static const Kernel kernel = runGeneric<Op>;
+#endif
+    return kernel(p, n);
+}
+
+// Magnitude and argument. std::sqrt and std::atan2 keep the compiler from vectorizing
+// (errno handling, a library call), so the AVX2 versions use intrinsics directly.
+using RealKernel = void (*)(const double* re, const double* im, double* out, int n);
+
+void magnitudeGeneric(const double* re, const double* im, double* out, int n) {
+    for (int k = 0; k < n; k++)
+        out[k] = std::sqrt(re[k] * re[k] + im[k] * im[k]);
+}
+
+void argumentGeneric(const double* re, const double* im, double* out, int n) {
+    for (int k = 0; k < n; k++)
+        out[k] = std::atan2(im[k], re[k]);
+}
+
+#ifdef COMPLEX_HAVE_X86_DISPATCH
+__attribute__((target("avx2,fma")))
+void magnitudeAvx2(const double* re, const double* im, double* out, int n) {
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d x = _mm256_loadu_pd(re + k);
+        __m256d y = _mm256_loadu_pd(im + k);
+        _mm256_storeu_pd(out + k, _mm256_sqrt_pd(_mm256_fmadd_pd(x, x, _mm256_mul_pd(y, y))));
+    }
+    magnitudeGeneric(re + k, im + k, out + k, n - k);
+}
+
+// atan2 reduced to atan(t) with t = min(|x|, |y|) / max(|x|, |y|) in [0, 1]. Above
+// 0.66, atan(t) = pi/4 + atan((t - 1) / (t + 1)); the Cephes rational approximation
+// (about 1 ulp) covers the rest. Octant and sign fix-ups follow std::atan2, including
+// signed zeros; blocks with an infinite or NaN input fall back to std::atan2.
+__attribute__((target("avx2,fma")))
+void argumentAvx2(const double* re, const double* im, double* out, int n) {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d largest = _mm256_set1_pd(1.7976931348623157e308);
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d x = _mm256_loadu_pd(re + k);
+        __m256d y = _mm256_loadu_pd(im + k);
+        __m256d ax = _mm256_andnot_pd(signMask, x);
+        __m256d ay = _mm256_andnot_pd(signMask, y);
+        __m256d hi = _mm256_max_pd(ax, ay);
+        __m256d lo = _mm256_min_pd(ax, ay);
+        if (_mm256_movemask_pd(_mm256_cmp_pd(hi, largest, _CMP_NLE_UQ))) {
+            argumentGeneric(re + k, im + k, out + k, 4);
+            continue;
+        }
+
+        __m256d divisor = _mm256_blendv_pd(hi, one, _mm256_cmp_pd(hi, zero, _CMP_EQ_OQ));
+        __m256d t = _mm256_div_pd(lo, divisor);
+        __m256d upper = _mm256_cmp_pd(t, _mm256_set1_pd(0.66), _CMP_GT_OQ);
+        __m256d u = _mm256_blendv_pd(t, _mm256_div_pd(_mm256_sub_pd(t, one), _mm256_add_pd(t, one)), upper);
+
+        __m256d z = _mm256_mul_pd(u, u);
+        __m256d num = _mm256_set1_pd(-8.750608600031904122785e-1);
+        num = _mm256_fmadd_pd(num, z, _mm256_set1_pd(-1.615753718733365076637e1));
+        num = _mm256_fmadd_pd(num, z, _mm256_set1_pd(-7.500855792314704667340e1));
+        num = _mm256_fmadd_pd(num, z, _mm256_set1_pd(-1.228866684490136173410e2));
+        num = _mm256_fmadd_pd(num, z, _mm256_set1_pd(-6.485021904942025371773e1));
+        __m256d den = _mm256_add_pd(z, _mm256_set1_pd(2.485846490142306297962e1));
+        den = _mm256_fmadd_pd(den, z, _mm256_set1_pd(1.650270098316988542046e2));
+        den = _mm256_fmadd_pd(den, z, _mm256_set1_pd(4.328810604912902668951e2));
+        den = _mm256_fmadd_pd(den, z, _mm256_set1_pd(4.853903996359136964868e2));
+        den = _mm256_fmadd_pd(den, z, _mm256_set1_pd(1.945506571482613964425e2));
+        __m256d a = _mm256_fmadd_pd(u, _mm256_div_pd(_mm256_mul_pd(z, num), den), u);
+
+        // Undo the reductions: t > 0.66, |y| > |x|, x < 0, y < 0
+        __m256d shifted = _mm256_add_pd(_mm256_set1_pd(0.78539816339744830962),
+                                        _mm256_add_pd(a, _mm256_set1_pd(3.061616997868382943065e-17)));
+        a = _mm256_blendv_pd(a, shifted, upper);
+        a = _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(1.57079632679489661923), a),
+                             _mm256_cmp_pd(ay, ax, _CMP_GT_OQ));
+        a = _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(3.14159265358979323846), a), x);
+        a = _mm256_xor_pd(a, _mm256_and_pd(y, signMask));
+        _mm256_storeu_pd(out + k, a);
+    }
+    argumentGeneric(re + k, im + k, out + k, n - k);
+}
+#endif
+
+RealKernel selectMagnitude() {
+#ifdef COMPLEX_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return magnitudeAvx2;
+#endif
+    return magnitudeGeneric;
+}
+
+RealKernel selectArgument() {
+#ifdef COMPLEX_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return argumentAvx2;
+#endif
+    return argumentGeneric;
+}
+
+Operands operands(const double* ar, const double* ai, const double* br, const double* bi, double* rr, double* ri) {
+    return Operands{ar, ai, br, bi, rr, ri, 0.0, 0.0};
+}
+
+} // namespace
+
+// Constructors
+ComplexArray::ComplexArray(int n) : n(n) {
+    if (n < 0)
+        throw std::invalid_argument("Array size must be non-negative");
+    re.assign(n, 0.0);
+    im.assign(n, 0.0);
+}
+
+ComplexArray::ComplexArray(const std::vector<Complex>& values) : ComplexArray(static_cast<int>(values.size())) {
+    for (int i = 0; i < n; i++) {
+        re[i] = values[i].realPart();
+        im[i] = values[i].imaginaryPart();
+    }
+}
+
+std::vector<Complex> ComplexArray::toComplex() const {
+    std::vector<Complex> values;
+    values.reserve(n);
+    for (int i = 0; i < n; i++)
+        values.emplace_back(re[i], im[i]);
+    return values;
+}
+
+// Resize, keeping the leading values; new elements are zero
+void ComplexArray::resize(int size) {
+    if (size < 0)
+        throw std::invalid_argument("Array size must be non-negative");
+    n = size;
+    re.resize(n, 0.0);
+    im.resize(n, 0.0);
+}
+
+// Element setters and getters
+void ComplexArray::setElement(int i, const Complex& value) {
+    if (i < 0 || i >= n)
+        throw std::out_of_range("Index out of range");
+    re[i] = value.realPart();
+    im[i] = value.imaginaryPart();
+}
+
+Complex ComplexArray::getElement(int i) const {
+    if (i < 0 || i >= n)
+        throw std::out_of_range("Index out of range");
+    return Complex(re[i], im[i]);
+}
+
+// In-place arithmetic
+ComplexArray& ComplexArray::operator+=(const ComplexArray& other) {
+    add(*this, other, *this);
+    return *this;
+}
+
+ComplexArray& ComplexArray::operator-=(const ComplexArray& other) {
+    subtract(*this, other, *this);
+    return *this;
+}
+
+ComplexArray& ComplexArray::operator*=(const ComplexArray& other) {
+    multiply(*this, other, *this);
+    return *this;
+}
+
+ComplexArray& ComplexArray::operator/=(const ComplexArray& other) {
+    divide(*this, other, *this);
+    return *this;
+}
+
+ComplexArray& ComplexArray::operator*=(const Complex& scalar) {
+    Operands p = operands(re.data(), im.data(), nullptr, nullptr, re.data(), im.data());
+    p.sr = scalar.realPart();
+    p.si = scalar.imaginaryPart();
+    run<Scale>(p, n);
+    return *this;
+}
+
+// Arithmetic into a result array
+void ComplexArray::add(const ComplexArray& a, const ComplexArray& b, ComplexArray& result) {
+    a.checkSameSize(b, "Arrays must have the same size for addition");
+    result.resize(a.n);
+    run<Add>(operands(a.re.data(), a.im.data(), b.re.data(), b.im.data(), result.re.data(), result.im.data()), a.n);
+}
+
+void ComplexArray::subtract(const ComplexArray& a, const ComplexArray& b, ComplexArray& result) {
+    a.checkSameSize(b, "Arrays must have the same size for subtraction");
+    result.resize(a.n);
+    run<Subtract>(operands(a.re.data(), a.im.data(), b.re.data(), b.im.data(), result.re.data(), result.im.data()), a.n);
+}
+
+void ComplexArray::multiply(const ComplexArray& a, const ComplexArray& b, ComplexArray& result) {
+    a.checkSameSize(b, "Arrays must have the same size for multiplication");
+    result.resize(a.n);
+    run<Multiply>(operands(a.re.data(), a.im.data(), b.re.data(), b.im.data(), result.re.data(), result.im.data()), a.n);
+}
+
+// The divisors are checked first, so a zero divisor leaves the result untouched
+void ComplexArray::divide(const ComplexArray& a, const ComplexArray& b, ComplexArray& result) {
+    a.checkSameSize(b, "Arrays must have the same size for division");
+    if (run<ZeroDivisor>(operands(nullptr, nullptr, b.re.data(), b.im.data(), nullptr, nullptr), b.n))
+        throw std::invalid_argument("Division by zero");
+    result.resize(a.n);
+    run<Divide>(operands(a.re.data(), a.im.data(), b.re.data(), b.im.data(), result.re.data(), result.im.data()), a.n);
+}
+
+ComplexArray& ComplexArray::multiplyAccumulate(const ComplexArray& a, const ComplexArray& b) {
+    a.checkSameSize(b, "Arrays must have the same size for multiplication");
+    checkSameSize(a, "Arrays must have the same size for addition");
+    run<MultiplyAccumulate>(operands(a.re.data(), a.im.data(), b.re.data(), b.im.data(), re.data(), im.data()), n);
+    return *this;
+}
+
+// Conjugate
+ComplexArray& ComplexArray::conjugateInPlace() {
+    conjugate(*this);
+    return *this;
+}
+
+ComplexArray ComplexArray::conjugate() const {
+    ComplexArray result(n);
+    conjugate(result);
+    return result;
+}
+
+void ComplexArray::conjugate(ComplexArray& result) const {
+    result.resize(n);
+    run<Conjugate>(operands(re.data(), im.data(), nullptr, nullptr, result.re.data(), result.im.data()), n);
+}
+
+// Magnitude and argument
+std::vector<double> ComplexArray::magnitude() const {
+    std::vector<double> result;
+    magnitude(result);
+    return result;
+}
+
+void ComplexArray::magnitude(std::vector<double>& result) const {
+    result.resize(n);
+    static const RealKernel kernel = selectMagnitude();
+    kernel(re.data(), im.data(), result.data(), n);
+}
+
+std::vector<double> ComplexArray::argument() const {
+    std::vector<double> result;
+    argument(result);
+    return result;
+}
+
+void ComplexArray::argument(std::vector<double>& result) const {
+    result.resize(n);
+    static const RealKernel kernel = selectArgument();
+    kernel(re.data(), im.data(), result.data(), n);
+}
+
+// Display in rectangular form, one element per line
+void ComplexArray::display() const {
+    for (int i = 0; i < n; i++)
+        getElement(i).displayRectangular();
+}
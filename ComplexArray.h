@@ -0,0 +1,100 @@
+#ifndef COMPLEX_ARRAY_H
+#define COMPLEX_ARRAY_H
+
+#include <vector>
+#include <stdexcept>
+#include "AlignedAllocator.h"
+#include "Complex.h"
+
+// An array of complex numbers in split (structure-of-arrays) layout: all real parts
+// in one contiguous buffer and all imaginary parts in another, so the elementwise
+// kernels process a full SIMD register of numbers per instruction instead of
+// shuffling interleaved pairs. Elements convert to and from Complex at the edges.
+//
+// Every operation works in place or writes into a caller-provided array, which is
+// resized only when its size differs, so a per-frame loop does not allocate. The
+// output may be one of the operands.
+class ComplexArray {
+private:
+    int n;
+    AlignedVector<double> re;
+    AlignedVector<double> im;
+
+    void checkSameSize(const ComplexArray& other, const char* message) const {
+        if (n != other.n)
+            throw std::invalid_argument(message);
+    }
+
+public:
+    // Constructors: n zeros, or copies of the given values
+    explicit ComplexArray(int n = 0);
+    explicit ComplexArray(const std::vector<Complex>& values);
+
+    std::vector<Complex> toComplex() const;
+
+    int size() const { return n; }
+    void resize(int n);
+
+    // Split storage, n values each
+    double* realData() { return re.data(); }
+    double* imagData() { return im.data(); }
+    const double* realData() const { return re.data(); }
+    const double* imagData() const { return im.data(); }
+
+    // Element setters and getters (bounds-checked)
+    void setElement(int i, const Complex& value);
+    Complex getElement(int i) const;
+
+    // Elementwise arithmetic in place. Division throws std::invalid_argument, leaving
+    // the array unchanged, if any divisor is zero.
+    ComplexArray& operator+=(const ComplexArray& other);
+    ComplexArray& operator-=(const ComplexArray& other);
+    ComplexArray& operator*=(const ComplexArray& other);
+    ComplexArray& operator/=(const ComplexArray& other);
+    ComplexArray& operator*=(const Complex& scalar);
+
+    // Elementwise arithmetic into result. If divide() throws, result is unspecified.
+    static void add(const ComplexArray& a, const ComplexArray& b, ComplexArray& result);
+    static void subtract(const ComplexArray& a, const ComplexArray& b, ComplexArray& result);
+    static void multiply(const ComplexArray& a, const ComplexArray& b, ComplexArray& result);
+    static void divide(const ComplexArray& a, const ComplexArray& b, ComplexArray& result);
+
+    // this += a * b, elementwise
+    ComplexArray& multiplyAccumulate(const ComplexArray& a, const ComplexArray& b);
+
+    // Complex conjugate
+    ComplexArray& conjugateInPlace();
+    ComplexArray conjugate() const;
+    void conjugate(ComplexArray& result) const;
+
+    // Magnitudes and arguments (radians, in (-pi, pi] like std::atan2)
+    std::vector<double> magnitude() const;
+    void magnitude(std::vector<double>& result) const;
+    std::vector<double> argument() const;
+    void argument(std::vector<double>& result) const;
+
+    void display() const;
+};
+
+// Binary operators take the left operand by value and reuse it as the result
+inline ComplexArray operator+(ComplexArray a, const ComplexArray& b) {
+    a += b;
+    return a;
+}
+
+inline ComplexArray operator-(ComplexArray a, const ComplexArray& b) {
+    a -= b;
+    return a;
+}
+
+inline ComplexArray operator*(ComplexArray a, const ComplexArray& b) {
+    a *= b;
+    return a;
+}
+
+inline ComplexArray operator/(ComplexArray a, const ComplexArray& b) {
+    a /= b;
+    return a;
+}
+
+#endif // COMPLEX_ARRAY_H
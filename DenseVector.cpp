@@ -0,0 +1,72 @@
+#include "DenseVector.h"
+#include <iostream>
+
+// Copy assignment
+DenseVector& DenseVector::operator=(const DenseVector& other) {
+    if (this != &other) {
+        // Reuse the heap buffer when the size already matches
+        if (n != other.n) {
+            heap.reset();
+            n = other.n;
+            if (n > INLINE_CAPACITY)
+                heap = std::make_unique<double[]>(n);
+        }
+        std::copy(other.data(), other.data() + n, data());
+    }
+    return *this;
+}
+
+DenseVector& DenseVector::operator=(DenseVector&& other) noexcept {
+    if (this != &other) {
+        n = other.n;
+        heap = std::move(other.heap);
+        std::copy(other.local, other.local + INLINE_CAPACITY, local);
+        other.n = 0;
+    }
+    return *this;
+}
+
+// Element setters and getters
+void DenseVector::setElement(int i, double value) {
+    if (i < 0 || i >= n)
+        throw std::out_of_range("Index out of range");
+    data()[i] = value;
+}
+
+double DenseVector::getElement(int i) const {
+    if (i < 0 || i >= n)
+        throw std::out_of_range("Index out of range");
+    return data()[i];
+}
+
+// Angle between two vectors in radians
+double DenseVector::angle(const DenseVector& other, vectorkernels::Summation mode) const {
+    checkSameSize(other, "Vectors must have the same dimension to calculate angle");
+    if (n > INLINE_CAPACITY || mode != vectorkernels::Summation::Fast)
+        return vectorkernels::angle(data(), other.data(), n, mode);
+    double mag1 = magnitude();
+    double mag2 = other.magnitude();
+    if (mag1 == 0 || mag2 == 0)
+        throw std::invalid_argument("Cannot calculate the angle with a zero vector");
+    // Clamp so rounding cannot push the cosine of (anti)parallel vectors outside [-1, 1]
+    return std::acos(std::clamp(dot(other) / (mag1 * mag2), -1.0, 1.0));
+}
+
+// Project this vector onto another vector
+DenseVector DenseVector::projectOnto(const DenseVector& other) const {
+    double magOther = other.magnitude();
+    if (magOther == 0)
+        throw std::invalid_argument("Cannot project onto a zero vector");
+    return other * (dot(other) / (magOther * magOther));
+}
+
+// Display the vector
+void DenseVector::display() const {
+    std::cout << "(";
+    for (int i = 0; i < n; i++) {
+        std::cout << data()[i];
+        if (i < n - 1)
+            std::cout << ", ";
+    }
+    std::cout << ")" << std::endl;
+}
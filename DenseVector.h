@@ -0,0 +1,203 @@
+#ifndef DENSE_VECTOR_H
+#define DENSE_VECTOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "VectorKernels.h"
+
+// Value-semantic real vector for arithmetic in tight loops. Vectors of up to
+// INLINE_CAPACITY components live inside the object, so the common 2-, 3- and 4-D
+// cases never touch the heap; longer ones own a heap buffer that moves cheaply. No
+// virtual dispatch: the arithmetic is inline and returns by value, with in-place
+// variants (+=, -=, *=, addScaled, normalizeInPlace) that allocate nothing at all.
+// Long vectors hand the reductions, scaling and axpy to the SIMD kernels in
+// VectorKernels.h; reductions take an optional summation mode for extra accuracy.
+class DenseVector {
+public:
+    static constexpr int INLINE_CAPACITY = 4;
+
+private:
+    int n;
+    double local[INLINE_CAPACITY];
+    std::unique_ptr<double[]> heap;
+
+    void checkSameSize(const DenseVector& other, const char* message) const {
+        if (n != other.n)
+            throw std::invalid_argument(message);
+    }
+
+    // Elementwise a[i] = op(a[i], b[i]). Inline vectors run over the full fixed-size
+    // buffer, which unrolls into a couple of SIMD operations; the unused tail slots are
+    // never read by anything that depends on them.
+    template <typename Op>
+    void combine(const DenseVector& other, Op op) {
+        if (n <= INLINE_CAPACITY) {
+            for (int i = 0; i < INLINE_CAPACITY; i++)
+                local[i] = op(local[i], other.local[i]);
+            return;
+        }
+        double* a = heap.get();
+        const double* b = other.heap.get();
+        for (int i = 0; i < n; i++)
+            a[i] = op(a[i], b[i]);
+    }
+
+public:
+    // Constructors: n zero components, or the given components. Kept inline with the
+    // copy and move operations so small temporaries stay in registers.
+    explicit DenseVector(int n = 0) : n(n), local{} {
+        if (n < 0)
+            throw std::invalid_argument("Vector dimension must be non-negative");
+        if (n > INLINE_CAPACITY)
+            heap = std::make_unique<double[]>(n);
+    }
+
+    DenseVector(std::initializer_list<double> values) : DenseVector(static_cast<int>(values.size())) {
+        std::copy(values.begin(), values.end(), data());
+    }
+
+    explicit DenseVector(const std::vector<double>& values) : DenseVector(static_cast<int>(values.size())) {
+        std::copy(values.begin(), values.end(), data());
+    }
+
+    DenseVector(const DenseVector& other) : n(other.n) {
+        std::copy(other.local, other.local + INLINE_CAPACITY, local);
+        if (n > INLINE_CAPACITY) {
+            heap = std::make_unique<double[]>(n);
+            std::copy(other.heap.get(), other.heap.get() + n, heap.get());
+        }
+    }
+
+    DenseVector(DenseVector&& other) noexcept : n(other.n), heap(std::move(other.heap)) {
+        std::copy(other.local, other.local + INLINE_CAPACITY, local);
+        other.n = 0;
+    }
+
+    DenseVector& operator=(const DenseVector& other);
+    DenseVector& operator=(DenseVector&& other) noexcept;
+
+    int size() const { return n; }
+    double* data() { return n <= INLINE_CAPACITY ? local : heap.get(); }
+    const double* data() const { return n <= INLINE_CAPACITY ? local : heap.get(); }
+    double& operator[](int i) { return data()[i]; }
+    double operator[](int i) const { return data()[i]; }
+
+    // Element setters and getters (bounds-checked)
+    void setElement(int i, double value);
+    double getElement(int i) const;
+
+    std::vector<double> toStdVector() const { return std::vector<double>(data(), data() + n); }
+
+    // In-place arithmetic
+    DenseVector& operator+=(const DenseVector& other) {
+        checkSameSize(other, "Vectors must have the same dimension for addition");
+        combine(other, [](double a, double b) { return a + b; });
+        return *this;
+    }
+
+    DenseVector& operator-=(const DenseVector& other) {
+        checkSameSize(other, "Vectors must have the same dimension for subtraction");
+        combine(other, [](double a, double b) { return a - b; });
+        return *this;
+    }
+
+    DenseVector& operator*=(double scalar) {
+        if (n > INLINE_CAPACITY) {
+            vectorkernels::scale(heap.get(), n, scalar);
+            return *this;
+        }
+        combine(*this, [scalar](double a, double) { return a * scalar; });
+        return *this;
+    }
+
+    // this += alpha * x
+    DenseVector& addScaled(double alpha, const DenseVector& x) {
+        checkSameSize(x, "Vectors must have the same dimension for addition");
+        if (n > INLINE_CAPACITY) {
+            vectorkernels::axpy(alpha, x.heap.get(), heap.get(), n);
+            return *this;
+        }
+        combine(x, [alpha](double a, double b) { return a + alpha * b; });
+        return *this;
+    }
+
+    double dot(const DenseVector& other,
+               vectorkernels::Summation mode = vectorkernels::Summation::Fast) const {
+        checkSameSize(other, "Vectors must have the same dimension for dot product");
+        // The inline loop is the fast mode; the accurate modes go to the kernels at any size
+        if (n > INLINE_CAPACITY || mode != vectorkernels::Summation::Fast)
+            return vectorkernels::dot(data(), other.data(), n, mode);
+        const double* a = data();
+        const double* b = other.data();
+        double result = 0;
+        for (int i = 0; i < n; i++)
+            result += a[i] * b[i];
+        return result;
+    }
+
+    double magnitude(vectorkernels::Summation mode = vectorkernels::Summation::Fast) const {
+        return std::sqrt(dot(*this, mode));
+    }
+
+    DenseVector& normalizeInPlace(vectorkernels::Summation mode = vectorkernels::Summation::Fast) {
+        double mag = magnitude(mode);
+        if (mag == 0)
+            throw std::invalid_argument("Cannot normalize a zero vector");
+        return *this *= 1.0 / mag;
+    }
+
+    DenseVector normalize(vectorkernels::Summation mode = vectorkernels::Summation::Fast) const {
+        DenseVector result(*this);
+        result.normalizeInPlace(mode);
+        return result;
+    }
+
+    // Cross product of two 3D vectors
+    DenseVector cross(const DenseVector& other) const {
+        if (n != 3 || other.n != 3)
+            throw std::invalid_argument("Cross product is only defined for 3D vectors");
+        const double* a = local;
+        const double* b = other.local;
+        return DenseVector{a[1] * b[2] - a[2] * b[1],
+                           a[2] * b[0] - a[0] * b[2],
+                           a[0] * b[1] - a[1] * b[0]};
+    }
+
+    // Angle between two vectors in radians
+    double angle(const DenseVector& other,
+                 vectorkernels::Summation mode = vectorkernels::Summation::Fast) const;
+
+    // Projection of this vector onto another
+    DenseVector projectOnto(const DenseVector& other) const;
+
+    void display() const;
+};
+
+// Binary operators take the left operand by value, so a temporary on the left is
+// reused as the result instead of allocating a new one.
+inline DenseVector operator+(DenseVector a, const DenseVector& b) {
+    a += b;
+    return a;
+}
+
+inline DenseVector operator-(DenseVector a, const DenseVector& b) {
+    a -= b;
+    return a;
+}
+
+inline DenseVector operator*(DenseVector a, double scalar) {
+    a *= scalar;
+    return a;
+}
+
+inline DenseVector operator*(double scalar, DenseVector a) {
+    a *= scalar;
+    return a;
+}
+
+#endif // DENSE_VECTOR_H
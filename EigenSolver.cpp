@@ -0,0 +1,694 @@
+#include "EigenSolver.h"
+#include "Gemm.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+constexpr double EPS = std::numeric_limits<double>::epsilon();
+
+// Iterations allowed per eigenvalue before giving up
+constexpr int MAX_ITERATIONS = 100;
+
+// Dense n x n working matrix with unchecked row-major access
+struct Square {
+    int n;
+    std::vector<double> a;
+
+    explicit Square(int size) : n(size), a(static_cast<std::size_t>(size) * size, 0.0) {}
+
+    double& operator()(int i, int j) { return a[static_cast<std::size_t>(i) * n + j]; }
+    double* row(int i) { return &a[static_cast<std::size_t>(i) * n]; }
+};
+
+// Complex scalar division (xr + i xi) / (yr + i yi), avoiding overflow
+std::complex<double> cdiv(double xr, double xi, double yr, double yi) {
+    if (std::abs(yr) > std::abs(yi)) {
+        double r = yi / yr;
+        double d = yr + r * yi;
+        return {(xr + r * xi) / d, (xi - r * xr) / d};
+    }
+    double r = yr / yi;
+    double d = yi + r * yr;
+    return {(r * xr + xi) / d, (r * xi - xr) / d};
+}
+
+// Householder reduction of the symmetric matrix in v to tridiagonal form. On return d
+// holds the diagonal, e the subdiagonal (e[0] = 0) and, if accumulate, v the
+// orthogonal transformation.
+void tridiagonalize(Square& v, std::vector<double>& d, std::vector<double>& e, bool accumulate) {
+    int n = v.n;
+    for (int j = 0; j < n; j++)
+        d[j] = v(n - 1, j);
+
+    for (int i = n - 1; i > 0; i--) {
+        double scale = 0.0;
+        double h = 0.0;
+        for (int k = 0; k < i; k++)
+            scale += std::abs(d[k]);
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (int j = 0; j < i; j++) {
+                d[j] = v(i - 1, j);
+                v(i, j) = 0.0;
+                v(j, i) = 0.0;
+            }
+        } else {
+            for (int k = 0; k < i; k++) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0)
+                g = -g;
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (int j = 0; j < i; j++)
+                e[j] = 0.0;
+
+            for (int j = 0; j < i; j++) {
+                f = d[j];
+                v(j, i) = f;
+                g = e[j] + v(j, j) * f;
+                for (int k = j + 1; k <= i - 1; k++) {
+                    g += v(k, j) * d[k];
+                    e[k] += v(k, j) * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (int j = 0; j < i; j++) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            double hh = f / (h + h);
+            for (int j = 0; j < i; j++)
+                e[j] -= hh * d[j];
+            for (int j = 0; j < i; j++) {
+                f = d[j];
+                g = e[j];
+                for (int k = j; k <= i - 1; k++)
+                    v(k, j) -= (f * e[k] + g * d[k]);
+                d[j] = v(i - 1, j);
+                v(i, j) = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+
+    if (!accumulate) {
+        for (int i = 0; i < n; i++)
+            d[i] = v(i, i);
+        e[0] = 0.0;
+        return;
+    }
+
+    for (int i = 0; i < n - 1; i++) {
+        v(n - 1, i) = v(i, i);
+        v(i, i) = 1.0;
+        double h = d[i + 1];
+        if (h != 0.0) {
+            for (int k = 0; k <= i; k++)
+                d[k] = v(k, i + 1) / h;
+            for (int j = 0; j <= i; j++) {
+                double g = 0.0;
+                for (int k = 0; k <= i; k++)
+                    g += v(k, i + 1) * v(k, j);
+                for (int k = 0; k <= i; k++)
+                    v(k, j) -= g * d[k];
+            }
+        }
+        for (int k = 0; k <= i; k++)
+            v(k, i + 1) = 0.0;
+    }
+    for (int j = 0; j < n; j++) {
+        d[j] = v(n - 1, j);
+        v(n - 1, j) = 0.0;
+    }
+    v(n - 1, n - 1) = 1.0;
+    e[0] = 0.0;
+}
+
+// Implicit QL iterations on the tridiagonal matrix (d, e); rotations are applied to v
+// when accumulate is set.
+void diagonalizeTridiagonal(Square& v, std::vector<double>& d, std::vector<double>& e, bool accumulate) {
+    int n = v.n;
+    for (int i = 1; i < n; i++)
+        e[i - 1] = e[i];
+    e[n - 1] = 0.0;
+
+    double f = 0.0;
+    double tst1 = 0.0;
+    for (int l = 0; l < n; l++) {
+        tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+        int m = l;
+        while (m < n - 1 && std::abs(e[m]) > EPS * tst1)
+            m++;
+
+        if (m > l) {
+            int iter = 0;
+            do {
+                if (++iter > MAX_ITERATIONS)
+                    throw std::runtime_error("Eigenvalue iteration did not converge");
+
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0)
+                    r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (int i = l + 2; i < n; i++)
+                    d[i] -= h;
+                f += h;
+
+                p = d[m];
+                double c = 1.0, c2 = c, c3 = c;
+                double el1 = e[l + 1];
+                double s = 0.0, s2 = 0.0;
+                for (int i = m - 1; i >= l; i--) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+
+                    if (accumulate) {
+                        for (int k = 0; k < n; k++) {
+                            double* row = v.row(k);
+                            h = row[i + 1];
+                            row[i + 1] = s * row[i] + c * h;
+                            row[i] = c * row[i] - s * h;
+                        }
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::abs(e[l]) > EPS * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+}
+
+// Householder reduction of h to upper Hessenberg form; the transformation is
+// accumulated into v when accumulate is set.
+void hessenberg(Square& h, Square& v, bool accumulate) {
+    int n = h.n;
+    int high = n - 1;
+    std::vector<double> ort(n, 0.0);
+    std::vector<double> f(n, 0.0);
+
+    for (int m = 1; m <= high - 1; m++) {
+        double scale = 0.0;
+        for (int i = m; i <= high; i++)
+            scale += std::abs(h(i, m - 1));
+        if (scale == 0.0)
+            continue;
+
+        double hh = 0.0;
+        for (int i = high; i >= m; i--) {
+            ort[i] = h(i, m - 1) / scale;
+            hh += ort[i] * ort[i];
+        }
+        double g = std::sqrt(hh);
+        if (ort[m] > 0)
+            g = -g;
+        hh -= ort[m] * g;
+        ort[m] -= g;
+
+        // H = (I - u u'/h) H, computed row by row
+        std::fill(f.begin() + m, f.end(), 0.0);
+        for (int i = m; i <= high; i++) {
+            const double* row = h.row(i);
+            for (int j = m; j < n; j++)
+                f[j] += ort[i] * row[j];
+        }
+        for (int i = m; i <= high; i++) {
+            double* row = h.row(i);
+            double oi = ort[i] / hh;
+            for (int j = m; j < n; j++)
+                row[j] -= f[j] * oi;
+        }
+
+        // H = H (I - u u'/h)
+        for (int i = 0; i <= high; i++) {
+            double* row = h.row(i);
+            double s = 0.0;
+            for (int j = m; j <= high; j++)
+                s += ort[j] * row[j];
+            s /= hh;
+            for (int j = m; j <= high; j++)
+                row[j] -= s * ort[j];
+        }
+        ort[m] *= scale;
+        h(m, m - 1) = scale * g;
+    }
+
+    if (!accumulate)
+        return;
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            v(i, j) = (i == j ? 1.0 : 0.0);
+
+    for (int m = high - 1; m >= 1; m--) {
+        if (h(m, m - 1) == 0.0)
+            continue;
+        for (int i = m + 1; i <= high; i++)
+            ort[i] = h(i, m - 1);
+        std::fill(f.begin() + m, f.end(), 0.0);
+        for (int i = m; i <= high; i++) {
+            const double* row = v.row(i);
+            for (int j = m; j <= high; j++)
+                f[j] += ort[i] * row[j];
+        }
+        double denom = ort[m] * h(m, m - 1);
+        for (int i = m; i <= high; i++) {
+            double* row = v.row(i);
+            for (int j = m; j <= high; j++)
+                row[j] += (f[j] / denom) * ort[i];
+        }
+    }
+}
+
+// Francis double-shift QR iterations taking the Hessenberg matrix h to real Schur form.
+// Eigenvalues go to (d, e) as real and imaginary parts. With accumulate set, the Schur
+// vectors in v are turned into eigenvectors by back substitution; otherwise only the
+// active window is updated, as in the eigenvalue-only EISPACK hqr.
+void schur(Square& h, Square& v, std::vector<double>& d, std::vector<double>& e, bool accumulate) {
+    int nn = h.n;
+    int n = nn - 1;
+    const int low = 0;
+    const int high = nn - 1;
+    double exshift = 0.0;
+    double p = 0, q = 0, r = 0, s = 0, z = 0, t, w, x, y;
+
+    double norm = 0.0;
+    for (int i = 0; i < nn; i++)
+        for (int j = std::max(i - 1, 0); j < nn; j++)
+            norm += std::abs(h(i, j));
+
+    int iter = 0;
+    while (n >= low) {
+        int l = n;
+        while (l > low) {
+            s = std::abs(h(l - 1, l - 1)) + std::abs(h(l, l));
+            if (s == 0.0)
+                s = norm;
+            if (std::abs(h(l, l - 1)) < EPS * s)
+                break;
+            l--;
+        }
+
+        if (l == n) {
+            // One root found
+            h(n, n) += exshift;
+            d[n] = h(n, n);
+            e[n] = 0.0;
+            n--;
+            iter = 0;
+        } else if (l == n - 1) {
+            // Two roots found
+            w = h(n, n - 1) * h(n - 1, n);
+            p = (h(n - 1, n - 1) - h(n, n)) / 2.0;
+            q = p * p + w;
+            z = std::sqrt(std::abs(q));
+            h(n, n) += exshift;
+            h(n - 1, n - 1) += exshift;
+            x = h(n, n);
+
+            if (q >= 0) {
+                z = p >= 0 ? p + z : p - z;
+                d[n - 1] = x + z;
+                d[n] = d[n - 1];
+                if (z != 0.0)
+                    d[n] = x - w / z;
+                e[n - 1] = 0.0;
+                e[n] = 0.0;
+
+                if (accumulate) {
+                    x = h(n, n - 1);
+                    s = std::abs(x) + std::abs(z);
+                    p = x / s;
+                    q = z / s;
+                    r = std::sqrt(p * p + q * q);
+                    p /= r;
+                    q /= r;
+                    for (int j = n - 1; j < nn; j++) {
+                        z = h(n - 1, j);
+                        h(n - 1, j) = q * z + p * h(n, j);
+                        h(n, j) = q * h(n, j) - p * z;
+                    }
+                    for (int i = 0; i <= n; i++) {
+                        z = h(i, n - 1);
+                        h(i, n - 1) = q * z + p * h(i, n);
+                        h(i, n) = q * h(i, n) - p * z;
+                    }
+                    for (int i = low; i <= high; i++) {
+                        z = v(i, n - 1);
+                        v(i, n - 1) = q * z + p * v(i, n);
+                        v(i, n) = q * v(i, n) - p * z;
+                    }
+                }
+            } else {
+                d[n - 1] = x + p;
+                d[n] = x + p;
+                e[n - 1] = z;
+                e[n] = -z;
+            }
+            n -= 2;
+            iter = 0;
+        } else {
+            if (iter >= MAX_ITERATIONS)
+                throw std::runtime_error("Eigenvalue iteration did not converge");
+
+            // Form shift
+            x = h(n, n);
+            y = 0.0;
+            w = 0.0;
+            if (l < n) {
+                y = h(n - 1, n - 1);
+                w = h(n, n - 1) * h(n - 1, n);
+            }
+
+            // Exceptional shifts break rare cycles
+            if (iter == 10) {
+                exshift += x;
+                for (int i = low; i <= n; i++)
+                    h(i, i) -= x;
+                s = std::abs(h(n, n - 1)) + std::abs(h(n - 1, n - 2));
+                x = y = 0.75 * s;
+                w = -0.4375 * s * s;
+            }
+            if (iter == 30) {
+                s = (y - x) / 2.0;
+                s = s * s + w;
+                if (s > 0) {
+                    s = std::sqrt(s);
+                    if (y < x)
+                        s = -s;
+                    s = x - w / ((y - x) / 2.0 + s);
+                    for (int i = low; i <= n; i++)
+                        h(i, i) -= s;
+                    exshift += s;
+                    x = y = w = 0.964;
+                }
+            }
+            iter++;
+
+            // Look for two consecutive small subdiagonal elements
+            int m = n - 2;
+            while (m >= l) {
+                z = h(m, m);
+                r = x - z;
+                s = y - z;
+                p = (r * s - w) / h(m + 1, m) + h(m, m + 1);
+                q = h(m + 1, m + 1) - z - r - s;
+                r = h(m + 2, m + 1);
+                s = std::abs(p) + std::abs(q) + std::abs(r);
+                p /= s;
+                q /= s;
+                r /= s;
+                if (m == l)
+                    break;
+                if (std::abs(h(m, m - 1)) * (std::abs(q) + std::abs(r)) <
+                    EPS * (std::abs(p) * (std::abs(h(m - 1, m - 1)) + std::abs(z) + std::abs(h(m + 1, m + 1)))))
+                    break;
+                m--;
+            }
+            for (int i = m + 2; i <= n; i++) {
+                h(i, i - 2) = 0.0;
+                if (i > m + 2)
+                    h(i, i - 3) = 0.0;
+            }
+
+            // Double QR step on rows l..n and columns m..n; the full matrix is only
+            // needed when eigenvectors are wanted
+            int rowEnd = accumulate ? nn - 1 : n;
+            int colBegin = accumulate ? 0 : l;
+            for (int k = m; k <= n - 1; k++) {
+                bool notlast = (k != n - 1);
+                if (k != m) {
+                    p = h(k, k - 1);
+                    q = h(k + 1, k - 1);
+                    r = notlast ? h(k + 2, k - 1) : 0.0;
+                    x = std::abs(p) + std::abs(q) + std::abs(r);
+                    if (x == 0.0)
+                        continue;
+                    p /= x;
+                    q /= x;
+                    r /= x;
+                }
+                s = std::sqrt(p * p + q * q + r * r);
+                if (p < 0)
+                    s = -s;
+                if (s == 0)
+                    continue;
+
+                if (k != m)
+                    h(k, k - 1) = -s * x;
+                else if (l != m)
+                    h(k, k - 1) = -h(k, k - 1);
+                p += s;
+                x = p / s;
+                y = q / s;
+                z = r / s;
+                q /= p;
+                r /= p;
+
+                // Row modification
+                for (int j = k; j <= rowEnd; j++) {
+                    p = h(k, j) + q * h(k + 1, j);
+                    if (notlast) {
+                        p += r * h(k + 2, j);
+                        h(k + 2, j) -= p * z;
+                    }
+                    h(k, j) -= p * x;
+                    h(k + 1, j) -= p * y;
+                }
+
+                // Column modification
+                for (int i = colBegin; i <= std::min(n, k + 3); i++) {
+                    p = x * h(i, k) + y * h(i, k + 1);
+                    if (notlast) {
+                        p += z * h(i, k + 2);
+                        h(i, k + 2) -= p * r;
+                    }
+                    h(i, k) -= p;
+                    h(i, k + 1) -= p * q;
+                }
+
+                // Accumulate transformations
+                if (accumulate) {
+                    for (int i = low; i <= high; i++) {
+                        double* row = v.row(i);
+                        p = x * row[k] + y * row[k + 1];
+                        if (notlast) {
+                            p += z * row[k + 2];
+                            row[k + 2] -= p * r;
+                        }
+                        row[k] -= p;
+                        row[k + 1] -= p * q;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!accumulate || norm == 0.0)
+        return;
+
+    // Back substitution for the eigenvectors of the upper quasi-triangular matrix
+    for (n = nn - 1; n >= 0; n--) {
+        p = d[n];
+        q = e[n];
+
+        if (q == 0) {
+            // Real vector
+            int l = n;
+            h(n, n) = 1.0;
+            for (int i = n - 1; i >= 0; i--) {
+                w = h(i, i) - p;
+                r = 0.0;
+                for (int j = l; j <= n; j++)
+                    r += h(i, j) * h(j, n);
+                if (e[i] < 0.0) {
+                    z = w;
+                    s = r;
+                } else {
+                    l = i;
+                    if (e[i] == 0.0) {
+                        h(i, n) = w != 0.0 ? -r / w : -r / (EPS * norm);
+                    } else {
+                        x = h(i, i + 1);
+                        y = h(i + 1, i);
+                        q = (d[i] - p) * (d[i] - p) + e[i] * e[i];
+                        t = (x * s - z * r) / q;
+                        h(i, n) = t;
+                        h(i + 1, n) = std::abs(x) > std::abs(z) ? (-r - w * t) / x : (-s - y * t) / z;
+                    }
+                    t = std::abs(h(i, n));
+                    if ((EPS * t) * t > 1)
+                        for (int j = i; j <= n; j++)
+                            h(j, n) /= t;
+                }
+            }
+        } else if (q < 0) {
+            // Complex vector, stored as (real, imaginary) in columns n-1 and n
+            int l = n - 1;
+            if (std::abs(h(n, n - 1)) > std::abs(h(n - 1, n))) {
+                h(n - 1, n - 1) = q / h(n, n - 1);
+                h(n - 1, n) = -(h(n, n) - p) / h(n, n - 1);
+            } else {
+                std::complex<double> c = cdiv(0.0, -h(n - 1, n), h(n - 1, n - 1) - p, q);
+                h(n - 1, n - 1) = c.real();
+                h(n - 1, n) = c.imag();
+            }
+            h(n, n - 1) = 0.0;
+            h(n, n) = 1.0;
+            for (int i = n - 2; i >= 0; i--) {
+                double ra = 0.0, sa = 0.0;
+                for (int j = l; j <= n; j++) {
+                    ra += h(i, j) * h(j, n - 1);
+                    sa += h(i, j) * h(j, n);
+                }
+                w = h(i, i) - p;
+
+                if (e[i] < 0.0) {
+                    z = w;
+                    r = ra;
+                    s = sa;
+                } else {
+                    l = i;
+                    if (e[i] == 0) {
+                        std::complex<double> c = cdiv(-ra, -sa, w, q);
+                        h(i, n - 1) = c.real();
+                        h(i, n) = c.imag();
+                    } else {
+                        x = h(i, i + 1);
+                        y = h(i + 1, i);
+                        double vr = (d[i] - p) * (d[i] - p) + e[i] * e[i] - q * q;
+                        double vi = (d[i] - p) * 2.0 * q;
+                        if (vr == 0.0 && vi == 0.0)
+                            vr = EPS * norm * (std::abs(w) + std::abs(q) + std::abs(x) + std::abs(y) + std::abs(z));
+                        std::complex<double> c = cdiv(x * r - z * ra + q * sa, x * s - z * sa - q * ra, vr, vi);
+                        h(i, n - 1) = c.real();
+                        h(i, n) = c.imag();
+                        if (std::abs(x) > std::abs(z) + std::abs(q)) {
+                            h(i + 1, n - 1) = (-ra - w * h(i, n - 1) + q * h(i, n)) / x;
+                            h(i + 1, n) = (-sa - w * h(i, n) - q * h(i, n - 1)) / x;
+                        } else {
+                            c = cdiv(-r - y * h(i, n - 1), -s - y * h(i, n), z, q);
+                            h(i + 1, n - 1) = c.real();
+                            h(i + 1, n) = c.imag();
+                        }
+                    }
+                    t = std::max(std::abs(h(i, n - 1)), std::abs(h(i, n)));
+                    if ((EPS * t) * t > 1) {
+                        for (int j = i; j <= n; j++) {
+                            h(j, n - 1) /= t;
+                            h(j, n) /= t;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Back transformation: V = V * triu(H), through the GEMM kernel
+    Square upper(nn);
+    for (int i = 0; i < nn; i++)
+        std::copy(h.row(i) + i, h.row(i) + nn, upper.row(i) + i);
+    Square product(nn);
+    gemm::multiplyAdd(nn, nn, nn, v.a.data(), nn, upper.a.data(), nn, product.a.data(), nn);
+    v.a.swap(product.a);
+}
+
+// Column j of v as a unit-length complex vector
+std::vector<std::complex<double>> realColumn(Square& v, int j) {
+    std::vector<std::complex<double>> result(v.n);
+    double norm = 0.0;
+    for (int i = 0; i < v.n; i++)
+        norm += v(i, j) * v(i, j);
+    norm = norm > 0 ? std::sqrt(norm) : 1.0;
+    for (int i = 0; i < v.n; i++)
+        result[i] = v(i, j) / norm;
+    return result;
+}
+
+// Columns j and j+1 of v as the real and imaginary parts of a unit-length vector
+std::vector<std::complex<double>> complexColumn(Square& v, int j, double sign) {
+    std::vector<std::complex<double>> result(v.n);
+    double norm = 0.0;
+    for (int i = 0; i < v.n; i++)
+        norm += v(i, j) * v(i, j) + v(i, j + 1) * v(i, j + 1);
+    norm = norm > 0 ? std::sqrt(norm) : 1.0;
+    for (int i = 0; i < v.n; i++)
+        result[i] = std::complex<double>(v(i, j), sign * v(i, j + 1)) / norm;
+    return result;
+}
+
+} // namespace
+
+// Constructor
+EigenSolver::EigenSolver(const Matrix& a, bool computeVectors) : symmetric(true) {
+    if (a.getRows() != a.getCols())
+        throw std::invalid_argument("Eigenvalues are only defined for square matrices");
+    int n = a.getRows();
+    if (n == 0)
+        return;
+
+    for (int i = 0; i < n && symmetric; i++)
+        for (int j = 0; j < i && symmetric; j++)
+            symmetric = a.rowData(i)[j] == a.rowData(j)[i];
+
+    Square work(n);
+    for (int i = 0; i < n; i++)
+        std::copy(a.rowData(i), a.rowData(i) + n, work.row(i));
+    std::vector<double> d(n, 0.0), e(n, 0.0);
+
+    if (symmetric) {
+        tridiagonalize(work, d, e, computeVectors);
+        diagonalizeTridiagonal(work, d, e, computeVectors);
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int x, int y) { return d[x] < d[y]; });
+        for (int k : order) {
+            values.emplace_back(d[k], 0.0);
+            if (computeVectors)
+                vectors.push_back(realColumn(work, k));
+        }
+        return;
+    }
+
+    Square v(computeVectors ? n : 0);
+    hessenberg(work, v, computeVectors);
+    schur(work, v, d, e, computeVectors);
+
+    for (int k = 0; k < n; k++) {
+        values.emplace_back(d[k], e[k]);
+        if (!computeVectors)
+            continue;
+        if (e[k] == 0.0)
+            vectors.push_back(realColumn(v, k));
+        else if (e[k] > 0.0)
+            vectors.push_back(complexColumn(v, k, 1.0));
+        else
+            vectors.push_back(complexColumn(v, k - 1, -1.0));
+    }
+}
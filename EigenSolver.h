@@ -0,0 +1,34 @@
+#ifndef EIGEN_SOLVER_H
+#define EIGEN_SOLVER_H
+
+#include <complex>
+#include <vector>
+#include "Matrix.h"
+
+// Eigenvalues and eigenvectors of a real square matrix.
+//
+// Symmetric matrices are reduced to tridiagonal form by Householder reflections and
+// diagonalized with implicit QL iterations; their eigenvalues are real and returned in
+// ascending order. Other matrices are reduced to upper Hessenberg form and brought to
+// real Schur form with Francis double-shift QR iterations; complex conjugate pairs are
+// adjacent, the one with positive imaginary part first.
+//
+// Pass computeVectors = false to skip accumulating the transformations, which saves
+// most of the work when only the spectrum is needed. Eigenvectors are normalized to
+// unit Euclidean length.
+class EigenSolver {
+private:
+    std::vector<std::complex<double>> values;
+    std::vector<std::vector<std::complex<double>>> vectors;
+    bool symmetric;
+
+public:
+    // Constructor: performs the decomposition
+    explicit EigenSolver(const Matrix& a, bool computeVectors = true);
+
+    const std::vector<std::complex<double>>& eigenvalues() const { return values; }
+    const std::vector<std::vector<std::complex<double>>>& eigenvectors() const { return vectors; }
+    bool isSymmetric() const { return symmetric; }
+};
+
+#endif // EIGEN_SOLVER_H
@@ -0,0 +1,512 @@
+#include "FFT.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+using Value = std::complex<double>;
+
+// Largest prime handled by a direct butterfly; lengths with a larger prime factor go
+// through Bluestein
+constexpr int MAX_DIRECT_RADIX = 13;
+// Values per batch below which batched transforms stay on the calling thread
+constexpr std::size_t PARALLEL_BATCH_VALUES = std::size_t(1) << 15;
+
+// Plain complex arithmetic; std::complex's operator* adds NaN/Inf recovery calls at -O2
+inline Value mul(Value x, Value y) {
+    return Value(x.real() * y.real() - x.imag() * y.imag(), x.real() * y.imag() + x.imag() * y.real());
+}
+
+// -i * x
+inline Value mulNegI(Value x) {
+    return Value(x.imag(), -x.real());
+}
+
+// exp(-2 pi i k / n), evaluated directly in extended precision so each twiddle is
+// correctly rounded or within one ulp, independent of the others
+Value root(long long k, long long n) {
+    const long double pi = std::acos(-1.0L);
+    long double angle = -2.0L * pi * static_cast<long double>(k % n) / static_cast<long double>(n);
+    return Value(static_cast<double>(std::cos(angle)), static_cast<double>(std::sin(angle)));
+}
+
+// Prime factors, radix 4 first, then ascending primes
+std::vector<int> factorize(int n) {
+    std::vector<int> factors;
+    while (n % 4 == 0) {
+        factors.push_back(4);
+        n /= 4;
+    }
+    for (int p = 2; p * p <= n; p++) {
+        while (n % p == 0) {
+            factors.push_back(p);
+            n /= p;
+        }
+    }
+    if (n > 1)
+        factors.push_back(n);
+    return factors;
+}
+
+// Smallest power of two >= n
+int powerOfTwoAtLeast(int n) {
+    int m = 1;
+    while (m < n)
+        m <<= 1;
+    return m;
+}
+
+// Generic odd-radix butterfly: b[u] = sum_t a[t] w^(tu) with w = exp(-2 pi i / R)
+void butterflyGeneric(int radix, const Value* a, Value* b, const Value* roots) {
+    for (int u = 0; u < radix; u++) {
+        Value sum = a[0];
+        int index = 0;
+        for (int t = 1; t < radix; t++) {
+            index += u;
+            if (index >= radix)
+                index -= radix;
+            sum += mul(a[t], roots[index]);
+        }
+        b[u] = sum;
+    }
+}
+
+#if defined(__GNUC__)
+#define FFT_INLINE inline __attribute__((always_inline))
+#else
+#define FFT_INLINE inline
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FFT_HAVE_X86_DISPATCH 1
+#endif
+
+// One decimation-in-frequency Stockham pass of radix R over sub-transforms of `length`
+// values spaced `stride` apart:
+//     y[q + s (R p + u)] = w^(pu) * DFT_R(x[q + s (p + t m)], t < R)[u],  m = length / R
+// with w = exp(-2 pi i / length) read from tw[p (R - 1) + u - 1].
+template <int R>
+FFT_INLINE void passBody(int length, int stride, const Value* __restrict x, Value* __restrict y,
+                         const Value* __restrict tw) {
+    const int m = length / R;
+    const std::size_t sm = static_cast<std::size_t>(stride) * m;
+    for (int p = 0; p < m; p++) {
+        const Value* w = tw + static_cast<std::size_t>(p) * (R - 1);
+        const Value* in = x + static_cast<std::size_t>(stride) * p;
+        Value* out = y + static_cast<std::size_t>(stride) * R * p;
+        for (int q = 0; q < stride; q++) {
+            if constexpr (R == 2) {
+                Value a0 = in[q], a1 = in[q + sm];
+                out[q] = a0 + a1;
+                out[q + stride] = mul(a0 - a1, w[0]);
+            } else if constexpr (R == 3) {
+                const double s = 0.86602540378443864676; // sin(2 pi / 3)
+                Value a0 = in[q], a1 = in[q + sm], a2 = in[q + 2 * sm];
+                Value t1 = a1 + a2;
+                Value m1 = a0 - 0.5 * t1;
+                Value d = mulNegI((a1 - a2) * s);
+                out[q] = a0 + t1;
+                out[q + stride] = mul(m1 + d, w[0]);
+                out[q + 2 * stride] = mul(m1 - d, w[1]);
+            } else if constexpr (R == 4) {
+                Value a0 = in[q], a1 = in[q + sm], a2 = in[q + 2 * sm], a3 = in[q + 3 * sm];
+                Value t0 = a0 + a2, t1 = a0 - a2;
+                Value t2 = a1 + a3, t3 = mulNegI(a1 - a3);
+                out[q] = t0 + t2;
+                out[q + stride] = mul(t1 + t3, w[0]);
+                out[q + 2 * stride] = mul(t0 - t2, w[1]);
+                out[q + 3 * stride] = mul(t1 - t3, w[2]);
+            } else {
+                static_assert(R == 5, "Direct passes exist for radix 2, 3, 4 and 5");
+                const double c1 = 0.30901699437494742410, c2 = -0.80901699437494742410; // cos(2 pi k / 5)
+                const double s1 = 0.95105651629515357212, s2 = 0.58778525229247312917;  // sin(2 pi k / 5)
+                Value a0 = in[q], a1 = in[q + sm], a2 = in[q + 2 * sm], a3 = in[q + 3 * sm], a4 = in[q + 4 * sm];
+                Value t1 = a1 + a4, t2 = a2 + a3;
+                Value t3 = a1 - a4, t4 = a2 - a3;
+                Value m1 = a0 + c1 * t1 + c2 * t2;
+                Value m2 = a0 + c2 * t1 + c1 * t2;
+                Value n1 = mulNegI(s1 * t3 + s2 * t4);
+                Value n2 = mulNegI(s2 * t3 - s1 * t4);
+                out[q] = a0 + t1 + t2;
+                out[q + stride] = mul(m1 + n1, w[0]);
+                out[q + 2 * stride] = mul(m2 + n2, w[1]);
+                out[q + 3 * stride] = mul(m2 - n2, w[2]);
+                out[q + 4 * stride] = mul(m1 - n1, w[3]);
+            }
+        }
+    }
+}
+
+using PassKernel = void (*)(int length, int stride, const Value* x, Value* y, const Value* tw);
+
+template <int R>
+void passGeneric(int length, int stride, const Value* x, Value* y, const Value* tw) {
+    passBody<R>(length, stride, x, y, tw);
+}
+
+#ifdef FFT_HAVE_X86_DISPATCH
+template <int R>
+__attribute__((target("avx2,fma")))
+void passAvx2(int length, int stride, const Value* x, Value* y, const Value* tw) {
+    passBody<R>(length, stride, x, y, tw);
+}
+#endif
+
+// Direct passes indexed by radix, compiled for AVX2/FMA when the CPU has it
+struct PassKernels {
+    PassKernel byRadix[6];
+};
+
+PassKernels selectPassKernels() {
+#ifdef FFT_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return {{nullptr, nullptr, passAvx2<2>, passAvx2<3>, passAvx2<4>, passAvx2<5>}};
+#endif
+    return {{nullptr, nullptr, passGeneric<2>, passGeneric<3>, passGeneric<4>, passGeneric<5>}};
+}
+
+// The same pass for any odd radix; `roots` holds exp(-2 pi i k / radix)
+void stockhamPassGeneric(int radix, int length, int stride, const Value* x, Value* y, const Value* tw,
+                         const Value* roots) {
+    const int m = length / radix;
+    Value a[MAX_DIRECT_RADIX], b[MAX_DIRECT_RADIX];
+    for (int p = 0; p < m; p++) {
+        const Value* w = tw + static_cast<std::size_t>(p) * (radix - 1);
+        for (int q = 0; q < stride; q++) {
+            for (int t = 0; t < radix; t++)
+                a[t] = x[q + stride * (p + t * m)];
+            butterflyGeneric(radix, a, b, roots);
+            Value* out = y + q + static_cast<std::size_t>(stride) * radix * p;
+            out[0] = b[0];
+            for (int u = 1; u < radix; u++)
+                out[static_cast<std::size_t>(stride) * u] = mul(b[u], w[u - 1]);
+        }
+    }
+}
+
+// Per-thread scratch, one buffer per role so nested transforms never share one: the
+// Stockham ping-pong buffer, Bluestein's convolution buffer, and staging for
+// conversions and real transforms. Each grows to the largest size used.
+enum BufferRole { WORK, CHIRP, STAGING, BUFFER_ROLES };
+
+Value* scratch(BufferRole role, std::size_t size) {
+    thread_local std::vector<Value> buffers[BUFFER_ROLES];
+    std::vector<Value>& buffer = buffers[role];
+    if (buffer.size() < size)
+        buffer.resize(size);
+    return buffer.data();
+}
+
+void conjugate(Value* data, int n) {
+    for (int i = 0; i < n; i++)
+        data[i] = std::conj(data[i]);
+}
+
+// Run body(i) for i < count, in parallel when the batch holds enough values
+void forEachSignal(int count, std::size_t valuesPerSignal, const std::function<void(int)>& body) {
+    if (count > 1 && static_cast<std::size_t>(count) * valuesPerSignal >= PARALLEL_BATCH_VALUES
+        && ThreadPool::instance().threadCount() > 1) {
+        ThreadPool::instance().parallelFor(count, body);
+    } else {
+        for (int i = 0; i < count; i++)
+            body(i);
+    }
+}
+
+} // namespace
+
+// Plan construction: a Stockham schedule if every prime factor is small, otherwise a
+// Bluestein convolution of power-of-two length >= 2n - 1
+FFTPlan::FFTPlan(int n) : n(n) {
+    if (n <= 0)
+        throw std::invalid_argument("Transform length must be positive");
+
+    std::vector<int> factors = factorize(n);
+    if (!factors.empty() && *std::max_element(factors.begin(), factors.end()) > MAX_DIRECT_RADIX) {
+        convolution = get(powerOfTwoAtLeast(2 * n - 1));
+        int m = convolution->size();
+        chirp.resize(n);
+        for (long long k = 0; k < n; k++)
+            chirp[k] = root(k * k % (2LL * n), 2LL * n);
+        chirpSpectrum.assign(m, Value(0.0, 0.0));
+        chirpSpectrum[0] = std::conj(chirp[0]);
+        for (int k = 1; k < n; k++)
+            chirpSpectrum[k] = chirpSpectrum[m - k] = std::conj(chirp[k]);
+        convolution->forward(chirpSpectrum.data());
+        // Fold the inverse transform's 1/m into the kernel
+        for (Value& value : chirpSpectrum)
+            value /= static_cast<double>(m);
+        return;
+    }
+
+    int length = n, stride = 1;
+    for (int radix : factors) {
+        Stage stage{radix, length, stride, twiddles.size()};
+        int m = length / radix;
+        for (int p = 0; p < m; p++)
+            for (int u = 1; u < radix; u++)
+                twiddles.push_back(root(static_cast<long long>(p) * u, length));
+        // Generic butterflies read the radix's own roots after the stage table
+        if (radix != 2 && radix != 3 && radix != 4 && radix != 5)
+            for (int k = 0; k < radix; k++)
+                twiddles.push_back(root(k, radix));
+        stages.push_back(stage);
+        length = m;
+        stride *= radix;
+    }
+}
+
+std::shared_ptr<const FFTPlan> FFTPlan::get(int n) {
+    static std::mutex mutex;
+    static std::unordered_map<int, std::shared_ptr<const FFTPlan>> cache;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = cache.find(n);
+        if (found != cache.end())
+            return found->second;
+    }
+    // Built outside the lock: a Bluestein plan fetches its own power-of-two plan
+    auto plan = std::make_shared<const FFTPlan>(n);
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.emplace(n, plan).first->second;
+}
+
+// Mixed-radix passes ping-pong between data and a work buffer
+void FFTPlan::stockham(Value* data) const {
+    Value* x = data;
+    Value* y = scratch(WORK, n);
+    static const PassKernels kernels = selectPassKernels();
+    for (const Stage& stage : stages) {
+        const Value* tw = twiddles.data() + stage.twiddles;
+        if (stage.radix <= 5) {
+            kernels.byRadix[stage.radix](stage.length, stage.stride, x, y, tw);
+        } else {
+            const Value* roots = tw + static_cast<std::size_t>(stage.length / stage.radix) * (stage.radix - 1);
+            stockhamPassGeneric(stage.radix, stage.length, stage.stride, x, y, tw, roots);
+        }
+        std::swap(x, y);
+    }
+    if (x != data)
+        std::copy(x, x + n, data);
+}
+
+// X[k] = chirp[k] * sum_j (x[j] chirp[j]) conj(chirp[k - j]), as a circular convolution
+void FFTPlan::bluestein(Value* data) const {
+    int m = convolution->size();
+    Value* a = scratch(CHIRP, m);
+    for (int k = 0; k < n; k++)
+        a[k] = mul(data[k], chirp[k]);
+    std::fill(a + n, a + m, Value(0.0, 0.0));
+    convolution->forward(a);
+    for (int k = 0; k < m; k++)
+        a[k] = std::conj(mul(a[k], chirpSpectrum[k]));
+    // conj(forward(conj(z))) is the unscaled inverse; the 1/m is in chirpSpectrum
+    convolution->forward(a);
+    for (int k = 0; k < n; k++)
+        data[k] = mul(std::conj(a[k]), chirp[k]);
+}
+
+// Transforms
+void FFTPlan::forward(Value* data) const {
+    if (convolution)
+        bluestein(data);
+    else
+        stockham(data);
+}
+
+void FFTPlan::inverse(Value* data) const {
+    conjugate(data, n);
+    forward(data);
+    double scale = 1.0 / n;
+    for (int i = 0; i < n; i++)
+        data[i] = Value(data[i].real() * scale, -data[i].imag() * scale);
+}
+
+void FFTPlan::forward(Value* data, int count) const {
+    forEachSignal(count, n, [&](int i) { forward(data + static_cast<std::size_t>(i) * n); });
+}
+
+void FFTPlan::inverse(Value* data, int count) const {
+    forEachSignal(count, n, [&](int i) { inverse(data + static_cast<std::size_t>(i) * n); });
+}
+
+// Interop with Complex and ComplexArray
+std::vector<Complex> FFTPlan::forward(const std::vector<Complex>& signal) const {
+    if (static_cast<int>(signal.size()) != n)
+        throw std::invalid_argument("Signal length does not match the transform length");
+    std::vector<Value> values(n);
+    for (int i = 0; i < n; i++)
+        values[i] = Value(signal[i].realPart(), signal[i].imaginaryPart());
+    forward(values.data());
+    std::vector<Complex> result;
+    result.reserve(n);
+    for (const Value& value : values)
+        result.emplace_back(value.real(), value.imag());
+    return result;
+}
+
+std::vector<Complex> FFTPlan::inverse(const std::vector<Complex>& spectrum) const {
+    if (static_cast<int>(spectrum.size()) != n)
+        throw std::invalid_argument("Spectrum length does not match the transform length");
+    std::vector<Value> values(n);
+    for (int i = 0; i < n; i++)
+        values[i] = Value(spectrum[i].realPart(), spectrum[i].imaginaryPart());
+    inverse(values.data());
+    std::vector<Complex> result;
+    result.reserve(n);
+    for (const Value& value : values)
+        result.emplace_back(value.real(), value.imag());
+    return result;
+}
+
+void FFTPlan::forward(ComplexArray& signal) const {
+    if (signal.size() != n)
+        throw std::invalid_argument("Signal length does not match the transform length");
+    Value* values = scratch(STAGING, n);
+    for (int i = 0; i < n; i++)
+        values[i] = Value(signal.realData()[i], signal.imagData()[i]);
+    forward(values);
+    for (int i = 0; i < n; i++) {
+        signal.realData()[i] = values[i].real();
+        signal.imagData()[i] = values[i].imag();
+    }
+}
+
+void FFTPlan::inverse(ComplexArray& spectrum) const {
+    if (spectrum.size() != n)
+        throw std::invalid_argument("Spectrum length does not match the transform length");
+    Value* values = scratch(STAGING, n);
+    for (int i = 0; i < n; i++)
+        values[i] = Value(spectrum.realData()[i], spectrum.imagData()[i]);
+    inverse(values);
+    for (int i = 0; i < n; i++) {
+        spectrum.realData()[i] = values[i].real();
+        spectrum.imagData()[i] = values[i].imag();
+    }
+}
+
+// Real transforms. For even n, the samples are packed as z[j] = x[2j] + i x[2j + 1]
+// and one half-length transform Z yields both half spectra:
+//     E[k] = (Z[k] + conj(Z[h - k])) / 2,  O[k] = (Z[k] - conj(Z[h - k])) / 2i,
+//     X[k] = E[k] + w^k O[k],  X[h - k] = conj(E[k] - w^k O[k]),  w = exp(-2 pi i / n)
+RealFFTPlan::RealFFTPlan(int n) : n(n) {
+    if (n <= 0)
+        throw std::invalid_argument("Transform length must be positive");
+    if (n % 2 == 0) {
+        complexPlan = FFTPlan::get(n / 2);
+        for (int k = 0; k <= n / 4; k++)
+            twiddles.push_back(root(k, n));
+    } else {
+        complexPlan = FFTPlan::get(n);
+    }
+}
+
+std::shared_ptr<const RealFFTPlan> RealFFTPlan::get(int n) {
+    static std::mutex mutex;
+    static std::unordered_map<int, std::shared_ptr<const RealFFTPlan>> cache;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = cache.find(n);
+        if (found != cache.end())
+            return found->second;
+    }
+    auto plan = std::make_shared<const RealFFTPlan>(n);
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.emplace(n, plan).first->second;
+}
+
+void RealFFTPlan::forward(const double* signal, Value* spectrum) const {
+    if (n % 2 != 0) {
+        Value* full = scratch(STAGING, n);
+        for (int j = 0; j < n; j++)
+            full[j] = Value(signal[j], 0.0);
+        complexPlan->forward(full);
+        std::copy(full, full + spectrumSize(), spectrum);
+        return;
+    }
+
+    // The half-length transform runs in the first h slots of the output
+    int h = n / 2;
+    for (int j = 0; j < h; j++)
+        spectrum[j] = Value(signal[2 * j], signal[2 * j + 1]);
+    complexPlan->forward(spectrum);
+
+    Value z0 = spectrum[0];
+    spectrum[0] = Value(z0.real() + z0.imag(), 0.0);
+    spectrum[h] = Value(z0.real() - z0.imag(), 0.0);
+    for (int k = 1; 2 * k <= h; k++) {
+        Value zk = spectrum[k], zj = std::conj(spectrum[h - k]);
+        Value even = 0.5 * (zk + zj);
+        Value odd = mulNegI(0.5 * (zk - zj));
+        Value rotated = mul(twiddles[k], odd);
+        spectrum[h - k] = std::conj(even - rotated);
+        spectrum[k] = even + rotated;
+    }
+}
+
+// Inverse of the packing above: Z[k] = E[k] + i O[k] with
+//     E[k] = (X[k] + conj(X[h - k])) / 2,  O[k] = (X[k] - conj(X[h - k])) conj(w^k) / 2
+void RealFFTPlan::inverse(const Value* spectrum, double* signal) const {
+    if (n % 2 != 0) {
+        Value* full = scratch(STAGING, n);
+        for (int k = 0; k < spectrumSize(); k++)
+            full[k] = spectrum[k];
+        for (int k = spectrumSize(); k < n; k++)
+            full[k] = std::conj(spectrum[n - k]);
+        complexPlan->inverse(full);
+        for (int j = 0; j < n; j++)
+            signal[j] = full[j].real();
+        return;
+    }
+
+    int h = n / 2;
+    Value* z = scratch(STAGING, h);
+    double x0 = spectrum[0].real(), xh = spectrum[h].real();
+    z[0] = Value(0.5 * (x0 + xh), 0.5 * (x0 - xh));
+    for (int k = 1; 2 * k <= h; k++) {
+        Value xk = spectrum[k], xj = std::conj(spectrum[h - k]);
+        Value even = 0.5 * (xk + xj);
+        Value odd = mul(0.5 * (xk - xj), std::conj(twiddles[k]));
+        Value iOdd(-odd.imag(), odd.real());
+        z[k] = even + iOdd;
+        z[h - k] = std::conj(even - iOdd);
+    }
+    complexPlan->inverse(z);
+    for (int j = 0; j < h; j++) {
+        signal[2 * j] = z[j].real();
+        signal[2 * j + 1] = z[j].imag();
+    }
+}
+
+void RealFFTPlan::forward(const double* signals, Value* spectra, int count) const {
+    forEachSignal(count, n, [&](int i) {
+        forward(signals + static_cast<std::size_t>(i) * n, spectra + static_cast<std::size_t>(i) * spectrumSize());
+    });
+}
+
+void RealFFTPlan::inverse(const Value* spectra, double* signals, int count) const {
+    forEachSignal(count, n, [&](int i) {
+        inverse(spectra + static_cast<std::size_t>(i) * spectrumSize(), signals + static_cast<std::size_t>(i) * n);
+    });
+}
+
+std::vector<Value> RealFFTPlan::forward(const std::vector<double>& signal) const {
+    if (static_cast<int>(signal.size()) != n)
+        throw std::invalid_argument("Signal length does not match the transform length");
+    std::vector<Value> spectrum(spectrumSize());
+    forward(signal.data(), spectrum.data());
+    return spectrum;
+}
+
+std::vector<double> RealFFTPlan::inverse(const std::vector<Value>& spectrum) const {
+    if (static_cast<int>(spectrum.size()) != spectrumSize())
+        throw std::invalid_argument("Spectrum length does not match the transform length");
+    std::vector<double> signal(n);
+    inverse(spectrum.data(), signal.data());
+    return signal;
+}
@@ -0,0 +1,97 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <memory>
+#include <vector>
+#include "Complex.h"
+#include "ComplexArray.h"
+
+// Discrete Fourier transforms of any length.
+//
+// A plan holds everything that depends only on the length: the factorization, the
+// twiddle tables and, for awkward lengths, the Bluestein chirp. Lengths whose prime
+// factors are all small run as a mixed-radix Stockham FFT (radix 4, 2, 3, 5 and
+// generic butterflies up to 13); any other length is computed exactly through
+// Bluestein's algorithm on a power-of-two transform. get() caches plans by length,
+// so repeated transforms of one size pay the setup once; plans are immutable and
+// may be shared across threads.
+//
+// forward() computes X[k] = sum_j x[j] exp(-2 pi i jk / n); inverse() uses the
+// opposite sign and divides by n, so inverse(forward(x)) == x up to rounding.
+class FFTPlan {
+private:
+    struct Stage {
+        int radix;
+        int length;           // sub-transform length at this stage
+        int stride;           // distance between consecutive sub-transforms
+        std::size_t twiddles; // offset of this stage's table in `twiddles`
+    };
+
+    int n;
+    std::vector<Stage> stages;
+    std::vector<std::complex<double>> twiddles;
+
+    // Bluestein: chirp[k] = exp(-pi i k^2 / n) and the transformed conjugate chirp
+    std::shared_ptr<const FFTPlan> convolution;
+    std::vector<std::complex<double>> chirp;
+    std::vector<std::complex<double>> chirpSpectrum;
+
+    void stockham(std::complex<double>* data) const;
+    void bluestein(std::complex<double>* data) const;
+
+public:
+    explicit FFTPlan(int n);
+
+    // Shared plan for length n, built on first use
+    static std::shared_ptr<const FFTPlan> get(int n);
+
+    int size() const { return n; }
+    bool usesBluestein() const { return convolution != nullptr; }
+
+    // In-place transforms of n values
+    void forward(std::complex<double>* data) const;
+    void inverse(std::complex<double>* data) const;
+
+    // In-place transforms of `count` consecutive signals of n values each, spread over
+    // the thread pool when the batch is large enough
+    void forward(std::complex<double>* data, int count) const;
+    void inverse(std::complex<double>* data, int count) const;
+
+    // Interop with the project's complex types
+    std::vector<Complex> forward(const std::vector<Complex>& signal) const;
+    std::vector<Complex> inverse(const std::vector<Complex>& spectrum) const;
+    void forward(ComplexArray& signal) const;
+    void inverse(ComplexArray& spectrum) const;
+};
+
+// Transforms of real signals. A real signal of length n has a Hermitian spectrum, so
+// only the n / 2 + 1 bins X[0 .. n / 2] are produced and consumed. Even lengths run
+// as one complex transform of half the length.
+class RealFFTPlan {
+private:
+    int n;
+    std::shared_ptr<const FFTPlan> complexPlan; // length n / 2 if n is even, else n
+    std::vector<std::complex<double>> twiddles;  // exp(-2 pi i k / n), k <= n / 4
+
+public:
+    explicit RealFFTPlan(int n);
+
+    static std::shared_ptr<const RealFFTPlan> get(int n);
+
+    int size() const { return n; }
+    int spectrumSize() const { return n / 2 + 1; }
+
+    // signal: n values; spectrum: n / 2 + 1 values. inverse() divides by n.
+    void forward(const double* signal, std::complex<double>* spectrum) const;
+    void inverse(const std::complex<double>* spectrum, double* signal) const;
+
+    // `count` consecutive signals and spectra, spread over the thread pool
+    void forward(const double* signals, std::complex<double>* spectra, int count) const;
+    void inverse(const std::complex<double>* spectra, double* signals, int count) const;
+
+    std::vector<std::complex<double>> forward(const std::vector<double>& signal) const;
+    std::vector<double> inverse(const std::vector<std::complex<double>>& spectrum) const;
+};
+
+#endif // FFT_H
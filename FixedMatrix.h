@@ -0,0 +1,330 @@
+#ifndef FIXED_MATRIX_H
+#define FIXED_MATRIX_H
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "Matrix.h"
+
+// Compile-time sized R x C matrix with inline (stack) storage, for the small transforms
+// that dominate typical use. Arithmetic is constexpr and unrolled through index
+// sequences; mismatched dimensions do not compile. Conversions to and from the dynamic
+// Matrix check dimensions at run time.
+template <int R, int C>
+class FixedMatrix {
+    static_assert(R > 0 && C > 0, "FixedMatrix dimensions must be positive");
+
+private:
+    std::array<double, R * C> data{};
+
+    template <std::size_t... I>
+    constexpr FixedMatrix combine(const FixedMatrix& other, double sign, std::index_sequence<I...>) const {
+        FixedMatrix result;
+        ((result.data[I] = data[I] + sign * other.data[I]), ...);
+        return result;
+    }
+
+    template <std::size_t... I>
+    constexpr FixedMatrix scaled(double scalar, std::index_sequence<I...>) const {
+        FixedMatrix result;
+        ((result.data[I] = data[I] * scalar), ...);
+        return result;
+    }
+
+    template <int K, std::size_t... P>
+    constexpr double rowTimesColumn(const FixedMatrix<C, K>& other, int i, int j, std::index_sequence<P...>) const {
+        return ((data[i * C + P] * other(P, j)) + ...);
+    }
+
+    template <int K, std::size_t... I>
+    constexpr FixedMatrix<R, K> product(const FixedMatrix<C, K>& other, std::index_sequence<I...>) const {
+        FixedMatrix<R, K> result;
+        ((result(I / K, I % K) = rowTimesColumn(other, I / K, I % K, std::make_index_sequence<C>())), ...);
+        return result;
+    }
+
+    template <std::size_t... I>
+    constexpr FixedMatrix<C, R> transposed(std::index_sequence<I...>) const {
+        FixedMatrix<C, R> result;
+        ((result(I % C, I / C) = data[I]), ...);
+        return result;
+    }
+
+    static constexpr double absolute(double x) { return x < 0 ? -x : x; }
+
+    // Gaussian elimination with partial pivoting, for sizes without a closed form
+    constexpr double eliminationDeterminant() const {
+        FixedMatrix a = *this;
+        double det = 1.0;
+        for (int k = 0; k < R; k++) {
+            int pivot = k;
+            for (int i = k + 1; i < R; i++)
+                if (absolute(a(i, k)) > absolute(a(pivot, k)))
+                    pivot = i;
+            if (a(pivot, k) == 0.0)
+                return 0.0;
+            if (pivot != k) {
+                for (int j = 0; j < C; j++) {
+                    double t = a(k, j);
+                    a(k, j) = a(pivot, j);
+                    a(pivot, j) = t;
+                }
+                det = -det;
+            }
+            det *= a(k, k);
+            for (int i = k + 1; i < R; i++) {
+                double l = a(i, k) / a(k, k);
+                for (int j = k; j < C; j++)
+                    a(i, j) -= l * a(k, j);
+            }
+        }
+        return det;
+    }
+
+public:
+    // Constructors: zero matrix, or row-major values
+    constexpr FixedMatrix() = default;
+
+    constexpr FixedMatrix(std::initializer_list<double> values) {
+        if (values.size() != static_cast<std::size_t>(R * C))
+            throw std::invalid_argument("Number of values does not match matrix dimensions");
+        std::size_t k = 0;
+        for (double v : values)
+            data[k++] = v;
+    }
+
+    // Conversion from a dynamic matrix of the same shape
+    explicit FixedMatrix(const Matrix& m) {
+        if (m.getRows() != R || m.getCols() != C)
+            throw std::invalid_argument("Matrix dimensions do not match for conversion");
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                data[i * C + j] = m.rowData(i)[j];
+    }
+
+    static constexpr FixedMatrix identity() {
+        static_assert(R == C, "Identity is only defined for square matrices");
+        FixedMatrix result;
+        for (int i = 0; i < R; i++)
+            result(i, i) = 1.0;
+        return result;
+    }
+
+    // Conversion to a dynamic matrix
+    Matrix toMatrix() const {
+        Matrix result(R, C);
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                result.rowData(i)[j] = data[i * C + j];
+        return result;
+    }
+
+    // Dimensions
+    static constexpr int getRows() { return R; }
+    static constexpr int getCols() { return C; }
+
+    // Unchecked element access
+    constexpr double operator()(int i, int j) const { return data[i * C + j]; }
+    constexpr double& operator()(int i, int j) { return data[i * C + j]; }
+
+    // Element setters and getters
+    constexpr void setElement(int i, int j, double value) {
+        if (i < 0 || i >= R || j < 0 || j >= C)
+            throw std::out_of_range("Index out of range");
+        data[i * C + j] = value;
+    }
+
+    constexpr double getElement(int i, int j) const {
+        if (i < 0 || i >= R || j < 0 || j >= C)
+            throw std::out_of_range("Index out of range");
+        return data[i * C + j];
+    }
+
+    // Matrix operations
+    constexpr FixedMatrix operator+(const FixedMatrix& other) const {
+        return combine(other, 1.0, std::make_index_sequence<R * C>());
+    }
+
+    constexpr FixedMatrix operator-(const FixedMatrix& other) const {
+        return combine(other, -1.0, std::make_index_sequence<R * C>());
+    }
+
+    constexpr FixedMatrix operator*(double scalar) const {
+        return scaled(scalar, std::make_index_sequence<R * C>());
+    }
+
+    friend constexpr FixedMatrix operator*(double scalar, const FixedMatrix& m) {
+        return m * scalar;
+    }
+
+    template <int K>
+    constexpr FixedMatrix<R, K> operator*(const FixedMatrix<C, K>& other) const {
+        return product(other, std::make_index_sequence<R * K>());
+    }
+
+    constexpr bool operator==(const FixedMatrix& other) const {
+        for (int k = 0; k < R * C; k++)
+            if (data[k] != other.data[k])
+                return false;
+        return true;
+    }
+
+    constexpr bool operator!=(const FixedMatrix& other) const { return !(*this == other); }
+
+    constexpr FixedMatrix<C, R> transpose() const {
+        return transposed(std::make_index_sequence<R * C>());
+    }
+
+    constexpr double trace() const {
+        static_assert(R == C, "Trace is only defined for square matrices");
+        double sum = 0.0;
+        for (int i = 0; i < R; i++)
+            sum += data[i * C + i];
+        return sum;
+    }
+
+    // Determinant: closed forms up to 4x4, elimination beyond
+    constexpr double determinant() const {
+        static_assert(R == C, "Determinant is only defined for square matrices");
+        const auto& m = *this;
+        if constexpr (R == 1) {
+            return m(0, 0);
+        } else if constexpr (R == 2) {
+            return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+        } else if constexpr (R == 3) {
+            return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1))
+                 - m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0))
+                 + m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+        } else if constexpr (R == 4) {
+            double s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+            double s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+            double s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+            double s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+            double s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+            double s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+            double c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+            double c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+            double c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+            double c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+            double c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+            double c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        } else {
+            return eliminationDeterminant();
+        }
+    }
+
+    // Adjugate (transposed cofactor matrix) in closed form, up to 4x4
+    constexpr FixedMatrix adjugate() const {
+        static_assert(R == C && R <= 4, "Closed-form adjugate is available up to 4x4");
+        const auto& m = *this;
+        if constexpr (R == 1) {
+            return FixedMatrix{1.0};
+        } else if constexpr (R == 2) {
+            return FixedMatrix{m(1, 1), -m(0, 1),
+                               -m(1, 0), m(0, 0)};
+        } else if constexpr (R == 3) {
+            return FixedMatrix{
+                m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1),
+                m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2),
+                m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1),
+                m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2),
+                m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0),
+                m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2),
+                m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0),
+                m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1),
+                m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)};
+        } else {
+            double s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+            double s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+            double s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+            double s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+            double s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+            double s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+            double c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+            double c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+            double c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+            double c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+            double c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+            double c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+            return FixedMatrix{
+                m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3,
+                -m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3,
+                m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3,
+                -m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3,
+                -m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1,
+                m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1,
+                -m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1,
+                m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1,
+                m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0,
+                -m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0,
+                m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0,
+                -m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0,
+                -m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0,
+                m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0,
+                -m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0,
+                m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0};
+        }
+    }
+
+    // Inverse: adjugate / determinant up to 4x4, Gauss-Jordan beyond
+    constexpr FixedMatrix inverse() const {
+        static_assert(R == C, "Inverse is only defined for square matrices");
+        double det = determinant();
+        if (det == 0.0)
+            throw std::invalid_argument("Matrix is singular and cannot be inverted");
+
+        if constexpr (R <= 4) {
+            return adjugate() * (1.0 / det);
+        } else {
+            FixedMatrix a = *this;
+            FixedMatrix result = identity();
+            for (int k = 0; k < R; k++) {
+                int pivot = k;
+                for (int i = k + 1; i < R; i++)
+                    if (absolute(a(i, k)) > absolute(a(pivot, k)))
+                        pivot = i;
+                for (int j = 0; j < C; j++) {
+                    double t = a(k, j);
+                    a(k, j) = a(pivot, j);
+                    a(pivot, j) = t;
+                    t = result(k, j);
+                    result(k, j) = result(pivot, j);
+                    result(pivot, j) = t;
+                }
+                double p = 1.0 / a(k, k);
+                for (int j = 0; j < C; j++) {
+                    a(k, j) *= p;
+                    result(k, j) *= p;
+                }
+                for (int i = 0; i < R; i++) {
+                    if (i == k)
+                        continue;
+                    double l = a(i, k);
+                    for (int j = 0; j < C; j++) {
+                        a(i, j) -= l * a(k, j);
+                        result(i, j) -= l * result(k, j);
+                    }
+                }
+            }
+            return result;
+        }
+    }
+
+    // Display matrix
+    void display() const {
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++)
+                std::cout << std::setw(8) << data[i * C + j] << " ";
+            std::cout << std::endl;
+        }
+    }
+};
+
+using Matrix2 = FixedMatrix<2, 2>;
+using Matrix3 = FixedMatrix<3, 3>;
+using Matrix4 = FixedMatrix<4, 4>;
+
+#endif // FIXED_MATRIX_H
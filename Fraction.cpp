@@ -1,62 +1,201 @@
 #include "Fraction.h"
+#include "NumberTheory.h"
+#include <cmath>
+#include <limits>
 
-// Constructor
-Fraction::Fraction(int num, int den) : numerator(num), denominator(den) {
+namespace {
+
+using Wide = __int128;
+
+constexpr long long SMALL_MAX = std::numeric_limits<long long>::max();
+
+using numbertheory::detail::unsignedAbs;
+
+// gcd(|v|, g) for a 128-bit v and a non-zero 64-bit g
+unsigned long long gcdWide(Wide v, unsigned long long g) {
+    unsigned __int128 m = v < 0 ? -static_cast<unsigned __int128>(v) : static_cast<unsigned __int128>(v);
+    return static_cast<unsigned long long>(numbertheory::gcd128(m, g));
+}
+
+// LLONG_MIN is excluded from the inline range so that negation never overflows
+bool fitsSmall(Wide v) {
+    return v >= -SMALL_MAX && v <= SMALL_MAX;
+}
+
+BigInteger toBig(Wide v) {
+    unsigned __int128 m = v < 0 ? -static_cast<unsigned __int128>(v) : static_cast<unsigned __int128>(v);
+    BigInteger result = (BigInteger::fromUnsigned(static_cast<unsigned long long>(m >> 64)) << 64)
+        + BigInteger::fromUnsigned(static_cast<unsigned long long>(m));
+    return v < 0 ? -result : result;
+}
+
+} // namespace
+
+// Constructors
+Fraction::Fraction(long long num, long long den) : numerator(0), denominator(1) {
     if (den == 0) {
         throw std::invalid_argument("Error: Denominator cannot be zero.");
     }
-    simplify();
+    unsigned long long g = numbertheory::gcd64(unsignedAbs(num), unsignedAbs(den));
+    Wide n = num, d = den;
+    if (d < 0) {
+        n = -n;
+        d = -d;
+    }
+    setReduced(n / g, d / g);
 }
 
-// Helper function to simplify the fraction
-void Fraction::simplify() {
-    int gcd = std::gcd(numerator, denominator);
-    numerator /= gcd;
-    denominator /= gcd;
-    if (denominator < 0) {
-        numerator = -numerator;
-        denominator = -denominator;
+Fraction::Fraction(const BigInteger& num, const BigInteger& den) : numerator(0), denominator(1) {
+    if (den.isZero()) {
+        throw std::invalid_argument("Error: Denominator cannot be zero.");
     }
+    BigInteger g = BigInteger::gcd(num, den);
+    BigInteger n = num / g, d = den / g;
+    if (d.isNegative()) {
+        n = -n;
+        d = -d;
+    }
+    setReduced(std::move(n), std::move(d));
 }
 
-// Addition
+void Fraction::setReduced(Wide num, Wide den) {
+    if (fitsSmall(num) && den <= SMALL_MAX) {
+        numerator = static_cast<long long>(num);
+        denominator = static_cast<long long>(den);
+        big.reset();
+    } else {
+        setReduced(toBig(num), toBig(den));
+    }
+}
+
+void Fraction::setReduced(BigInteger num, BigInteger den) {
+    if (num.fitsInt64() && den.fitsInt64() && num.toInt64() != std::numeric_limits<long long>::min()) {
+        numerator = num.toInt64();
+        denominator = den.toInt64();
+        big.reset();
+    } else {
+        big = std::make_shared<const BigParts>(BigParts{std::move(num), std::move(den)});
+    }
+}
+
+// Accessors
+BigInteger Fraction::getNumerator() const {
+    return big ? big->numerator : BigInteger(numerator);
+}
+
+BigInteger Fraction::getDenominator() const {
+    return big ? big->denominator : BigInteger(denominator);
+}
+
+int Fraction::sign() const {
+    if (big)
+        return big->numerator.sign();
+    return (numerator > 0) - (numerator < 0);
+}
+
+double Fraction::toDouble() const {
+    if (!big)
+        return static_cast<double>(numerator) / static_cast<double>(denominator);
+    // Keep 64 significant bits of each part so the quotient neither overflows nor
+    // underflows before the exponents are recombined
+    int numShift = static_cast<int>(std::max<std::size_t>(big->numerator.bitLength(), 64) - 64);
+    int denShift = static_cast<int>(std::max<std::size_t>(big->denominator.bitLength(), 64) - 64);
+    double ratio = (big->numerator >> numShift).toDouble() / (big->denominator >> denShift).toDouble();
+    return std::ldexp(ratio, numShift - denShift);
+}
+
+// Negation
+Fraction Fraction::operator-() const {
+    if (!big)
+        return fromReduced<Wide>(-static_cast<Wide>(numerator), denominator);
+    return fromReduced<BigInteger>(-big->numerator, big->denominator);
+}
+
+// Addition: with g = gcd(b, d), a/b + c/d = (a (d/g) + c (b/g)) / (b d / g), and only
+// gcd(numerator, g) can remain in common
 Fraction Fraction::operator+(const Fraction& other) const {
-    int num = numerator * other.denominator + other.numerator * denominator;
-    int den = denominator * other.denominator;
-    return Fraction(num, den);
+    if (!big && !other.big) {
+        long long g = static_cast<long long>(numbertheory::gcd64(denominator, other.denominator));
+        Wide num = static_cast<Wide>(numerator) * (other.denominator / g)
+            + static_cast<Wide>(other.numerator) * (denominator / g);
+        unsigned long long h = gcdWide(num, static_cast<unsigned long long>(g));
+        Wide den = static_cast<Wide>(denominator / g) * static_cast<long long>(other.denominator / h);
+        return fromReduced<Wide>(num / static_cast<Wide>(h), den);
+    }
+    BigInteger b = getDenominator(), d = other.getDenominator();
+    BigInteger g = BigInteger::gcd(b, d);
+    BigInteger bg = b / g;
+    BigInteger num = getNumerator() * (d / g) + other.getNumerator() * bg;
+    BigInteger h = BigInteger::gcd(num, g);
+    return fromReduced<BigInteger>(num / h, bg * (d / h));
 }
 
 // Subtraction
 Fraction Fraction::operator-(const Fraction& other) const {
-    int num = numerator * other.denominator - other.numerator * denominator;
-    int den = denominator * other.denominator;
-    return Fraction(num, den);
+    return *this + (-other);
 }
 
-// Multiplication
+// Multiplication: cancel each numerator against the other denominator first
 Fraction Fraction::operator*(const Fraction& other) const {
-    int num = numerator * other.numerator;
-    int den = denominator * other.denominator;
-    return Fraction(num, den);
+    if (!big && !other.big) {
+        long long g1 = static_cast<long long>(numbertheory::gcd64(unsignedAbs(numerator), unsignedAbs(other.denominator)));
+        long long g2 = static_cast<long long>(numbertheory::gcd64(unsignedAbs(other.numerator), unsignedAbs(denominator)));
+        Wide num = static_cast<Wide>(numerator / g1) * (other.numerator / g2);
+        Wide den = static_cast<Wide>(denominator / g2) * (other.denominator / g1);
+        return fromReduced<Wide>(num, den);
+    }
+    BigInteger a = getNumerator(), b = getDenominator();
+    BigInteger c = other.getNumerator(), d = other.getDenominator();
+    BigInteger g1 = BigInteger::gcd(a, d), g2 = BigInteger::gcd(c, b);
+    return fromReduced<BigInteger>((a / g1) * (c / g2), (b / g2) * (d / g1));
 }
 
 // Division
 Fraction Fraction::operator/(const Fraction& other) const {
-    if (other.numerator == 0) {
+    if (other.isZero()) {
         throw std::invalid_argument("Error: Cannot divide by zero.");
     }
-    int num = numerator * other.denominator;
-    int den = denominator * other.numerator;
-    return Fraction(num, den);
+    // Multiply by the reciprocal, keeping its denominator positive
+    Fraction reciprocal;
+    if (!other.big) {
+        reciprocal.numerator = other.numerator < 0 ? -other.denominator : other.denominator;
+        reciprocal.denominator = other.numerator < 0 ? -other.numerator : other.numerator;
+    } else if (other.big->numerator.isNegative()) {
+        reciprocal = fromReduced<BigInteger>(-other.big->denominator, -other.big->numerator);
+    } else {
+        reciprocal = fromReduced<BigInteger>(other.big->denominator, other.big->numerator);
+    }
+    return *this * reciprocal;
 }
 
-// Equality check
+// Equality check; the representation is canonical, so inline and promoted values
+// never compare equal
 bool Fraction::operator==(const Fraction& other) const {
+    if (big || other.big)
+        return big && other.big && big->numerator == other.big->numerator
+            && big->denominator == other.big->denominator;
     return numerator == other.numerator && denominator == other.denominator;
 }
 
+// Ordering by cross-multiplication; denominators are positive
+int Fraction::compare(const Fraction& a, const Fraction& b) {
+    if (!a.big && !b.big) {
+        Wide left = static_cast<Wide>(a.numerator) * b.denominator;
+        Wide right = static_cast<Wide>(b.numerator) * a.denominator;
+        return (left > right) - (left < right);
+    }
+    return BigInteger::compare(a.getNumerator() * b.getDenominator(), b.getNumerator() * a.getDenominator());
+}
+
 // Output operator
 std::ostream& operator<<(std::ostream& out, const Fraction& fraction) {
+    if (fraction.big) {
+        out << fraction.big->numerator;
+        if (fraction.big->denominator != BigInteger(1)) {
+            out << "/" << fraction.big->denominator;
+        }
+        return out;
+    }
     out << fraction.numerator;
     if (fraction.denominator != 1) {
         out << "/" << fraction.denominator;
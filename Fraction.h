@@ -2,27 +2,68 @@
 #define FRACTION_H
 
 #include <iostream>
-#include <numeric>
+#include <memory>
 #include <stdexcept>
+#include "BigInteger.h"
 
+// Exact rational number in lowest terms with a positive denominator.
+//
+// Values whose numerator and denominator fit in 64 bits are stored inline and
+// computed with 128-bit intermediates, so no operation can overflow silently. A result
+// that does not fit is promoted to BigInteger storage and demoted again as soon as it
+// fits. Operands are cross-cancelled before multiplying, which keeps intermediates no
+// larger than the reduced result needs.
 class Fraction {
 private:
-    int numerator;
-    int denominator;
+    struct BigParts {
+        BigInteger numerator;
+        BigInteger denominator;
+    };
 
-    // Helper function to simplify the fraction
-    void simplify();
+    long long numerator;   // inline value, used while big is null
+    long long denominator;
+    std::shared_ptr<const BigParts> big; // promoted value, shared between copies
+
+    // Store already-reduced parts with a positive denominator, inline when they fit
+    void setReduced(__int128 num, __int128 den);
+    void setReduced(BigInteger num, BigInteger den);
+
+    template <typename Integer>
+    static Fraction fromReduced(Integer num, Integer den) {
+        Fraction result;
+        result.setReduced(std::move(num), std::move(den));
+        return result;
+    }
 
 public:
-    // Constructor
-    Fraction(int num = 0, int den = 1);
+    // Constructors
+    Fraction(long long num = 0, long long den = 1);
+    Fraction(const BigInteger& num, const BigInteger& den);
+
+    // Accessors
+    BigInteger getNumerator() const;
+    BigInteger getDenominator() const;
+    bool isPromoted() const { return big != nullptr; }
+    bool isZero() const { return !big && numerator == 0; }
+    int sign() const;
+    double toDouble() const;
 
     // Overload operators
+    Fraction operator-() const;
     Fraction operator+(const Fraction& other) const;
     Fraction operator-(const Fraction& other) const;
     Fraction operator*(const Fraction& other) const;
     Fraction operator/(const Fraction& other) const;
+    Fraction& operator+=(const Fraction& other) { return *this = *this + other; }
+    Fraction& operator-=(const Fraction& other) { return *this = *this - other; }
+    Fraction& operator*=(const Fraction& other) { return *this = *this * other; }
+    Fraction& operator/=(const Fraction& other) { return *this = *this / other; }
     bool operator==(const Fraction& other) const;
+    bool operator!=(const Fraction& other) const { return !(*this == other); }
+    bool operator<(const Fraction& other) const { return compare(*this, other) < 0; }
+
+    // Negative, zero or positive as a <, == or > b
+    static int compare(const Fraction& a, const Fraction& b);
 
     // Friend function for output
     friend std::ostream& operator<<(std::ostream& out, const Fraction& fraction);
@@ -0,0 +1,202 @@
+#include "Gemm.h"
+#include "AlignedAllocator.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GEMM_HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace gemm {
+
+namespace {
+
+// Register block (micro-tile) and cache block sizes. A kc x NR sliver of B stays in L1,
+// an MC x KC block of A in L2 and a KC x NC panel of B in L3.
+constexpr int MR = 4;
+constexpr int NR = 8;
+constexpr int MC = 96;
+constexpr int KC = 256;
+constexpr int NC = 2048;
+
+// Below this many multiply-adds the packing overhead outweighs the blocked kernel.
+constexpr long long SMALL_PROBLEM = 48LL * 48 * 48;
+
+using MicroKernel = void (*)(int kc, const double* ap, const double* bp,
+                             double* c, std::size_t ldc, int mr, int nr);
+
+// Copy an mc x kc block of A into MR-row slivers, zero-padding the last sliver.
+void packA(int mc, int kc, const double* a, std::size_t lda, double* out) {
+    for (int i = 0; i < mc; i += MR) {
+        int rowsLeft = std::min(MR, mc - i);
+        for (int p = 0; p < kc; p++) {
+            for (int r = 0; r < MR; r++)
+                *out++ = r < rowsLeft ? a[(i + r) * lda + p] : 0.0;
+        }
+    }
+}
+
+// Copy a kc x nc panel of B into NR-column slivers, zero-padding the last sliver.
+void packB(int kc, int nc, const double* b, std::size_t ldb, double* out) {
+    for (int j = 0; j < nc; j += NR) {
+        int colsLeft = std::min(NR, nc - j);
+        for (int p = 0; p < kc; p++) {
+            const double* row = b + p * ldb + j;
+            for (int c = 0; c < NR; c++)
+                *out++ = c < colsLeft ? row[c] : 0.0;
+        }
+    }
+}
+
+// Add an MR x NR accumulator tile into C, clipped to the valid mr x nr corner.
+void storeTile(const double (&acc)[MR][NR], double* c, std::size_t ldc, int mr, int nr) {
+    for (int i = 0; i < mr; i++)
+        for (int j = 0; j < nr; j++)
+            c[i * ldc + j] += acc[i][j];
+}
+
+// Portable micro-kernel; the fixed-size accumulator is vectorized by the compiler.
+void microKernelGeneric(int kc, const double* ap, const double* bp,
+                        double* c, std::size_t ldc, int mr, int nr) {
+    double acc[MR][NR] = {};
+    for (int p = 0; p < kc; p++) {
+        for (int i = 0; i < MR; i++) {
+            double av = ap[i];
+            for (int j = 0; j < NR; j++)
+                acc[i][j] += av * bp[j];
+        }
+        ap += MR;
+        bp += NR;
+    }
+    storeTile(acc, c, ldc, mr, nr);
+}
+
+#ifdef GEMM_HAVE_X86_DISPATCH
+// AVX2/FMA micro-kernel: the 4x8 tile lives in eight ymm registers for the whole k loop.
+__attribute__((target("avx2,fma")))
+void microKernelAvx2(int kc, const double* ap, const double* bp,
+                     double* c, std::size_t ldc, int mr, int nr) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for (int p = 0; p < kc; p++) {
+        __m256d b0 = _mm256_load_pd(bp);
+        __m256d b1 = _mm256_load_pd(bp + 4);
+        __m256d a = _mm256_broadcast_sd(ap);
+        c00 = _mm256_fmadd_pd(a, b0, c00);
+        c01 = _mm256_fmadd_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(ap + 1);
+        c10 = _mm256_fmadd_pd(a, b0, c10);
+        c11 = _mm256_fmadd_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(ap + 2);
+        c20 = _mm256_fmadd_pd(a, b0, c20);
+        c21 = _mm256_fmadd_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(ap + 3);
+        c30 = _mm256_fmadd_pd(a, b0, c30);
+        c31 = _mm256_fmadd_pd(a, b1, c31);
+        ap += MR;
+        bp += NR;
+    }
+
+    if (mr == MR && nr == NR) {
+        double* r0 = c;
+        double* r1 = c + ldc;
+        double* r2 = c + 2 * ldc;
+        double* r3 = c + 3 * ldc;
+        _mm256_storeu_pd(r0, _mm256_add_pd(_mm256_loadu_pd(r0), c00));
+        _mm256_storeu_pd(r0 + 4, _mm256_add_pd(_mm256_loadu_pd(r0 + 4), c01));
+        _mm256_storeu_pd(r1, _mm256_add_pd(_mm256_loadu_pd(r1), c10));
+        _mm256_storeu_pd(r1 + 4, _mm256_add_pd(_mm256_loadu_pd(r1 + 4), c11));
+        _mm256_storeu_pd(r2, _mm256_add_pd(_mm256_loadu_pd(r2), c20));
+        _mm256_storeu_pd(r2 + 4, _mm256_add_pd(_mm256_loadu_pd(r2 + 4), c21));
+        _mm256_storeu_pd(r3, _mm256_add_pd(_mm256_loadu_pd(r3), c30));
+        _mm256_storeu_pd(r3 + 4, _mm256_add_pd(_mm256_loadu_pd(r3 + 4), c31));
+        return;
+    }
+
+    alignas(32) double acc[MR][NR];
+    _mm256_store_pd(acc[0], c00);
+    _mm256_store_pd(acc[0] + 4, c01);
+    _mm256_store_pd(acc[1], c10);
+    _mm256_store_pd(acc[1] + 4, c11);
+    _mm256_store_pd(acc[2], c20);
+    _mm256_store_pd(acc[2] + 4, c21);
+    _mm256_store_pd(acc[3], c30);
+    _mm256_store_pd(acc[3] + 4, c31);
+    storeTile(acc, c, ldc, mr, nr);
+}
+#endif
+
+MicroKernel selectMicroKernel() {
+#ifdef GEMM_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return microKernelAvx2;
+#endif
+    return microKernelGeneric;
+}
+
+} // namespace
+
+void multiplyAddNaive(int m, int n, int k,
+                      const double* a, std::size_t lda,
+                      const double* b, std::size_t ldb,
+                      double* c, std::size_t ldc) {
+    for (int i = 0; i < m; i++) {
+        double* cRow = c + i * ldc;
+        for (int p = 0; p < k; p++) {
+            double av = a[i * lda + p];
+            const double* bRow = b + p * ldb;
+            for (int j = 0; j < n; j++)
+                cRow[j] += av * bRow[j];
+        }
+    }
+}
+
+void multiplyAdd(int m, int n, int k,
+                 const double* a, std::size_t lda,
+                 const double* b, std::size_t ldb,
+                 double* c, std::size_t ldc) {
+    if (m <= 0 || n <= 0 || k <= 0)
+        return;
+    if (static_cast<long long>(m) * n * k <= SMALL_PROBLEM) {
+        multiplyAddNaive(m, n, k, a, lda, b, ldb, c, ldc);
+        return;
+    }
+
+    static const MicroKernel kernel = selectMicroKernel();
+
+    // Packing buffers are per thread so concurrent multiplies never share them.
+    thread_local AlignedVector<double> packedA;
+    thread_local AlignedVector<double> packedB;
+    packedA.resize(static_cast<std::size_t>(MC + MR) * KC);
+    packedB.resize(static_cast<std::size_t>(KC) * (NC + NR));
+
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = std::min(NC, n - jc);
+        for (int pc = 0; pc < k; pc += KC) {
+            int kc = std::min(KC, k - pc);
+            packB(kc, nc, b + pc * ldb + jc, ldb, packedB.data());
+
+            for (int ic = 0; ic < m; ic += MC) {
+                int mc = std::min(MC, m - ic);
+                packA(mc, kc, a + ic * lda + pc, lda, packedA.data());
+
+                for (int jr = 0; jr < nc; jr += NR) {
+                    int nr = std::min(NR, nc - jr);
+                    const double* bp = packedB.data() + static_cast<std::size_t>(jr) * kc;
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        int mr = std::min(MR, mc - ir);
+                        const double* ap = packedA.data() + static_cast<std::size_t>(ir) * kc;
+                        double* cTile = c + (ic + ir) * ldc + jc + jr;
+                        kernel(kc, ap, bp, cTile, ldc, mr, nr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace gemm
@@ -0,0 +1,25 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <cstddef>
+
+// Dense double-precision matrix multiply kernels shared by Matrix and the other
+// dense containers. All operands are row-major with an explicit leading dimension
+// (distance in elements between the starts of consecutive rows).
+namespace gemm {
+
+// C += A * B, where A is m x k, B is k x n and C is m x n.
+void multiplyAdd(int m, int n, int k,
+                 const double* a, std::size_t lda,
+                 const double* b, std::size_t ldb,
+                 double* c, std::size_t ldc);
+
+// Reference i-k-j triple loop, kept for verification and small problems.
+void multiplyAddNaive(int m, int n, int k,
+                      const double* a, std::size_t lda,
+                      const double* b, std::size_t ldb,
+                      double* c, std::size_t ldc);
+
+} // namespace gemm
+
+#endif // GEMM_H
@@ -0,0 +1,69 @@
+#include "GenericMatrix.h"
+
+namespace bareiss {
+
+int eliminate(std::vector<BigInteger>& a, int rows, int cols, int pivotCols, int& sign) {
+    auto at = [&](int i, int j) -> BigInteger& { return a[static_cast<std::size_t>(i) * cols + j]; };
+    sign = 1;
+    BigInteger previous(1);
+    int pivotRow = 0;
+    for (int col = 0; col < pivotCols && pivotRow < rows; col++) {
+        int pivot = pivotRow;
+        while (pivot < rows && at(pivot, col).isZero())
+            pivot++;
+        if (pivot == rows)
+            continue;
+        if (pivot != pivotRow) {
+            for (int j = 0; j < cols; j++)
+                std::swap(at(pivot, j), at(pivotRow, j));
+            sign = -sign;
+        }
+
+        const BigInteger p = at(pivotRow, col);
+        const bool unitPrevious = previous == BigInteger(1);
+        BigInteger t;
+        for (int i = pivotRow + 1; i < rows; i++) {
+            const BigInteger factor = std::move(at(i, col));
+            at(i, col) = BigInteger();
+            for (int j = col + 1; j < cols; j++) {
+                BigInteger& entry = at(i, j);
+                entry *= p;
+                if (!factor.isZero()) {
+                    t = factor;
+                    t *= at(pivotRow, j);
+                    entry -= t;
+                }
+                if (!unitPrevious)
+                    entry /= previous;
+            }
+        }
+        previous = p;
+        pivotRow++;
+    }
+    return pivotRow;
+}
+
+// With d = det of the eliminated A, y = d X is integral (it is adj(A) B), and
+//     a[i][i] y[i] = d b[i] - sum_{j > i} a[i][j] y[j]
+// divides exactly
+BigInteger backSubstitute(const std::vector<BigInteger>& a, int n, int cols, std::vector<BigInteger>& y) {
+    auto at = [&](int i, int j) -> const BigInteger& { return a[static_cast<std::size_t>(i) * cols + j]; };
+    const int m = cols - n;
+    const BigInteger& d = at(n - 1, n - 1);
+    y.assign(static_cast<std::size_t>(n) * m, BigInteger());
+    BigInteger t;
+    for (int c = 0; c < m; c++) {
+        for (int i = n - 1; i >= 0; i--) {
+            BigInteger sum = d * at(i, n + c);
+            for (int j = i + 1; j < n; j++) {
+                t = at(i, j);
+                t *= y[static_cast<std::size_t>(j) * m + c];
+                sum -= t;
+            }
+            y[static_cast<std::size_t>(i) * m + c] = sum / at(i, i);
+        }
+    }
+    return d;
+}
+
+} // namespace bareiss
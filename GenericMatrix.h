@@ -0,0 +1,391 @@
+#ifndef GENERIC_MATRIX_H
+#define GENERIC_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BigInteger.h"
+#include "Complex.h"
+#include "Fraction.h"
+#include "Matrix.h"
+
+// Fraction-free Gaussian elimination on integers. Reduces the rows x cols row-major
+// matrix `a` to row echelon form, choosing pivots among the first pivotCols columns
+// and applying each row operation to all columns, with Bareiss's update
+//     a[i][j] = (a[p][c] a[i][j] - a[i][c] a[p][j]) / previous pivot.
+// The division is exact, every entry stays a minor of the input, and the last pivot of
+// a square matrix is its determinant. Returns the rank; sign receives the parity of
+// the row swaps.
+namespace bareiss {
+
+int eliminate(std::vector<BigInteger>& a, int rows, int cols, int pivotCols, int& sign);
+
+// Back substitution on the eliminated [A | B] of a nonsingular n x n A, kept integral:
+// fills the n x (cols - n) row-major y with X = y / d and returns d, the last pivot.
+BigInteger backSubstitute(const std::vector<BigInteger>& a, int n, int cols, std::vector<BigInteger>& y);
+
+} // namespace bareiss
+
+// How elimination treats an element type. Exact types scale each row to integers and
+// run bareiss::eliminate; inexact types pivot on the largest magnitude and treat
+// entries below a scale-aware tolerance as zero, as Matrix::rowEchelon does.
+template <typename T>
+struct ScalarTraits;
+
+template <>
+struct ScalarTraits<double> {
+    static constexpr bool exact = false;
+    static double zero() { return 0.0; }
+    static double one() { return 1.0; }
+    static bool isZero(double x) { return x == 0.0; }
+    static double magnitude(double x) { return std::abs(x); }
+    static void write(std::ostream& out, double x) { out << x; }
+};
+
+template <>
+struct ScalarTraits<Complex> {
+    static constexpr bool exact = false;
+    static Complex zero() { return Complex(0.0, 0.0); }
+    static Complex one() { return Complex(1.0, 0.0); }
+    static bool isZero(const Complex& x) { return x.realPart() == 0.0 && x.imaginaryPart() == 0.0; }
+    static double magnitude(const Complex& x) { return std::hypot(x.realPart(), x.imaginaryPart()); }
+    static void write(std::ostream& out, const Complex& x) {
+        out << x.realPart() << (x.imaginaryPart() >= 0 ? "+" : "-") << std::abs(x.imaginaryPart()) << "i";
+    }
+};
+
+template <>
+struct ScalarTraits<Fraction> {
+    static constexpr bool exact = true;
+    static Fraction zero() { return Fraction(0); }
+    static Fraction one() { return Fraction(1); }
+    static bool isZero(const Fraction& x) { return x.isZero(); }
+    static double magnitude(const Fraction& x) { return std::abs(x.toDouble()); }
+    static void write(std::ostream& out, const Fraction& x) { out << x; }
+
+    // out[j] = row[j] * scale with scale the lcm of the row's denominators
+    static BigInteger toIntegers(const Fraction* row, int n, BigInteger* out) {
+        BigInteger scale(1);
+        for (int j = 0; j < n; j++) {
+            BigInteger d = row[j].getDenominator();
+            if (d != BigInteger(1))
+                scale = scale / BigInteger::gcd(scale, d) * d;
+        }
+        for (int j = 0; j < n; j++)
+            out[j] = row[j].getNumerator() * (scale / row[j].getDenominator());
+        return scale;
+    }
+
+    static Fraction fromInteger(const BigInteger& x) { return Fraction(x, BigInteger(1)); }
+    static Fraction fromRatio(const BigInteger& num, const BigInteger& den) { return Fraction(num, den); }
+};
+
+// Dense row-major matrix over any element type with ScalarTraits: double, Complex or
+// Fraction. Over Fraction, determinant(), rank() and solve() are exact: rows are
+// scaled to integers and reduced fraction-free, so no step needs a gcd and operand
+// sizes grow linearly with the dimension instead of compounding step by step.
+template <typename T>
+class GenericMatrix {
+private:
+    using Traits = ScalarTraits<T>;
+
+    std::vector<T> data;
+    int rows, cols;
+
+    T& at(int i, int j) { return data[static_cast<std::size_t>(i) * cols + j]; }
+    const T& at(int i, int j) const { return data[static_cast<std::size_t>(i) * cols + j]; }
+
+    void swapRows(int a, int b) {
+        std::swap_ranges(&at(a, 0), &at(a, 0) + cols, &at(b, 0));
+    }
+
+    // Rows scaled to integers (exact types); product receives the product of the scales
+    std::vector<BigInteger> integerRows(BigInteger& product) const {
+        std::vector<BigInteger> integers(data.size());
+        product = BigInteger(1);
+        for (int i = 0; i < rows; i++)
+            product *= Traits::toIntegers(&at(i, 0), cols, &integers[static_cast<std::size_t>(i) * cols]);
+        return integers;
+    }
+
+    // Reduce to row echelon form, choosing pivots among the first pivotCols columns
+    // and applying each row operation to all columns. Returns the rank, sets sign to
+    // the parity of the row swaps and scale to the product of the factors the rows
+    // were multiplied by (exact types only; otherwise one). For exact types the rows
+    // are the fraction-free ones of bareiss::eliminate.
+    int eliminate(int pivotCols, int& sign, T& scale) {
+        scale = Traits::one();
+        if constexpr (Traits::exact) {
+            BigInteger product;
+            std::vector<BigInteger> integers = integerRows(product);
+            int rank = bareiss::eliminate(integers, rows, cols, pivotCols, sign);
+            for (std::size_t k = 0; k < data.size(); k++)
+                data[k] = Traits::fromInteger(integers[k]);
+            scale = Traits::fromInteger(product);
+            return rank;
+        } else {
+            sign = 1;
+            double maxMagnitude = 0.0;
+            for (const T& value : data)
+                maxMagnitude = std::max(maxMagnitude, Traits::magnitude(value));
+            double tolerance = std::max(rows, cols) * maxMagnitude * std::numeric_limits<double>::epsilon();
+
+            int pivotRow = 0;
+            for (int col = 0; col < pivotCols && pivotRow < rows; col++) {
+                int pivot = pivotRow;
+                for (int i = pivotRow + 1; i < rows; i++)
+                    if (Traits::magnitude(at(i, col)) > Traits::magnitude(at(pivot, col)))
+                        pivot = i;
+                if (Traits::magnitude(at(pivot, col)) <= tolerance) {
+                    for (int i = pivotRow; i < rows; i++)
+                        at(i, col) = Traits::zero();
+                    continue;
+                }
+                if (pivot != pivotRow) {
+                    swapRows(pivot, pivotRow);
+                    sign = -sign;
+                }
+
+                const T p = at(pivotRow, col);
+                for (int i = pivotRow + 1; i < rows; i++) {
+                    const T l = at(i, col) / p;
+                    at(i, col) = Traits::zero();
+                    if (Traits::isZero(l))
+                        continue;
+                    for (int j = col + 1; j < cols; j++)
+                        at(i, j) = at(i, j) - l * at(pivotRow, j);
+                }
+                pivotRow++;
+            }
+            return pivotRow;
+        }
+    }
+
+public:
+    // Constructors: zero matrix, or nested row lists
+    GenericMatrix(int r, int c) : rows(r), cols(c) {
+        if (r < 0 || c < 0)
+            throw std::invalid_argument("Matrix dimensions must be non-negative");
+        data.assign(static_cast<std::size_t>(r) * c, Traits::zero());
+    }
+
+    GenericMatrix(std::initializer_list<std::initializer_list<T>> values)
+        : rows(static_cast<int>(values.size())), cols(values.size() ? static_cast<int>(values.begin()->size()) : 0) {
+        data.reserve(static_cast<std::size_t>(rows) * cols);
+        for (const auto& row : values) {
+            if (static_cast<int>(row.size()) != cols)
+                throw std::invalid_argument("All rows must have the same number of columns");
+            data.insert(data.end(), row.begin(), row.end());
+        }
+    }
+
+    // Conversions to and from the double-only Matrix
+    explicit GenericMatrix(const Matrix& m) : GenericMatrix(m.getRows(), m.getCols()) {
+        static_assert(std::is_same_v<T, double>, "Conversion from Matrix requires double elements");
+        for (int i = 0; i < rows; i++)
+            std::copy(m.rowData(i), m.rowData(i) + cols, &at(i, 0));
+    }
+
+    Matrix toMatrix() const {
+        static_assert(std::is_same_v<T, double>, "Conversion to Matrix requires double elements");
+        Matrix result(rows, cols);
+        for (int i = 0; i < rows; i++)
+            std::copy(&at(i, 0), &at(i, 0) + cols, result.rowData(i));
+        return result;
+    }
+
+    static GenericMatrix identity(int n) {
+        GenericMatrix result(n, n);
+        for (int i = 0; i < n; i++)
+            result.at(i, i) = Traits::one();
+        return result;
+    }
+
+    // Dimensions
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    // Unchecked element access
+    const T& operator()(int i, int j) const { return at(i, j); }
+    T& operator()(int i, int j) { return at(i, j); }
+
+    // Element setters and getters
+    void setElement(int i, int j, const T& value) {
+        if (i < 0 || i >= rows || j < 0 || j >= cols)
+            throw std::out_of_range("Index out of range");
+        at(i, j) = value;
+    }
+
+    T getElement(int i, int j) const {
+        if (i < 0 || i >= rows || j < 0 || j >= cols)
+            throw std::out_of_range("Index out of range");
+        return at(i, j);
+    }
+
+    // Matrix operations
+    GenericMatrix operator+(const GenericMatrix& other) const {
+        if (rows != other.rows || cols != other.cols)
+            throw std::invalid_argument("Matrix dimensions do not match for addition");
+        GenericMatrix result(rows, cols);
+        for (std::size_t k = 0; k < data.size(); k++)
+            result.data[k] = data[k] + other.data[k];
+        return result;
+    }
+
+    GenericMatrix operator-(const GenericMatrix& other) const {
+        if (rows != other.rows || cols != other.cols)
+            throw std::invalid_argument("Matrix dimensions do not match for subtraction");
+        GenericMatrix result(rows, cols);
+        for (std::size_t k = 0; k < data.size(); k++)
+            result.data[k] = data[k] - other.data[k];
+        return result;
+    }
+
+    GenericMatrix operator*(const T& scalar) const {
+        GenericMatrix result(rows, cols);
+        for (std::size_t k = 0; k < data.size(); k++)
+            result.data[k] = data[k] * scalar;
+        return result;
+    }
+
+    GenericMatrix operator*(const GenericMatrix& other) const {
+        if (cols != other.rows)
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+        GenericMatrix result(rows, other.cols);
+        for (int i = 0; i < rows; i++) {
+            for (int k = 0; k < cols; k++) {
+                const T& aik = at(i, k);
+                if (Traits::isZero(aik))
+                    continue;
+                for (int j = 0; j < other.cols; j++)
+                    result.at(i, j) = result.at(i, j) + aik * other.at(k, j);
+            }
+        }
+        return result;
+    }
+
+    bool operator==(const GenericMatrix& other) const {
+        return rows == other.rows && cols == other.cols && data == other.data;
+    }
+
+    bool operator!=(const GenericMatrix& other) const { return !(*this == other); }
+
+    GenericMatrix transpose() const {
+        GenericMatrix result(cols, rows);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++)
+                result.at(j, i) = at(i, j);
+        return result;
+    }
+
+    // Row echelon form. For exact types the rows are the fraction-free ones: each is
+    // the usual echelon row scaled by the pivot above it.
+    GenericMatrix rowEchelon() const {
+        GenericMatrix a(*this);
+        int sign;
+        T scale;
+        a.eliminate(cols, sign, scale);
+        return a;
+    }
+
+    // Rank: number of pivots found by elimination
+    int rank() const {
+        GenericMatrix a(*this);
+        int sign;
+        T scale;
+        return a.eliminate(cols, sign, scale);
+    }
+
+    T determinant() const {
+        if (rows != cols)
+            throw std::invalid_argument("Determinant is only defined for square matrices");
+        if (rows == 0)
+            return Traits::one();
+        GenericMatrix a(*this);
+        int sign;
+        T scale;
+        if (a.eliminate(cols, sign, scale) < rows)
+            return Traits::zero();
+        T det = Traits::one();
+        if constexpr (Traits::exact) {
+            det = a.at(rows - 1, cols - 1) / scale;
+        } else {
+            for (int i = 0; i < rows; i++)
+                det = det * a.at(i, i);
+        }
+        return sign < 0 ? Traits::zero() - det : det;
+    }
+
+    // Solve AX = B by elimination on [A | B] and back substitution
+    GenericMatrix solve(const GenericMatrix& b) const {
+        if (rows != cols || b.rows != rows)
+            throw std::invalid_argument("Matrix dimensions do not match for solve");
+        int n = rows, m = b.cols;
+        GenericMatrix augmented(n, n + m);
+        for (int i = 0; i < n; i++) {
+            std::copy(&at(i, 0), &at(i, 0) + n, &augmented.at(i, 0));
+            std::copy(&b.at(i, 0), &b.at(i, 0) + m, &augmented.at(i, n));
+        }
+        int sign;
+        GenericMatrix x(n, m);
+        if constexpr (Traits::exact) {
+            BigInteger product;
+            std::vector<BigInteger> integers = augmented.integerRows(product);
+            if (bareiss::eliminate(integers, n, n + m, n, sign) < n)
+                throw std::invalid_argument("Matrix is singular");
+            std::vector<BigInteger> y;
+            BigInteger d = bareiss::backSubstitute(integers, n, n + m, y);
+            for (std::size_t k = 0; k < y.size(); k++)
+                x.data[k] = Traits::fromRatio(y[k], d);
+        } else {
+            T scale;
+            if (augmented.eliminate(n, sign, scale) < n)
+                throw std::invalid_argument("Matrix is singular");
+            for (int c = 0; c < m; c++) {
+                for (int i = n - 1; i >= 0; i--) {
+                    T sum = augmented.at(i, n + c);
+                    for (int j = i + 1; j < n; j++)
+                        sum = sum - augmented.at(i, j) * x.at(j, c);
+                    x.at(i, c) = sum / augmented.at(i, i);
+                }
+            }
+        }
+        return x;
+    }
+
+    std::vector<T> solve(const std::vector<T>& b) const {
+        GenericMatrix column(static_cast<int>(b.size()), 1);
+        std::copy(b.begin(), b.end(), column.data.begin());
+        return solve(column).data;
+    }
+
+    GenericMatrix inverse() const {
+        if (rows != cols)
+            throw std::invalid_argument("Inverse is only defined for square matrices");
+        return solve(identity(rows));
+    }
+
+    // Display matrix
+    void display() const {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                std::cout << std::setw(8);
+                Traits::write(std::cout, at(i, j));
+                std::cout << " ";
+            }
+            std::cout << std::endl;
+        }
+    }
+};
+
+using RationalMatrix = GenericMatrix<Fraction>;
+using ComplexMatrix = GenericMatrix<Complex>;
+
+#endif // GENERIC_MATRIX_H
@@ -0,0 +1,208 @@
+#include "MappedMatrix.h"
+#include "Gemm.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[8] = {'S', 'C', 'M', 'A', 'T', 'R', 'X', '1'};
+constexpr std::size_t DATA_OFFSET = 64;
+
+static_assert(sizeof(MappedMatrix::Header) == DATA_OFFSET, "Header must fill the reserved 64 bytes");
+
+std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + ": " + path + " (" + std::strerror(errno) + ")");
+}
+
+// Page-aligned span covering [begin, begin + bytes)
+void advise(const void* begin, std::size_t bytes, int advice) {
+    static const std::uintptr_t pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(begin) & ~(pageSize - 1);
+    std::uintptr_t end = reinterpret_cast<std::uintptr_t>(begin) + bytes;
+    if (end > start)
+        madvise(reinterpret_cast<void*>(start), end - start, advice);
+}
+
+void syncRange(const void* begin, std::size_t bytes) {
+    static const std::uintptr_t pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(begin) & ~(pageSize - 1);
+    std::uintptr_t end = reinterpret_cast<std::uintptr_t>(begin) + bytes;
+    if (end > start)
+        msync(reinterpret_cast<void*>(start), end - start, MS_ASYNC);
+}
+
+} // namespace
+
+// Map an existing file
+MappedMatrix::MappedMatrix(const std::string& path) : MappedMatrix(path, false) {}
+
+MappedMatrix::MappedMatrix(const std::string& path, bool write)
+    : rows(0), cols(0), stride(0), mapping(nullptr), mappingSize(0), elements(nullptr), writable(write) {
+    int fd = ::open(path.c_str(), write ? O_RDWR : O_RDONLY);
+    if (fd < 0)
+        throw ioError("Cannot open matrix file", path);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw ioError("Cannot stat matrix file", path);
+    }
+    mappingSize = static_cast<std::size_t>(info.st_size);
+    if (mappingSize < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Matrix file is too small: " + path);
+    }
+
+    int protection = write ? PROT_READ | PROT_WRITE : PROT_READ;
+    mapping = mmap(nullptr, mappingSize, protection, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw ioError("Cannot map matrix file", path);
+    }
+
+    Header header;
+    std::memcpy(&header, mapping, sizeof(header));
+    const std::uint64_t maxDim = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+        && header.rows <= maxDim && header.cols <= maxDim
+        && header.stride >= header.cols
+        && header.dataOffset >= sizeof(Header) && header.dataOffset % sizeof(double) == 0
+        && header.dataOffset <= mappingSize
+        && (header.stride == 0 || header.rows <= (mappingSize - header.dataOffset) / sizeof(double) / header.stride);
+    if (!valid) {
+        release();
+        throw std::runtime_error("Invalid matrix file: " + path);
+    }
+
+    rows = static_cast<int>(header.rows);
+    cols = static_cast<int>(header.cols);
+    stride = static_cast<std::size_t>(header.stride);
+    elements = reinterpret_cast<double*>(static_cast<char*>(mapping) + header.dataOffset);
+}
+
+// Create a zero-filled file of the given shape
+MappedMatrix MappedMatrix::create(const std::string& path, int rows, int cols) {
+    if (rows < 0 || cols < 0)
+        throw std::invalid_argument("Matrix dimensions must be non-negative");
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw ioError("Cannot create matrix file", path);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.rows = static_cast<std::uint64_t>(rows);
+    header.cols = static_cast<std::uint64_t>(cols);
+    header.stride = static_cast<std::uint64_t>(cols);
+    header.dataOffset = DATA_OFFSET;
+
+    off_t size = static_cast<off_t>(DATA_OFFSET + static_cast<std::size_t>(rows) * cols * sizeof(double));
+    bool ok = ftruncate(fd, size) == 0
+        && pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    ::close(fd);
+    if (!ok)
+        throw ioError("Cannot write matrix file", path);
+
+    return MappedMatrix(path, true);
+}
+
+// Write a Matrix to disk
+void MappedMatrix::save(const Matrix& m, const std::string& path) {
+    MappedMatrix file = create(path, m.getRows(), m.getCols());
+    for (int i = 0; i < m.getRows(); i++)
+        std::copy(m.rowData(i), m.rowData(i) + m.getCols(), file.mutableRowData(i));
+    file.flush();
+}
+
+// Out-of-core product, one band of output rows at a time
+MappedMatrix MappedMatrix::multiply(const MappedMatrix& a, const MappedMatrix& b,
+                                    const std::string& outPath, int tileSize) {
+    if (a.cols != b.rows)
+        throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+    if (tileSize <= 0)
+        throw std::invalid_argument("Tile size must be positive");
+
+    MappedMatrix c = create(outPath, a.rows, b.cols);
+    int colTiles = (b.cols + tileSize - 1) / tileSize;
+
+    for (int i0 = 0; i0 < a.rows; i0 += tileSize) {
+        int m = std::min(tileSize, a.rows - i0);
+        ThreadPool::instance().parallelFor(colTiles, [&](int t) {
+            int j0 = t * tileSize;
+            int n = std::min(tileSize, b.cols - j0);
+            for (int k0 = 0; k0 < a.cols; k0 += tileSize) {
+                int k = std::min(tileSize, a.cols - k0);
+                gemm::multiplyAdd(m, n, k,
+                                  a.rowData(i0) + k0, a.stride,
+                                  b.rowData(k0) + j0, b.stride,
+                                  c.elements + i0 * c.stride + j0, c.stride);
+            }
+        });
+
+        // The band of A is not needed again; the band of C can be written back
+        advise(a.rowData(i0), m * a.stride * sizeof(double), MADV_DONTNEED);
+        syncRange(c.rowData(i0), m * c.stride * sizeof(double));
+    }
+    return c;
+}
+
+MappedMatrix::MappedMatrix(MappedMatrix&& other) noexcept
+    : rows(other.rows), cols(other.cols), stride(other.stride), mapping(other.mapping),
+      mappingSize(other.mappingSize), elements(other.elements), writable(other.writable) {
+    other.mapping = nullptr;
+    other.elements = nullptr;
+}
+
+MappedMatrix& MappedMatrix::operator=(MappedMatrix&& other) noexcept {
+    if (this != &other) {
+        release();
+        rows = other.rows;
+        cols = other.cols;
+        stride = other.stride;
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+        elements = other.elements;
+        writable = other.writable;
+        other.mapping = nullptr;
+        other.elements = nullptr;
+    }
+    return *this;
+}
+
+MappedMatrix::~MappedMatrix() {
+    release();
+}
+
+void MappedMatrix::release() {
+    if (mapping)
+        munmap(mapping, mappingSize);
+    mapping = nullptr;
+    elements = nullptr;
+}
+
+// Element access
+double MappedMatrix::getElement(int i, int j) const {
+    if (i < 0 || i >= rows || j < 0 || j >= cols)
+        throw std::out_of_range("Index out of range");
+    return elements[i * stride + j];
+}
+
+double* MappedMatrix::mutableRowData(int i) {
+    if (!writable)
+        throw std::logic_error("Matrix file is mapped read-only");
+    return elements + i * stride;
+}
+
+void MappedMatrix::flush() const {
+    if (writable && mapping)
+        msync(mapping, mappingSize, MS_SYNC);
+}
@@ -0,0 +1,90 @@
+#ifndef MAPPED_MATRIX_H
+#define MAPPED_MATRIX_H
+
+#include <cstdint>
+#include <string>
+#include "Matrix.h"
+
+// Matrix stored in a binary file and accessed through a memory mapping, so matrices
+// larger than RAM can be read and multiplied without loading them.
+//
+// File format (native endianness): a 64-byte header
+//     char     magic[8]    "SCMATRX1"
+//     uint64_t rows
+//     uint64_t cols
+//     uint64_t stride      doubles between the starts of consecutive rows (>= cols)
+//     uint64_t dataOffset  byte offset of the first element (64)
+//     (zero padding to 64 bytes)
+// followed by rows * stride row-major doubles.
+//
+// A MappedMatrix is a matrix expression, so it can be used directly in Matrix
+// arithmetic or copied into a Matrix. Requires POSIX mmap.
+class MappedMatrix : public MatrixExpr<MappedMatrix> {
+private:
+    int rows, cols;
+    std::size_t stride;
+    void* mapping;
+    std::size_t mappingSize;
+    double* elements;
+    bool writable;
+
+    MappedMatrix(const std::string& path, bool write);
+    void release();
+
+public:
+    struct Header {
+        char magic[8];
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t stride;
+        std::uint64_t dataOffset;
+        std::uint64_t reserved[3];
+    };
+
+    // Map an existing file read-only
+    explicit MappedMatrix(const std::string& path);
+
+    // Create a zero-filled rows x cols file and map it read-write
+    static MappedMatrix create(const std::string& path, int rows, int cols);
+
+    // Write a Matrix to a file in this format
+    static void save(const Matrix& m, const std::string& path);
+
+    // Streaming product C = A * B into a new file at outPath. Works through
+    // tileSize x tileSize blocks so only a few tiles of each operand are resident at a
+    // time; output row bands are flushed and input pages released as it goes.
+    static MappedMatrix multiply(const MappedMatrix& a, const MappedMatrix& b,
+                                 const std::string& outPath, int tileSize = 1024);
+
+    MappedMatrix(MappedMatrix&& other) noexcept;
+    MappedMatrix& operator=(MappedMatrix&& other) noexcept;
+    MappedMatrix(const MappedMatrix&) = delete;
+    MappedMatrix& operator=(const MappedMatrix&) = delete;
+    ~MappedMatrix();
+
+    // Dimensions
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    std::size_t getStride() const { return stride; }
+
+    // Element access
+    double getElement(int i, int j) const;
+    const double* rowData(int i) const { return elements + i * stride; }
+    double* mutableRowData(int i);
+
+    // Flush modified pages of a writable mapping to the file
+    void flush() const;
+
+    // Expression-template hooks
+    double operator()(int i, int j) const { return elements[i * stride + j]; }
+    bool references(const Matrix*) const { return false; }
+    bool transposedAlias(const Matrix*) const { return false; }
+};
+
+// Mapped matrices are held by reference inside expressions, like Matrix
+template <>
+struct MatrixExprStorage<MappedMatrix> {
+    using type = const MappedMatrix&;
+};
+
+#endif // MAPPED_MATRIX_H
@@ -0,0 +1,936 @@
+#include "MathKernels.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATHKERNELS_HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace mathkernels {
+
+namespace {
+
+// Arrays at least this long are split into tasks of TASK_VALUES values
+constexpr std::size_t PARALLEL_VALUES = std::size_t(1) << 16;
+constexpr std::size_t TASK_VALUES = std::size_t(1) << 14;
+
+enum Function { SIN, COS, TAN, EXP, LOG, LOG2, LOG10, SINH, COSH, TANH, FUNCTIONS };
+
+using Unary = void (*)(const double* x, double* out, std::size_t n);
+// y advances by yStride per value: 1 for an array of exponents, 0 for a single one
+using Binary = void (*)(const double* x, const double* y, std::size_t yStride, double* out, std::size_t n);
+
+// Reduction constants (fdlibm). ln(2) and pi/2 are split into pieces with trailing
+// zero bits, so multiplying a piece by a small integer k is exact.
+constexpr double LOG2_E = 1.44269504088896338700e+00;
+constexpr double LN2_HI = 6.93147180369123816490e-01;
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+constexpr double PIO2_1 = 1.57079632673412561417e+00;
+constexpr double PIO2_2 = 6.07710050630396597660e-11;
+constexpr double PIO2_2T = 2.02226624879595063154e-21;
+constexpr double PIO2_3 = 2.02226624871116645580e-21;
+constexpr double PIO2_3T = 8.47842766036889956997e-32;
+
+// The trigonometric kernels reduce |x| <= TRIG_LIMIT, so k = round(2x / pi) < 2^20
+constexpr double TRIG_LIMIT = 0x1p20;
+// Below this, sin(x) and tan(x) round to x
+constexpr double TRIG_TINY = 0x1p-26;
+// Largest |x| whose exp(x) and exp(-x) stay normal
+constexpr double EXP_LIMIT = 708.0;
+
+// Polynomial coefficients, highest degree first.
+// exp(r) = 1 + r + r^2 Q(r) on |r| <= ln(2)/2: Taylor to r^14 (accurate), r^10 (fast)
+constexpr double EXP_ACCURATE[] = {
+    1.0 / 87178291200, 1.0 / 6227020800, 1.0 / 479001600, 1.0 / 39916800, 1.0 / 3628800,
+    1.0 / 362880, 1.0 / 40320, 1.0 / 5040, 1.0 / 720, 1.0 / 120, 1.0 / 24, 1.0 / 6, 0.5};
+constexpr double EXP_FAST[] = {
+    1.0 / 3628800, 1.0 / 362880, 1.0 / 40320, 1.0 / 5040, 1.0 / 720, 1.0 / 120, 1.0 / 24,
+    1.0 / 6, 0.5, 1.0, 1.0};
+
+// sinh(x) - x and cosh(x) - 1 on |x| < 1/2 as x^3 P(x^2) and x^2 P(x^2)
+constexpr double SINH_ACCURATE[] = {
+    1.0 / 1307674368000, 1.0 / 6227020800, 1.0 / 39916800, 1.0 / 362880, 1.0 / 5040, 1.0 / 120, 1.0 / 6};
+constexpr double SINH_FAST[] = {1.0 / 39916800, 1.0 / 362880, 1.0 / 5040, 1.0 / 120, 1.0 / 6};
+constexpr double COSH_ACCURATE[] = {
+    1.0 / 20922789888000, 1.0 / 87178291200, 1.0 / 479001600, 1.0 / 3628800, 1.0 / 40320,
+    1.0 / 720, 1.0 / 24, 0.5};
+constexpr double COSH_FAST[] = {1.0 / 479001600, 1.0 / 3628800, 1.0 / 40320, 1.0 / 720, 1.0 / 24, 0.5};
+
+// log1p(r) - r + r^2/2 = r^3 P(r) on |r| < 2^-7
+constexpr double LOG1P_TAIL[] = {-1.0 / 10, 1.0 / 9, -1.0 / 8, 1.0 / 7, -1.0 / 6, 1.0 / 5, -1.0 / 4, 1.0 / 3};
+
+// fdlibm's log kernel: log(1 + f) = f - f^2/2 + s (f^2/2 + R(s^2)) with s = f / (2 + f)
+constexpr double LG1 = 6.666666666666735130e-01;
+constexpr double LG2 = 3.999999999940941908e-01;
+constexpr double LG3 = 2.857142874366239149e-01;
+constexpr double LG4 = 2.222219843214978396e-01;
+constexpr double LG5 = 1.818357216161805012e-01;
+constexpr double LG6 = 1.531383769920937332e-01;
+constexpr double LG7 = 1.479819860511658591e-01;
+// 1/ln(2), 1/ln(10) and log10(2) split as in FreeBSD's e_log2.c and e_log10.c
+constexpr double INV_LN2_HI = 1.44269504072144627571e+00;
+constexpr double INV_LN2_LO = 1.67517131648865118353e-10;
+constexpr double INV_LN10_HI = 4.34294481878168880939e-01;
+constexpr double INV_LN10_LO = 2.50829467116452752298e-11;
+constexpr double LOG10_2_HI = 3.01029995663611771306e-01;
+constexpr double LOG10_2_LO = 3.69423907715893078616e-13;
+
+// fdlibm's sin and cos kernels on |r| <= pi/4
+constexpr double S1 = -1.66666666666666324348e-01;
+constexpr double S2 = 8.33333333332248946124e-03;
+constexpr double S3 = -1.98412698298579493134e-04;
+constexpr double S4 = 2.75573137070700676789e-06;
+constexpr double S5 = -2.50507602534068634195e-08;
+constexpr double S6 = 1.58969099521155010221e-10;
+constexpr double C1 = 4.16666666666666019037e-02;
+constexpr double C2 = -1.38888888888741095749e-03;
+constexpr double C3 = 2.48015872894767294178e-05;
+constexpr double C4 = -2.75573143513906633035e-07;
+constexpr double C5 = 2.08757232129817482790e-09;
+constexpr double C6 = -1.13596475577881948265e-11;
+
+// Table for the double-double logarithm in pow. The bits of x minus LOG_TABLE_OFFSET
+// select one of 128 subintervals of [0x1.6955p-1, 0x1.6955p+0); entry i holds
+// invc ~ 1/c for the subinterval's midpoint c, and log(1/invc) = logc + logcTail to
+// double-double precision. The subinterval containing 1 has invc = 1 exactly, so
+// log(x) keeps full relative accuracy near x = 1.
+constexpr std::uint64_t LOG_TABLE_OFFSET = 0x3fe6955500000000;
+constexpr int LOG_TABLE_BITS = 7;
+
+alignas(64) constexpr double LOG_INVC[1 << LOG_TABLE_BITS] = {
+    0x1.69be8c81fb00cp+0, 0x1.67c22fe4dcddap+0, 0x1.65cb6049c63c4p+0,
+    0x1.63da068aeb033p+0, 0x1.61ee0c0281abbp+0, 0x1.60075a87531dbp+0,
+    0x1.5e25dc6966c26p+0, 0x1.5c497c6ec9c1ap+0, 0x1.5a7225d070680p+0,
+    0x1.589fc43730bf1p+0, 0x1.56d243b8d56c2p+0, 0x1.550990d547f30p+0,
+    0x1.53459873d182dp+0, 0x1.518647e0717edp+0, 0x1.4fcb8cc948f96p+0,
+    0x1.4e15553c1a639p+0, 0x1.4c638fa3dcb8ep+0, 0x1.4ab62ac66176cp+0,
+    0x1.490d15c20cb76p+0, 0x1.4768400b9ecd3p+0, 0x1.45c7996c0ec27p+0,
+    0x1.442b11fe75285p+0, 0x1.42929a2e06a4dp+0, 0x1.40fe22b41db5ep+0,
+    0x1.3f6d9c965323ep+0, 0x1.3de0f924a4a53p+0, 0x1.3c5829f7a9375p+0,
+    0x1.3ad320eed2b70p+0, 0x1.3951d02ebc479p+0, 0x1.37d42a1f851a3p+0,
+    0x1.365a216b372dap+0, 0x1.34e3a8fc39a0ap+0, 0x1.3370b3fbce360p+0,
+    0x1.320135d099ac2p+0, 0x1.3095221d368ecp+0, 0x1.2f2c6cbed22b0p+0,
+    0x1.2dc709cbd3534p+0, 0x1.2c64ed928aa10p+0, 0x1.2b060c97ebe82p+0,
+    0x1.29aa5b9650907p+0, 0x1.2851cf7c428cdp+0, 0x1.26fc5d6b4fab4p+0,
+    0x1.25a9fab6e4facp+0, 0x1.245a9ce332056p+0, 0x1.230e39a413a1bp+0,
+    0x1.21c4c6dc061e2p+0, 0x1.207e3a9b1e8d3p+0, 0x1.1f3a8b1e0af9dp+0,
+    0x1.1df9aecd194e9p+0, 0x1.1cbb9c3b44badp+0, 0x1.1b804a2549645p+0,
+    0x1.1a47af70be33ap+0, 0x1.1911c32b348dcp+0, 0x1.17de7c895dcc0p+0,
+    0x1.16add2e63647fp+0, 0x1.157fbdc235cffp+0, 0x1.145434c2855c5p+0,
+    0x1.132b2fb039dc6p+0, 0x1.1204a67793f6ap+0, 0x1.10e0912744966p+0,
+    0x1.0fbee7efb622ep+0, 0x1.0e9fa3225a3e1p+0, 0x1.0d82bb30fbe96p+0,
+    0x1.0c6828ad15f01p+0, 0x1.0b4fe4472d780p+0, 0x1.0a39e6ce309acp+0,
+    0x1.0926292ed8e9ep+0, 0x1.0814a47311c1ap+0, 0x1.070551c1624f2p+0,
+    0x1.05f82a5c5b2f9p+0, 0x1.04ed27a2078e3p+0, 0x1.03e4430b61a92p+0,
+    0x1.02dd762bcaa3fp+0, 0x1.01d8bab085916p+0, 0x1.00d60a60359dbp+0,
+    0x1.0000000000000p+0, 0x1.fb602a2f91e1fp-1, 0x1.f77a4dd695191p-1,
+    0x1.f3a3a89273f9ep-1, 0x1.efdbe1f975defp-1, 0x1.ec22a449beb96p-1,
+    0x1.e8779c4ff8ee3p-1, 0x1.e4da794f1f1e5p-1, 0x1.e14aece9570c6p-1,
+    0x1.ddc8ab09cfb09p-1, 0x1.da5369cf9557bp-1, 0x1.d6eae1794f6f3p-1,
+    0x1.d38ecc51dc50bp-1, 0x1.d03ee69dc00cap-1, 0x1.ccfaee895bcefp-1,
+    0x1.c9c2a417e40ffp-1, 0x1.c695c9130c4d5p-1, 0x1.c37420fb5f8a6p-1,
+    0x1.c05d70f93d515p-1, 0x1.bd517fce73629p-1, 0x1.ba5015c86caaap-1,
+    0x1.b758fcb2ee7e3p-1, 0x1.b46bffcb5d798p-1, 0x1.b188ebb483bc1p-1,
+    0x1.aeaf8e6ad28c6p-1, 0x1.abdfb73919c0fp-1, 0x1.a91936adaf945p-1,
+    0x1.a65bde9003d33p-1, 0x1.a3a781d69993ap-1, 0x1.a0fbf49d62e51p-1,
+    0x1.9e590c1c7a228p-1, 0x1.9bbe9e9f34c91p-1, 0x1.992c837b8be99p-1,
+    0x1.96a29309d67c9p-1, 0x1.9420a69cd210dp-1, 0x1.91a69879f676ap-1,
+    0x1.8f3443d211372p-1, 0x1.8cc984ba25cabp-1, 0x1.8a6638248faa5p-1,
+    0x1.880a3bda6379bp-1, 0x1.85b56e750ca95p-1, 0x1.8367af582510cp-1,
+    0x1.8120deab841dcp-1, 0x1.7ee0dd558352dp-1, 0x1.7ca78cf575ea8p-1,
+    0x1.7a74cfde518dap-1, 0x1.7848891186241p-1, 0x1.76229c3a02dd9p-1,
+    0x1.7402eda766a7bp-1, 0x1.71e962495a585p-1, 0x1.6fd5dfab12e9ep-1,
+    0x1.6dc84beefa396p-1, 0x1.6bc08dca7cc53p-1
+};
+
+alignas(64) constexpr double LOG_LOGC[1 << LOG_TABLE_BITS] = {
+    -0x1.620ef9ac6aa7cp-2, -0x1.5c6bfa1131b89p-2, -0x1.56d0e0c69c3a3p-2,
+    -0x1.513d97c718e7ep-2, -0x1.4bb20968ac7e1p-2, -0x1.462e205af89a2p-2,
+    -0x1.40b1c7a55020fp-2, -0x1.3b3ceaa4d8c01p-2, -0x1.35cf750ab91c3p-2,
+    -0x1.306952da53478p-2, -0x1.2b0a70678b1d0p-2, -0x1.25b2ba551821cp-2,
+    -0x1.20621d92e28ddp-2, -0x1.1b18875c6b297p-2, -0x1.15d5e5373da29p-2,
+    -0x1.109a24f16d0e1p-2, -0x1.0b6534a01a428p-2, -0x1.0637029e03bf8p-2,
+    -0x1.010f7d8a1ed9dp-2, -0x1.f7dd288c73c7dp-3, -0x1.eda86beb4e196p-3,
+    -0x1.e380a3f7df699p-3, -0x1.d965aff71ff0bp-3, -0x1.cf576fa97461cp-3,
+    -0x1.c555c34844615p-3, -0x1.bb608b83a0031p-3, -0x1.b177a97ff3db0p-3,
+    -0x1.a79afed3cb32dp-3, -0x1.9dca6d85a004bp-3, -0x1.9405d809b84c5p-3,
+    -0x1.8a4d214010533p-3, -0x1.80a02c7251993p-3, -0x1.76fedd51d5fd8p-3,
+    -0x1.6d6917f5b6cd2p-3, -0x1.63dec0d8e7691p-3, -0x1.5a5fbcd85b285p-3,
+    -0x1.50ebf131362fbp-3, -0x1.4783437f08e8dp-3, -0x1.3e2599ba15d49p-3,
+    -0x1.34d2da35a16f4p-3, -0x1.2b8aeb9e4bdbdp-3, -0x1.224db4f87417bp-3,
+    -0x1.191b1d9ea4760p-3, -0x1.0ff30d40081afp-3, -0x1.06d56bdee9439p-3,
+    -0x1.fb84439e702d1p-4, -0x1.e9722f6a33913p-4, -0x1.d7746d06ffb25p-4,
+    -0x1.c58acef58e68fp-4, -0x1.b3b5284ebe043p-4, -0x1.a1f34cc0ede39p-4,
+    -0x1.9045108d699c6p-4, -0x1.7eaa4885e25e2p-4, -0x1.6d22ca09f61fap-4,
+    -0x1.5bae6b04c452ep-4, -0x1.4a4d01ea8fb65p-4, -0x1.38fe65b66cfb2p-4,
+    -0x1.27c26de7fddc6p-4, -0x1.1698f281386bap-4, -0x1.0581cc043a393p-4,
+    -0x1.e8f9a6e24e118p-5, -0x1.c713c48825a49p-5, -0x1.a551a4e5ed89ep-5,
+    -0x1.83b2fcd762045p-5, -0x1.623782241da36p-5, -0x1.40deeb7bc2178p-5,
+    -0x1.1fa8f07234fb2p-5, -0x1.fd2a92f7e0072p-6, -0x1.bb475fd4c8618p-6,
+    -0x1.79a7bbd0df0e5p-6, -0x1.384b1cedc9a50p-6, -0x1.ee61f5a49475bp-7,
+    -0x1.6cb19d87294d0p-7, -0x1.d7084e7b15da2p-8, -0x1.ab622e93ce64bp-9,
+    0x0p+0, 0x1.294daebc01564p-7, 0x1.1301d448a0b00p-6,
+    0x1.906542de674f9p-6, 0x1.066a72e47273fp-5, 0x1.442a34f660bdep-5,
+    0x1.8173b38841751p-5, 0x1.be48b03e90f71p-5, 0x1.faaae2cc5a017p-5,
+    0x1.1b4dfc9edb27fp-4, 0x1.390ecc1fcd474p-4, 0x1.5698adb285bd4p-4,
+    0x1.73ec6ab4ec63cp-4, 0x1.910ac8397c5fdp-4, 0x1.adf487264f359p-4,
+    0x1.caaa645311532p-4, 0x1.e72d18a5ebb68p-4, 0x1.01beac97b6e0cp-3,
+    0x1.0fcdeba2c0e23p-3, 0x1.1dc4a04ebb231p-3, 0x1.2ba31fb292d05p-3,
+    0x1.3969bd2da2806p-3, 0x1.4718ca7371c2ap-3, 0x1.54b0979710ddcp-3,
+    0x1.6231731614b2ep-3, 0x1.6f9ba9e33686ap-3, 0x1.7cef87709b4cdp-3,
+    0x1.8a2d55b9c5e17p-3, 0x1.97555d4d3779fp-3, 0x1.a467e555c16dcp-3,
+    0x1.b16533a38b570p-3, 0x1.be4d8cb4d0662p-3, 0x1.cb2133be56a3dp-3,
+    0x1.d7e06ab3a2c25p-3, 0x1.e48b724eeafb9p-3, 0x1.f1228a18cb65ap-3,
+    0x1.fda5f06fbe011p-3, 0x1.050af147ac5e4p-2, 0x1.0b394e4ba9c08p-2,
+    0x1.115e2cc92c26ap-2, 0x1.1779a9be4fa76p-2, 0x1.1d8be1a52c67dp-2,
+    0x1.2394f076f3618p-2, 0x1.2994f1aef3d0ap-2, 0x1.2f8c004d8a1a6p-2,
+    0x1.357a36daf8f5cp-2, 0x1.3b5faf6a2d950p-2, 0x1.413c839b6f8adp-2,
+    0x1.4710cc9efd18dp-2, 0x1.4cdca33794964p-2, 0x1.52a01fbceb8f3p-2,
+    0x1.585b5a1e1438dp-2, 0x1.5e0e69e3d1d5ap-2
+};
+
+alignas(64) constexpr double LOG_LOGC_TAIL[1 << LOG_TABLE_BITS] = {
+    0x1.7d5edf2436028p-56, 0x1.5accf53e0fb97p-56, 0x1.c6ff348765107p-57,
+    0x1.dd1b3b0521ed4p-57, 0x1.b1c420e7eb68ep-56, -0x1.32656a7abcfe8p-65,
+    -0x1.da8ee8453da74p-56, -0x1.175a194083e99p-62, -0x1.3b97926470308p-56,
+    -0x1.bf85e2d1f17a3p-56, 0x1.aa5563d85c314p-56, 0x1.7ea05254c1a16p-56,
+    -0x1.1798dfe721091p-56, -0x1.0e046c50d116ep-56, -0x1.1a371bf0ea155p-56,
+    -0x1.a3c61fb6a32a4p-58, -0x1.37c1238e8b88bp-58, -0x1.42b5d01e45f31p-57,
+    0x1.0734ab1b69901p-56, -0x1.355c9ac6293ddp-57, -0x1.40ffc2a7e6d71p-59,
+    -0x1.862248039fdf5p-58, 0x1.4620b777f6583p-57, -0x1.fccfea63fc024p-57,
+    -0x1.782b790e0a62bp-57, 0x1.d9b800b01a214p-57, -0x1.a6d00bc3af246p-58,
+    0x1.6ec8f5499c79cp-57, -0x1.ed1e85911c4a0p-57, 0x1.4b038a142b56bp-58,
+    -0x1.6b818e66a5769p-59, -0x1.b4304ad16f8a7p-57, 0x1.05611f9784a98p-60,
+    -0x1.549a64c679070p-65, 0x1.be5fe31a14be8p-58, -0x1.39affd8c6a2a7p-58,
+    -0x1.ef67c0f42aa21p-57, 0x1.1ea191ada8bbfp-60, 0x1.64522fe3737adp-57,
+    -0x1.04e39c61b7e42p-57, 0x1.f68c8827b01d1p-59, 0x1.e710e8a29df01p-57,
+    -0x1.90257918c1533p-58, 0x1.4dfd3e1b3ad2ep-59, -0x1.e2c47ed4c6eccp-59,
+    0x1.b7f69d2819213p-59, 0x1.c26f521d03b6ep-59, 0x1.d56376a0acdb6p-63,
+    0x1.28c4213df87bap-59, -0x1.671a3f8312014p-58, 0x1.2b44ab64fb0e4p-58,
+    0x1.2ab01f5a5978ep-61, 0x1.b55bfcdd3c710p-59, -0x1.ebb3580d31000p-61,
+    0x1.ceb706f61e3a3p-59, -0x1.c196436ab3d12p-60, -0x1.0da207c54396ep-59,
+    -0x1.c013d13cde5e0p-59, -0x1.014614e0e096bp-61, 0x1.2a6cb9cc7a32fp-58,
+    0x1.5ba90449ac832p-59, -0x1.ee25d828e3ba6p-59, 0x1.e694e77e75d05p-59,
+    0x1.91d69959eaea5p-59, -0x1.c2ff468d1f31fp-59, -0x1.6ada9c0fbe8dep-60,
+    0x1.dd1d46a7618b3p-59, 0x1.fb21098c02293p-60, -0x1.7c8345628b32fp-63,
+    -0x1.f270f12ef5506p-66, -0x1.99710299adbd1p-60, 0x1.78ad5411fa1d5p-63,
+    0x1.bb98528ff019ep-61, 0x1.cf7a22a6fcac8p-64, 0x1.468080bd33f77p-63,
+    0x0p+0, 0x1.4ba451f8ac5a0p-66, -0x1.bd7b1244a97cfp-61,
+    0x1.59199846e2d5ap-61, -0x1.c3eb3d678b4ddp-61, -0x1.359bd583a7670p-62,
+    0x1.5baa264c73457p-59, -0x1.828e29edc3690p-61, 0x1.f19e21d368317p-59,
+    -0x1.7a3a09c5322acp-58, 0x1.a1cb77c488e98p-60, -0x1.1cac9690a620ep-58,
+    0x1.a12ccb19eaba9p-58, -0x1.0469b06e5d776p-59, 0x1.beaf1f2509d6dp-58,
+    0x1.75d2300410594p-58, 0x1.d07e388643b01p-58, 0x1.a2bd521001a0dp-58,
+    0x1.1c7f0787f348bp-64, 0x1.0d5c175e1e973p-57, 0x1.ea496147f7a4dp-57,
+    0x1.46f451211a274p-59, 0x1.6b5749c099af3p-58, -0x1.d1078baa02229p-57,
+    0x1.afad35c61c340p-57, 0x1.544cfaa039789p-57, 0x1.f65b09415eef4p-58,
+    0x1.3cbdfde7dde9cp-58, 0x1.027bd6130df9ep-57, 0x1.86ea130e14454p-58,
+    0x1.d680b8bfacfc8p-59, 0x1.0373ad54a0ab2p-58, -0x1.4ef1f5c32d2dfp-59,
+    0x1.23c023db441c8p-59, 0x1.cf3eb9b5029b3p-60, -0x1.75bec5178f06dp-57,
+    -0x1.d3ba4905db3cfp-63, -0x1.cbf6c618cc399p-60, -0x1.9c1f9e095f6cap-57,
+    -0x1.6666bb21cac30p-56, -0x1.2d78f8f728fe7p-58, 0x1.147ddea1d4bbep-56,
+    0x1.760791395f8d2p-56, 0x1.5e4d6256cfd54p-57, 0x1.590ca8dce923ap-57,
+    -0x1.3b6477d6c3513p-58, 0x1.26ecf1489e666p-61, -0x1.e6471c3e16b15p-56,
+    -0x1.4d5a4f28ae725p-60, -0x1.938c5cdb44450p-56, 0x1.8ac4a85833954p-57,
+    -0x1.f90c322f56de5p-61, -0x1.77b180c1a7a75p-57
+};
+
+// Vector helpers
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+#define MATHKERNELS_INLINE inline __attribute__((always_inline, target("avx2,fma")))
+
+using Vec = __m256d;
+
+MATHKERNELS_INLINE Vec broadcast(double c) { return _mm256_set1_pd(c); }
+MATHKERNELS_INLINE Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+MATHKERNELS_INLINE Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+MATHKERNELS_INLINE Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+MATHKERNELS_INLINE Vec div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+// a b + c and c - a b with a single rounding
+MATHKERNELS_INLINE Vec mulAdd(Vec a, Vec b, Vec c) { return _mm256_fmadd_pd(a, b, c); }
+MATHKERNELS_INLINE Vec negMulAdd(Vec a, Vec b, Vec c) { return _mm256_fnmadd_pd(a, b, c); }
+MATHKERNELS_INLINE Vec abs(Vec a) { return _mm256_andnot_pd(broadcast(-0.0), a); }
+MATHKERNELS_INLINE Vec select(Vec mask, Vec ifTrue, Vec ifFalse) { return _mm256_blendv_pd(ifFalse, ifTrue, mask); }
+MATHKERNELS_INLINE Vec copySign(Vec magnitude, Vec sign) {
+    return _mm256_or_pd(abs(magnitude), _mm256_and_pd(sign, broadcast(-0.0)));
+}
+MATHKERNELS_INLINE Vec roundToInteger(Vec a) {
+    return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+template <std::size_t N>
+MATHKERNELS_INLINE Vec polynomial(Vec x, const double (&c)[N]) {
+    Vec p = broadcast(c[0]);
+    for (std::size_t i = 1; i < N; i++)
+        p = mulAdd(p, x, broadcast(c[i]));
+    return p;
+}
+
+// Error-free sums: s + e == a + b exactly. fastTwoSum requires |a| >= |b| or a == 0.
+MATHKERNELS_INLINE void twoSum(Vec a, Vec b, Vec& s, Vec& e) {
+    s = add(a, b);
+    Vec z = sub(s, a);
+    e = add(sub(a, sub(s, z)), sub(b, z));
+}
+
+MATHKERNELS_INLINE void fastTwoSum(Vec a, Vec b, Vec& s, Vec& e) {
+    s = add(a, b);
+    e = sub(b, sub(s, a));
+}
+
+// The low bits of an integer-valued k with |k| < 2^51, as two's complement lanes
+MATHKERNELS_INLINE __m256i integerBits(Vec k) {
+    return _mm256_castpd_si256(add(k, broadcast(0x1.8p52)));
+}
+
+// The double of a 64-bit lane value below 2^52
+MATHKERNELS_INLINE Vec toDouble(__m256i bits) {
+    return sub(_mm256_castsi256_pd(_mm256_or_si256(bits, _mm256_castpd_si256(broadcast(0x1p52)))),
+               broadcast(0x1p52));
+}
+
+// v 2^k for integer-valued k in [-1022, 1023]
+MATHKERNELS_INLINE Vec scaleByPowerOfTwo(Vec v, Vec k) {
+    __m256i bits = _mm256_slli_epi64(integerBits(add(k, broadcast(1023.0))), 52);
+    return mul(v, _mm256_castsi256_pd(bits));
+}
+
+// exp(xh + xl) = result + lo for |xh| <= EXP_LIMIT and |xl| <= ulp(xh). With
+// x = k ln(2) + r, exp(x) = 2^k (1 + r + r^2 Q(r)); the accurate tier carries the low
+// part of r and sums 1 + r exactly, so the result is within 0.7 ulp. The fast tier
+// evaluates one polynomial and sets lo to zero.
+template <bool Accurate>
+MATHKERNELS_INLINE Vec expKernel(Vec xh, Vec xl, Vec& lo) {
+    Vec k = roundToInteger(mul(xh, broadcast(LOG2_E)));
+    Vec rh = negMulAdd(k, broadcast(LN2_HI), xh);
+    Vec rl = negMulAdd(k, broadcast(LN2_LO), xl);
+    if constexpr (Accurate) {
+        // k ln(2)'s low part is not small against r^2, so fold it into r first; the
+        // remaining sub-ulp tail only needs exp(r + rl) = exp(r) (1 + rl)
+        twoSum(rh, rl, rh, rl);
+        Vec t = mulAdd(mul(rh, rh), polynomial(rh, EXP_ACCURATE), mulAdd(rl, rh, rl));
+        Vec one = broadcast(1.0);
+        Vec sh = add(one, rh);
+        Vec u = add(add(sub(one, sh), rh), t);
+        Vec hi;
+        fastTwoSum(sh, u, hi, lo);
+        lo = scaleByPowerOfTwo(lo, k);
+        return scaleByPowerOfTwo(hi, k);
+    } else {
+        lo = _mm256_setzero_pd();
+        return scaleByPowerOfTwo(polynomial(add(rh, rl), EXP_FAST), k);
+    }
+}
+
+// x = 2^k (1 + f) with 1 + f in [sqrt(2)/2, sqrt(2)) for positive normal x, and the
+// terms of fdlibm's log kernel: hfsq = f^2/2 and sr = s (hfsq + R)
+struct LogParts {
+    Vec k, f, hfsq, sr;
+};
+
+MATHKERNELS_INLINE LogParts logParts(Vec x) {
+    __m256i bits = _mm256_castpd_si256(x);
+    Vec k = sub(toDouble(_mm256_srli_epi64(bits, 52)), broadcast(1023.0));
+    Vec m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF)),
+                                                _mm256_set1_epi64x(0x3FF0000000000000)));
+    Vec big = _mm256_cmp_pd(m, broadcast(1.41421356237309504880), _CMP_GT_OQ);
+    m = select(big, mul(m, broadcast(0.5)), m);
+    k = add(k, _mm256_and_pd(big, broadcast(1.0)));
+
+    LogParts p;
+    p.k = k;
+    p.f = sub(m, broadcast(1.0));
+    p.hfsq = mul(mul(broadcast(0.5), p.f), p.f);
+    Vec s = div(p.f, add(broadcast(2.0), p.f));
+    Vec z = mul(s, s);
+    Vec w = mul(z, z);
+    Vec t1 = mul(w, mulAdd(w, mulAdd(w, broadcast(LG6), broadcast(LG4)), broadcast(LG2)));
+    Vec t2 = mul(z, mulAdd(w, mulAdd(w, mulAdd(w, broadcast(LG7), broadcast(LG5)), broadcast(LG3)), broadcast(LG1)));
+    p.sr = mul(s, add(p.hfsq, add(t2, t1)));
+    return p;
+}
+
+// log(1 + f) = hi + lo with hi keeping only its upper 21 significand bits, so that
+// hi times the upper part of a constant is exact (FreeBSD's log2 and log10)
+MATHKERNELS_INLINE Vec logSplit(const LogParts& p, Vec& lo) {
+    Vec hi = _mm256_and_pd(sub(p.f, p.hfsq), _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(0xFFFFFFFF00000000))));
+    lo = add(sub(sub(p.f, hi), p.hfsq), p.sr);
+    return hi;
+}
+
+// log(x) in one double for positive normal x; within 1 ulp
+MATHKERNELS_INLINE Vec logSingle(Vec x) {
+    LogParts p = logParts(x);
+    return add(add(sub(add(p.sr, mul(p.k, broadcast(LN2_LO))), p.hfsq), p.f), mul(p.k, broadcast(LN2_HI)));
+}
+
+// log(x) = result + lo to about 2^-66 relative, for positive normal x. With
+// x = 2^k z and z = c (1 + r) for the table's c, log(x) = k ln(2) + log(c) + log1p(r),
+// where r is exact in double-double and only r^3 and higher terms of log1p are
+// rounded to double.
+MATHKERNELS_INLINE Vec logDoubleDouble(Vec x, Vec& lo) {
+    __m256i ix = _mm256_castpd_si256(x);
+    __m256i tmp = _mm256_sub_epi64(ix, _mm256_set1_epi64x(static_cast<long long>(LOG_TABLE_OFFSET)));
+    __m256i index = _mm256_and_si256(_mm256_srli_epi64(tmp, 52 - LOG_TABLE_BITS),
+                                     _mm256_set1_epi64x((1 << LOG_TABLE_BITS) - 1));
+    // k = tmp >> 52 as a signed shift, which AVX2 lacks: bias by 1024 first
+    __m256i biased = _mm256_srli_epi64(_mm256_add_epi64(tmp, _mm256_set1_epi64x(0x4000000000000000)), 52);
+    Vec k = sub(toDouble(biased), broadcast(1024.0));
+    Vec z = _mm256_castsi256_pd(_mm256_sub_epi64(ix, _mm256_and_si256(tmp, _mm256_set1_epi64x(static_cast<long long>(0xFFF0000000000000)))));
+
+    Vec invc = _mm256_i64gather_pd(LOG_INVC, index, 8);
+    Vec logc = _mm256_i64gather_pd(LOG_LOGC, index, 8);
+    Vec logcTail = _mm256_i64gather_pd(LOG_LOGC_TAIL, index, 8);
+
+    // r = z invc - 1 = rh + rl exactly
+    Vec p = mul(z, invc);
+    Vec rh, rl;
+    fastTwoSum(sub(p, broadcast(1.0)), _mm256_fmsub_pd(z, invc, p), rh, rl);
+
+    // log1p(r) = r - r^2/2 - rh rl + r^3 P(r), with rh^2/2 = qh + ql exactly
+    Vec half = mul(rh, broadcast(0.5));
+    Vec qh = mul(rh, half);
+    Vec ql = _mm256_fmsub_pd(rh, half, qh);
+    Vec tail = mul(mul(mul(rh, rh), rh), polynomial(rh, LOG1P_TAIL));
+
+    Vec s1, e1, s2, e2, s3, e3;
+    twoSum(mul(k, broadcast(LN2_HI)), logc, s1, e1);
+    twoSum(s1, rh, s2, e2);
+    twoSum(s2, sub(_mm256_setzero_pd(), qh), s3, e3);
+    Vec low = add(add(e1, e2), e3);
+    low = add(low, mulAdd(k, broadcast(LN2_LO), logcTail));
+    low = add(low, sub(rl, ql));
+    low = add(low, negMulAdd(rh, rl, tail));
+    Vec hi;
+    fastTwoSum(s3, low, hi, lo);
+    return hi;
+}
+
+// x = k pi/2 + r with |r| <= pi/4 for |x| <= TRIG_LIMIT, returning k. The first
+// product is exact, so the accurate tier subtracts the remaining pieces of pi/2 with
+// error-free sums and returns r = rh + rl to about 2^-100 absolute, enough for any
+// x close to a multiple of pi/2. The fast tier returns r in one double with rl = 0.
+template <bool Accurate>
+MATHKERNELS_INLINE Vec reduceHalfPi(Vec x, Vec& rh, Vec& rl) {
+    Vec k = roundToInteger(mul(x, broadcast(TWO_OVER_PI)));
+    Vec r1 = negMulAdd(k, broadcast(PIO2_1), x);
+    if constexpr (Accurate) {
+        Vec a, ae, b, be;
+        twoSum(r1, mul(k, broadcast(-PIO2_2)), a, ae);
+        twoSum(a, mul(k, broadcast(-PIO2_3)), b, be);
+        twoSum(b, negMulAdd(k, broadcast(PIO2_3T), add(ae, be)), rh, rl);
+    } else {
+        rh = negMulAdd(k, broadcast(PIO2_2T), negMulAdd(k, broadcast(PIO2_2), r1));
+        rl = _mm256_setzero_pd();
+    }
+    return k;
+}
+
+// sin(rh + rl) and cos(rh + rl) as hi + lo with |lo| <= ulp(hi) / 2 (fdlibm's
+// __kernel_sin and __kernel_cos with the tail of the reduced argument)
+MATHKERNELS_INLINE void sinKernel(Vec rh, Vec rl, Vec& hi, Vec& lo) {
+    Vec z = mul(rh, rh);
+    Vec w = mul(z, z);
+    Vec v = mul(z, rh);
+    Vec r = add(mulAdd(z, mulAdd(z, broadcast(S4), broadcast(S3)), broadcast(S2)),
+                mul(mul(z, w), mulAdd(z, broadcast(S6), broadcast(S5))));
+    Vec t = sub(sub(mul(z, sub(mul(broadcast(0.5), rl), mul(v, r))), rl), mul(v, broadcast(S1)));
+    fastTwoSum(rh, sub(_mm256_setzero_pd(), t), hi, lo);
+}
+
+MATHKERNELS_INLINE void cosKernel(Vec rh, Vec rl, Vec& hi, Vec& lo) {
+    Vec z = mul(rh, rh);
+    Vec w = mul(z, z);
+    Vec r = add(mul(z, mulAdd(z, mulAdd(z, broadcast(C3), broadcast(C2)), broadcast(C1))),
+                mul(mul(w, w), mulAdd(z, mulAdd(z, broadcast(C6), broadcast(C5)), broadcast(C4))));
+    Vec hz = mul(broadcast(0.5), z);
+    Vec one = broadcast(1.0);
+    Vec h = sub(one, hz);
+    fastTwoSum(h, add(sub(sub(one, h), hz), sub(mul(z, r), mul(rh, rl))), hi, lo);
+}
+
+// The same kernels for a one-double argument, rounded once
+MATHKERNELS_INLINE Vec sinFast(Vec r) {
+    Vec z = mul(r, r);
+    Vec p = mulAdd(z, mulAdd(z, mulAdd(z, mulAdd(z, mulAdd(z, broadcast(S6), broadcast(S5)), broadcast(S4)),
+                                       broadcast(S3)), broadcast(S2)), broadcast(S1));
+    return mulAdd(mul(z, r), p, r);
+}
+
+MATHKERNELS_INLINE Vec cosFast(Vec r) {
+    Vec z = mul(r, r);
+    Vec p = mulAdd(z, mulAdd(z, mulAdd(z, mulAdd(z, mulAdd(z, broadcast(C6), broadcast(C5)), broadcast(C4)),
+                                       broadcast(C3)), broadcast(C2)), broadcast(C1));
+    return mulAdd(mul(z, z), p, negMulAdd(broadcast(0.5), z, broadcast(1.0)));
+}
+
+// sin(k pi/2 + r) from s = sin(r) and c = cos(r): quadrant bit 0 swaps them, bit 1
+// negates
+MATHKERNELS_INLINE Vec fromQuadrant(__m256i q, Vec s, Vec c) {
+    __m256i one = _mm256_set1_epi64x(1);
+    Vec odd = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, one), one));
+    Vec sign = _mm256_and_pd(_mm256_castsi256_pd(_mm256_slli_epi64(q, 62)), broadcast(-0.0));
+    return _mm256_xor_pd(select(odd, c, s), sign);
+}
+
+// sin(r) and cos(r) of the reduced argument, rounded to double
+template <bool Accurate>
+MATHKERNELS_INLINE Vec reducedSinCos(Vec x, __m256i& q, Vec& c) {
+    Vec rh, rl, s;
+    q = integerBits(reduceHalfPi<Accurate>(x, rh, rl));
+    if constexpr (Accurate) {
+        Vec sl, cl;
+        sinKernel(rh, rl, s, sl);
+        cosKernel(rh, rl, c, cl);
+    } else {
+        s = sinFast(rh);
+        c = cosFast(rh);
+    }
+    return s;
+}
+
+MATHKERNELS_INLINE Vec outsideRange(Vec x, double low, double high) {
+    return _mm256_or_pd(_mm256_cmp_pd(x, broadcast(low), _CMP_NGE_UQ), _mm256_cmp_pd(x, broadcast(high), _CMP_NLE_UQ));
+}
+#endif
+
+// Functions. library() is the C library version, used for lanes outside the vector
+// domain and for the whole array without AVX2. outside() marks the lanes the vector
+// code does not cover; evaluate() computes the rest.
+struct Sin {
+    static double library(double x) { return std::sin(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) {
+        return _mm256_cmp_pd(abs(x), broadcast(TRIG_LIMIT), _CMP_NLE_UQ);
+    }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        __m256i q;
+        Vec c;
+        Vec s = reducedSinCos<Accurate>(x, q, c);
+        return select(_mm256_cmp_pd(abs(x), broadcast(TRIG_TINY), _CMP_LT_OQ), x, fromQuadrant(q, s, c));
+    }
+#endif
+};
+
+struct Cos {
+    static double library(double x) { return std::cos(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return Sin::outside(x); }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        __m256i q;
+        Vec c;
+        Vec s = reducedSinCos<Accurate>(x, q, c);
+        return fromQuadrant(_mm256_add_epi64(q, _mm256_set1_epi64x(1)), s, c);
+    }
+#endif
+};
+
+struct Tan {
+    static double library(double x) { return std::tan(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return Sin::outside(x); }
+    // tan(k pi/2 + r) is sin(r) / cos(r) for even k and -cos(r) / sin(r) for odd k; the
+    // accurate tier divides the double-double pairs
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        Vec rh, rl, result;
+        __m256i q = integerBits(reduceHalfPi<Accurate>(x, rh, rl));
+        __m256i one = _mm256_set1_epi64x(1);
+        Vec odd = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, one), one));
+        if constexpr (Accurate) {
+            Vec sh, sl, ch, cl;
+            sinKernel(rh, rl, sh, sl);
+            cosKernel(rh, rl, ch, cl);
+            Vec nh = select(odd, ch, sh), nl = select(odd, cl, sl);
+            Vec dh = select(odd, sh, ch), dl = select(odd, sl, cl);
+            Vec q0 = div(nh, dh);
+            Vec remainder = add(negMulAdd(q0, dh, nh), nl);
+            result = add(q0, div(negMulAdd(q0, dl, remainder), add(dh, dl)));
+        } else {
+            Vec s = sinFast(rh), c = cosFast(rh);
+            result = div(select(odd, c, s), select(odd, s, c));
+        }
+        result = _mm256_xor_pd(result, _mm256_and_pd(odd, broadcast(-0.0)));
+        return select(_mm256_cmp_pd(abs(x), broadcast(TRIG_TINY), _CMP_LT_OQ), x, result);
+    }
+#endif
+};
+
+struct Exp {
+    static double library(double x) { return std::exp(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return outsideRange(x, -EXP_LIMIT, EXP_LIMIT + 1.0); }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        Vec lo;
+        return expKernel<Accurate>(x, _mm256_setzero_pd(), lo);
+    }
+#endif
+};
+
+struct Log {
+    static double library(double x) { return std::log(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return outsideRange(x, DBL_MIN, DBL_MAX); }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        if constexpr (Accurate)
+            return logSingle(x);
+        LogParts p = logParts(x);
+        return mulAdd(p.k, broadcast(0.69314718055994530942), add(sub(p.f, p.hfsq), p.sr));
+    }
+#endif
+};
+
+struct Log2 {
+    static double library(double x) { return std::log2(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return Log::outside(x); }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        if constexpr (!Accurate)
+            return mul(Log::evaluate<false>(x), broadcast(1.44269504088896340736));
+        LogParts p = logParts(x);
+        Vec lo;
+        Vec hi = logSplit(p, lo);
+        Vec valueHi = mul(hi, broadcast(INV_LN2_HI));
+        Vec valueLo = add(mul(add(lo, hi), broadcast(INV_LN2_LO)), mul(lo, broadcast(INV_LN2_HI)));
+        Vec w = add(p.k, valueHi);
+        valueLo = add(valueLo, add(sub(p.k, w), valueHi));
+        return add(valueLo, w);
+    }
+#endif
+};
+
+struct Log10 {
+    static double library(double x) { return std::log10(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return Log::outside(x); }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        if constexpr (!Accurate)
+            return mul(Log::evaluate<false>(x), broadcast(0.43429448190325182765));
+        LogParts p = logParts(x);
+        Vec lo;
+        Vec hi = logSplit(p, lo);
+        Vec valueHi = mul(hi, broadcast(INV_LN10_HI));
+        Vec y = mul(p.k, broadcast(LOG10_2_HI));
+        Vec valueLo = add(add(mul(p.k, broadcast(LOG10_2_LO)), mul(add(lo, hi), broadcast(INV_LN10_LO))),
+                          mul(lo, broadcast(INV_LN10_HI)));
+        Vec w = add(y, valueHi);
+        valueLo = add(valueLo, add(sub(y, w), valueHi));
+        return add(valueLo, w);
+    }
+#endif
+};
+
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+// e = exp(|x|) = eh + el and 1/e = ih + il
+template <bool Accurate>
+MATHKERNELS_INLINE void expPair(Vec a, Vec& eh, Vec& el, Vec& ih, Vec& il) {
+    eh = expKernel<Accurate>(a, _mm256_setzero_pd(), el);
+    ih = div(broadcast(1.0), eh);
+    if constexpr (Accurate)
+        il = mul(ih, negMulAdd(ih, el, negMulAdd(ih, eh, broadcast(1.0))));
+    else
+        il = _mm256_setzero_pd();
+}
+#endif
+
+// sinh(x) is x + x^3 P(x^2) below 1/2 and (e - 1/e) / 2 with e = exp(|x|) above
+struct Sinh {
+    static double library(double x) { return std::sinh(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) {
+        return _mm256_cmp_pd(abs(x), broadcast(EXP_LIMIT), _CMP_NLE_UQ);
+    }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        Vec a = abs(x);
+        Vec z = mul(x, x);
+        Vec small = mulAdd(mul(x, z), Accurate ? polynomial(z, SINH_ACCURATE) : polynomial(z, SINH_FAST), x);
+        Vec eh, el, ih, il, s, se;
+        expPair<Accurate>(a, eh, el, ih, il);
+        twoSum(eh, sub(_mm256_setzero_pd(), ih), s, se);
+        Vec large = mul(broadcast(0.5), add(s, sub(add(se, el), il)));
+        return select(_mm256_cmp_pd(a, broadcast(0.5), _CMP_LT_OQ), small, copySign(large, x));
+    }
+#endif
+};
+
+struct Cosh {
+    static double library(double x) { return std::cosh(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return Sinh::outside(x); }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        Vec eh, el, ih, il, s, se;
+        expPair<Accurate>(abs(x), eh, el, ih, il);
+        twoSum(eh, ih, s, se);
+        return mul(broadcast(0.5), add(s, add(add(se, el), il)));
+    }
+#endif
+};
+
+// tanh(x) is sinh(x) / cosh(x) from their Taylor series below 1/2 and
+// 1 - 2 / (exp(2|x|) + 1) above, with |x| capped at 20 where tanh rounds to 1
+struct Tanh {
+    static double library(double x) { return std::tanh(x); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x) { return _mm256_cmp_pd(x, x, _CMP_UNORD_Q); }
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x) {
+        Vec a = abs(x);
+        Vec z = mul(x, x);
+        Vec one = broadcast(1.0), two = broadcast(2.0);
+        Vec sinhTail = mul(mul(x, z), Accurate ? polynomial(z, SINH_ACCURATE) : polynomial(z, SINH_FAST));
+        Vec coshTail = mul(z, Accurate ? polynomial(z, COSH_ACCURATE) : polynomial(z, COSH_FAST));
+        Vec small = add(x, div(negMulAdd(x, coshTail, sinhTail), add(one, coshTail)));
+
+        Vec el;
+        Vec eh = expKernel<Accurate>(mul(two, _mm256_min_pd(a, broadcast(20.0))), _mm256_setzero_pd(), el);
+        Vec dh, dl;
+        fastTwoSum(eh, one, dh, dl);
+        dl = add(dl, el);
+        Vec q0 = div(two, dh);
+        Vec ql = div(negMulAdd(q0, dl, negMulAdd(q0, dh, two)), dh);
+        Vec t, te;
+        fastTwoSum(one, sub(_mm256_setzero_pd(), q0), t, te);
+        Vec large = add(t, sub(te, ql));
+        // tanh is odd; the sign also keeps tanh(-0) == -0, which small alone rounds to +0
+        return copySign(select(_mm256_cmp_pd(a, broadcast(0.5), _CMP_LT_OQ), small, large), x);
+    }
+#endif
+};
+
+// pow(x, y) = exp(y log(x)) for positive normal x. The accurate tier keeps log(x) and
+// the product y log(x) in double-double, so the exponent's error stays far below one
+// ulp of the result even for |y log(x)| near the overflow limit.
+struct Pow {
+    static double library(double x, double y) { return std::pow(x, y); }
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    static MATHKERNELS_INLINE Vec outside(Vec x, Vec y) {
+        return _mm256_or_pd(Log::outside(x), _mm256_cmp_pd(abs(y), broadcast(DBL_MAX), _CMP_NLE_UQ));
+    }
+    // overflow marks lanes whose result would overflow or become subnormal
+    template <bool Accurate>
+    static MATHKERNELS_INLINE Vec evaluate(Vec x, Vec y, Vec& overflow) {
+        Vec eh, el;
+        if constexpr (Accurate) {
+            Vec ll;
+            Vec lh = logDoubleDouble(x, ll);
+            eh = mul(y, lh);
+            el = mulAdd(y, ll, _mm256_fmsub_pd(y, lh, eh));
+        } else {
+            eh = mul(y, Log::evaluate<false>(x));
+            el = _mm256_setzero_pd();
+        }
+        overflow = _mm256_cmp_pd(abs(eh), broadcast(EXP_LIMIT), _CMP_NLE_UQ);
+        Vec lo;
+        return expKernel<Accurate>(eh, el, lo);
+    }
+#endif
+};
+
+// Drivers
+template <typename F>
+void unaryScalar(const double* x, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++)
+        out[i] = F::library(x[i]);
+}
+
+void powScalar(const double* x, const double* y, std::size_t yStride, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++)
+        out[i] = Pow::library(x[i], y[i * yStride]);
+}
+
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+// Blocks of four; a block with any lane outside the vector domain goes to the C
+// library. The last partial block is padded with ones, which every kernel accepts.
+template <typename F, bool Accurate>
+__attribute__((target("avx2,fma")))
+void unaryAvx2(const double* x, double* out, std::size_t n) {
+    alignas(32) double tail[4];
+    for (std::size_t i = 0; i < n; i += 4) {
+        std::size_t count = std::min<std::size_t>(4, n - i);
+        Vec v;
+        if (count == 4) {
+            v = _mm256_loadu_pd(x + i);
+        } else {
+            std::fill(tail, tail + 4, 1.0);
+            std::copy(x + i, x + n, tail);
+            v = _mm256_load_pd(tail);
+        }
+        if (_mm256_movemask_pd(F::outside(v))) {
+            unaryScalar<F>(x + i, out + i, count);
+            continue;
+        }
+        v = F::template evaluate<Accurate>(v);
+        if (count == 4) {
+            _mm256_storeu_pd(out + i, v);
+        } else {
+            _mm256_store_pd(tail, v);
+            std::copy(tail, tail + count, out + i);
+        }
+    }
+}
+
+template <bool Accurate>
+__attribute__((target("avx2,fma")))
+void powAvx2(const double* x, const double* y, std::size_t yStride, double* out, std::size_t n) {
+    alignas(32) double tailX[4], tailY[4];
+    for (std::size_t i = 0; i < n; i += 4) {
+        std::size_t count = std::min<std::size_t>(4, n - i);
+        Vec vx, vy;
+        if (count == 4) {
+            vx = _mm256_loadu_pd(x + i);
+            vy = yStride ? _mm256_loadu_pd(y + i) : broadcast(*y);
+        } else {
+            std::fill(tailX, tailX + 4, 1.0);
+            std::fill(tailY, tailY + 4, 1.0);
+            for (std::size_t j = 0; j < count; j++) {
+                tailX[j] = x[i + j];
+                tailY[j] = y[(i + j) * yStride];
+            }
+            vx = _mm256_load_pd(tailX);
+            vy = _mm256_load_pd(tailY);
+        }
+        Vec overflow;
+        if (!_mm256_movemask_pd(Pow::outside(vx, vy))) {
+            Vec v = Pow::evaluate<Accurate>(vx, vy, overflow);
+            if (!_mm256_movemask_pd(overflow)) {
+                if (count == 4) {
+                    _mm256_storeu_pd(out + i, v);
+                } else {
+                    _mm256_store_pd(tailX, v);
+                    std::copy(tailX, tailX + count, out + i);
+                }
+                continue;
+            }
+        }
+        powScalar(x + i, y + i * yStride, yStride, out + i, count);
+    }
+}
+#endif
+
+// Kernels indexed by Function and Accuracy
+struct Kernels {
+    const char* name;
+    Unary unary[FUNCTIONS][2];
+    Binary pow[2];
+};
+
+#define MATHKERNELS_SCALAR(F) {unaryScalar<F>, unaryScalar<F>}
+#define MATHKERNELS_AVX2(F) {unaryAvx2<F, true>, unaryAvx2<F, false>}
+
+Kernels selectKernels() {
+#ifdef MATHKERNELS_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return {"avx2",
+                {MATHKERNELS_AVX2(Sin), MATHKERNELS_AVX2(Cos), MATHKERNELS_AVX2(Tan), MATHKERNELS_AVX2(Exp),
+                 MATHKERNELS_AVX2(Log), MATHKERNELS_AVX2(Log2), MATHKERNELS_AVX2(Log10), MATHKERNELS_AVX2(Sinh),
+                 MATHKERNELS_AVX2(Cosh), MATHKERNELS_AVX2(Tanh)},
+                {powAvx2<true>, powAvx2<false>}};
+#endif
+    return {"scalar",
+            {MATHKERNELS_SCALAR(Sin), MATHKERNELS_SCALAR(Cos), MATHKERNELS_SCALAR(Tan), MATHKERNELS_SCALAR(Exp),
+             MATHKERNELS_SCALAR(Log), MATHKERNELS_SCALAR(Log2), MATHKERNELS_SCALAR(Log10), MATHKERNELS_SCALAR(Sinh),
+             MATHKERNELS_SCALAR(Cosh), MATHKERNELS_SCALAR(Tanh)},
+            {powScalar, powScalar}};
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+// Run body(begin, end) over [0, n), split into tasks on the pool for large arrays
+void forEachRange(std::size_t n, const std::function<void(std::size_t, std::size_t)>& body) {
+    if (n < PARALLEL_VALUES || ThreadPool::instance().threadCount() <= 1) {
+        body(0, n);
+        return;
+    }
+    int tasks = static_cast<int>((n + TASK_VALUES - 1) / TASK_VALUES);
+    ThreadPool::instance().parallelFor(tasks, [&](int t) {
+        std::size_t begin = static_cast<std::size_t>(t) * TASK_VALUES;
+        body(begin, std::min(n, begin + TASK_VALUES));
+    });
+}
+
+void applyUnary(Function f, const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    Unary kernel = kernels().unary[f][static_cast<int>(accuracy)];
+    forEachRange(n, [&](std::size_t begin, std::size_t end) { kernel(x + begin, out + begin, end - begin); });
+}
+
+void applyPow(const double* x, const double* y, std::size_t yStride, double* out, std::size_t n,
+              Accuracy accuracy) {
+    Binary kernel = kernels().pow[static_cast<int>(accuracy)];
+    forEachRange(n, [&](std::size_t begin, std::size_t end) {
+        kernel(x + begin, y + begin * yStride, yStride, out + begin, end - begin);
+    });
+}
+
+} // namespace
+
+void sin(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(SIN, x, out, n, accuracy);
+}
+
+void cos(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(COS, x, out, n, accuracy);
+}
+
+void tan(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(TAN, x, out, n, accuracy);
+}
+
+void exp(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(EXP, x, out, n, accuracy);
+}
+
+void log(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(LOG, x, out, n, accuracy);
+}
+
+void log2(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(LOG2, x, out, n, accuracy);
+}
+
+void log10(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(LOG10, x, out, n, accuracy);
+}
+
+void sinh(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(SINH, x, out, n, accuracy);
+}
+
+void cosh(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(COSH, x, out, n, accuracy);
+}
+
+void tanh(const double* x, double* out, std::size_t n, Accuracy accuracy) {
+    applyUnary(TANH, x, out, n, accuracy);
+}
+
+void pow(const double* x, const double* y, double* out, std::size_t n, Accuracy accuracy) {
+    applyPow(x, y, 1, out, n, accuracy);
+}
+
+void pow(const double* x, double y, double* out, std::size_t n, Accuracy accuracy) {
+    applyPow(x, &y, 0, out, n, accuracy);
+}
+
+const char* implementation() {
+    return kernels().name;
+}
+
+} // namespace mathkernels
@@ -0,0 +1,43 @@
+#ifndef MATH_KERNELS_H
+#define MATH_KERNELS_H
+
+#include <cstddef>
+
+// Elementwise elementary functions over contiguous double arrays: out[i] = f(x[i]).
+//
+// With AVX2/FMA, four values are evaluated at once by range reduction followed by a
+// polynomial. Values a kernel does not cover (non-finite inputs, |x| above 2^20 for
+// the trigonometric functions, non-positive or subnormal logarithm arguments, results
+// that would overflow or become subnormal) send their block of four to the C library,
+// so special cases match std:: exactly. Without AVX2 every call uses the C library.
+//
+// The output may be the input array itself, but must not partially overlap it. Large
+// arrays are split across the shared ThreadPool.
+namespace mathkernels {
+
+enum class Accuracy {
+    Accurate, // within 1 ulp of the exact result
+    Fast      // shorter polynomials and single-double reductions; relative error below 1e-12
+};
+
+void sin(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void cos(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void tan(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void exp(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void log(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void log2(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void log10(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void sinh(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void cosh(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void tanh(const double* x, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+
+// out[i] = x[i]^y[i], and out[i] = x[i]^y
+void pow(const double* x, const double* y, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+void pow(const double* x, double y, double* out, std::size_t n, Accuracy accuracy = Accuracy::Accurate);
+
+// Name of the selected implementation: "avx2" or "scalar".
+const char* implementation();
+
+} // namespace mathkernels
+
+#endif // MATH_KERNELS_H
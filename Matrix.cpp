@@ -1,7 +1,108 @@
 #include "Matrix.h"
+#include "Gemm.h"
+#include "EigenSolver.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace {
+
+// Row padding granularity: four doubles fill one 256-bit register.
+constexpr std::size_t ROW_ALIGNMENT = 4;
+
+// Tile shapes for parallel work: multiply tiles are sized so one tile's slice of B
+// is reused from cache, expression and transpose tiles cover whole row bands.
+constexpr int MULTIPLY_TILE_ROWS = 96;
+constexpr int MULTIPLY_TILE_COLS = 512;
+constexpr int ELEMENTWISE_TILE_ROWS = 64;
+constexpr int TRANSPOSE_BLOCK = 32;
+
+std::atomic<std::size_t> parallelWorkThreshold{std::size_t(1) << 18};
+
+// Run body over [0, tiles), on the thread pool when the operation is large enough.
+template <typename Body>
+void forEachTile(int tiles, std::size_t work, Body body) {
+    if (tiles > 1 && work >= parallelWorkThreshold.load(std::memory_order_relaxed)
+        && ThreadPool::instance().threadCount() > 1) {
+        ThreadPool::instance().parallelFor(tiles, body);
+        return;
+    }
+    for (int t = 0; t < tiles; t++)
+        body(t);
+}
+
+int tileCount(int extent, int tile) {
+    return (extent + tile - 1) / tile;
+}
+
+Matrix identity(int n) {
+    Matrix result(n, n);
+    for (int i = 0; i < n; i++)
+        result.setElement(i, i, 1.0);
+    return result;
+}
+
+std::size_t paddedStride(int c) {
+    return (static_cast<std::size_t>(c) + ROW_ALIGNMENT - 1) / ROW_ALIGNMENT * ROW_ALIGNMENT;
+}
+
+} // namespace
+
+// LU factors packed into one matrix: unit lower L below the diagonal, U on and above it
+struct Matrix::LUFactors {
+    Matrix packed;
+    std::vector<int> pivots; // row i of PA is row pivots[i] of A
+    int sign = 1;            // determinant of P
+    bool singular = false;
+
+    explicit LUFactors(const Matrix& m) : packed(m) {}
+};
 
 // Constructor
-Matrix::Matrix(int r, int c) : rows(r), cols(c), mat(r, std::vector<double>(c, 0)) {}
+Matrix::Matrix(int r, int c) : rows(r), cols(c), stride(paddedStride(c)) {
+    if (r < 0 || c < 0)
+        throw std::invalid_argument("Matrix dimensions must be non-negative");
+    data.assign(static_cast<std::size_t>(r) * stride, 0.0);
+}
+
+// Copy and move: a copy refactors on demand, a move takes the cache along
+Matrix::Matrix(const Matrix& other) : data(other.data), rows(other.rows), cols(other.cols), stride(other.stride) {}
+
+Matrix::Matrix(Matrix&& other) noexcept
+    : data(std::move(other.data)), rows(other.rows), cols(other.cols), stride(other.stride),
+      luCache(other.luCache.exchange(nullptr, std::memory_order_relaxed)) {}
+
+Matrix& Matrix::operator=(const Matrix& other) {
+    if (this != &other) {
+        data = other.data;
+        rows = other.rows;
+        cols = other.cols;
+        stride = other.stride;
+        dropLUCache();
+    }
+    return *this;
+}
+
+Matrix& Matrix::operator=(Matrix&& other) noexcept {
+    if (this != &other) {
+        data = std::move(other.data);
+        rows = other.rows;
+        cols = other.cols;
+        stride = other.stride;
+        dropLUCache();
+        luCache.store(other.luCache.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+Matrix::~Matrix() {
+    dropLUCache();
+}
+
+void Matrix::freeLUCache() {
+    delete luCache.exchange(nullptr, std::memory_order_relaxed);
+}
 
 // Helper method to get cofactor
 Matrix Matrix::getCofactor(int p, int q, int n) const {
@@ -10,7 +111,7 @@ Matrix Matrix::getCofactor(int p, int q, int n) const {
     for (int row = 0; row < n; row++) {
         for (int col = 0; col < n; col++) {
             if (row != p && col != q) {
-                temp.mat[i][j++] = mat[row][col];
+                temp.at(i, j++) = at(row, col);
                 if (j == n - 1) {
                     j = 0;
                     i++;
@@ -25,57 +126,367 @@ Matrix Matrix::getCofactor(int p, int q, int n) const {
 void Matrix::setElement(int i, int j, double value) {
     if (i >= rows || j >= cols)
         throw std::out_of_range("Index out of range");
-    mat[i][j] = value;
+    at(i, j) = value;
+    dropLUCache();
 }
 
 double Matrix::getElement(int i, int j) const {
     if (i >= rows || j >= cols)
         throw std::out_of_range("Index out of range");
-    return mat[i][j];
+    return at(i, j);
 }
 
-// Addition
-Matrix Matrix::operator+(const Matrix& other) const {
-    if (rows != other.rows || cols != other.cols)
-        throw std::invalid_argument("Matrix dimensions do not match for addition");
-    Matrix result(rows, cols);
-    for (int i = 0; i < rows; i++)
-        for (int j = 0; j < cols; j++)
-            result.mat[i][j] = mat[i][j] + other.mat[i][j];
+// Multiplication
+Matrix Matrix::operator*(const Matrix& other) const {
+    if (cols != other.rows)
+        throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+    Matrix result(rows, other.cols);
+    int rowTiles = tileCount(rows, MULTIPLY_TILE_ROWS);
+    int colTiles = tileCount(other.cols, MULTIPLY_TILE_COLS);
+    std::size_t work = static_cast<std::size_t>(rows) * other.cols * cols;
+    forEachTile(rowTiles * colTiles, work, [&](int t) {
+        int i0 = (t / colTiles) * MULTIPLY_TILE_ROWS;
+        int j0 = (t % colTiles) * MULTIPLY_TILE_COLS;
+        int m = std::min(MULTIPLY_TILE_ROWS, rows - i0);
+        int n = std::min(MULTIPLY_TILE_COLS, other.cols - j0);
+        gemm::multiplyAdd(m, n, cols,
+                          data.data() + i0 * stride, stride,
+                          other.data.data() + j0, other.stride,
+                          result.data.data() + i0 * result.stride + j0, result.stride);
+    });
     return result;
 }
 
-// Subtraction
-Matrix Matrix::operator-(const Matrix& other) const {
-    if (rows != other.rows || cols != other.cols)
-        throw std::invalid_argument("Matrix dimensions do not match for subtraction");
-    Matrix result(rows, cols);
+// Transpose of a plain matrix, in cache-sized square blocks
+Matrix::Matrix(const MatrixTranspose<Matrix>& expr) : Matrix(expr.getRows(), expr.getCols()) {
+    transposeFrom(expr.nested());
+}
+
+Matrix& Matrix::operator=(const MatrixTranspose<Matrix>& expr) {
+    if (&expr.nested() == this) {
+        Matrix temp(expr);
+        return *this = std::move(temp);
+    }
+    if (rows != expr.getRows() || cols != expr.getCols())
+        reshape(expr.getRows(), expr.getCols());
+    transposeFrom(expr.nested());
+    return *this;
+}
+
+void Matrix::transposeFrom(const Matrix& source) {
+    dropLUCache();
+    int blocks = tileCount(source.rows, TRANSPOSE_BLOCK);
+    forEachTile(blocks, source.data.size(), [&](int t) {
+        int i0 = t * TRANSPOSE_BLOCK;
+        int i1 = std::min(i0 + TRANSPOSE_BLOCK, source.rows);
+        for (int j0 = 0; j0 < source.cols; j0 += TRANSPOSE_BLOCK) {
+            int j1 = std::min(j0 + TRANSPOSE_BLOCK, source.cols);
+            for (int i = i0; i < i1; i++)
+                for (int j = j0; j < j1; j++)
+                    at(j, i) = source.at(i, j);
+        }
+    });
+}
+
+// In-place scaling
+Matrix& Matrix::operator*=(double scalar) {
+    dropLUCache();
+    for (double& value : data)
+        value *= scalar;
+    return *this;
+}
+
+// Expression evaluation helpers
+void Matrix::reshape(int r, int c) {
+    rows = r;
+    cols = c;
+    stride = paddedStride(c);
+    data.assign(static_cast<std::size_t>(r) * stride, 0.0);
+    dropLUCache();
+}
+
+void Matrix::forEachRowBand(int rows, std::size_t work, const std::function<void(int, int)>& body) {
+    forEachTile(tileCount(rows, ELEMENTWISE_TILE_ROWS), work, [&](int t) {
+        int begin = t * ELEMENTWISE_TILE_ROWS;
+        body(begin, std::min(begin + ELEMENTWISE_TILE_ROWS, rows));
+    });
+}
+
+// LU factorization with partial pivoting, cached until the matrix is modified
+const Matrix::LUFactors& Matrix::luFactors() const {
+    if (const LUFactors* cached = luCache.load(std::memory_order_acquire))
+        return *cached;
+    if (rows != cols)
+        throw std::invalid_argument("LU factorization requires a square matrix");
+
+    auto factors = std::make_unique<LUFactors>(*this);
+    Matrix& a = factors->packed;
+    int n = rows;
+    factors->pivots.resize(n);
+    for (int i = 0; i < n; i++)
+        factors->pivots[i] = i;
+
+    for (int k = 0; k < n; k++) {
+        int pivot = k;
+        double maxAbs = std::abs(a.at(k, k));
+        for (int i = k + 1; i < n; i++) {
+            if (std::abs(a.at(i, k)) > maxAbs) {
+                maxAbs = std::abs(a.at(i, k));
+                pivot = i;
+            }
+        }
+        if (maxAbs == 0) {
+            factors->singular = true;
+            continue;
+        }
+        if (pivot != k) {
+            std::swap_ranges(&a.at(k, 0), &a.at(k, 0) + n, &a.at(pivot, 0));
+            std::swap(factors->pivots[k], factors->pivots[pivot]);
+            factors->sign = -factors->sign;
+        }
+
+        const double* rowK = &a.at(k, 0);
+        for (int i = k + 1; i < n; i++) {
+            double* rowI = &a.at(i, 0);
+            double l = rowI[k] /= rowK[k];
+            if (l == 0)
+                continue;
+            for (int j = k + 1; j < n; j++)
+                rowI[j] -= l * rowK[j];
+        }
+    }
+
+    // Publish unless another thread got there first, in which case use its factors
+    const LUFactors* expected = nullptr;
+    if (luCache.compare_exchange_strong(expected, factors.get(), std::memory_order_acq_rel,
+                                        std::memory_order_acquire))
+        return *factors.release();
+    return *expected;
+}
+
+// Determinant from the diagonal of U
+double Matrix::determinant() const {
+    if (rows != cols)
+        throw std::invalid_argument("Determinant is only defined for square matrices");
+    const LUFactors& lu = luFactors();
+    if (lu.singular)
+        return 0.0;
+    double det = lu.sign;
     for (int i = 0; i < rows; i++)
-        for (int j = 0; j < cols; j++)
-            result.mat[i][j] = mat[i][j] - other.mat[i][j];
+        det *= lu.packed.at(i, i);
+    return det;
+}
+
+// Solve Ax = b by forward and back substitution
+std::vector<double> Matrix::solve(const std::vector<double>& b) const {
+    if (rows != cols || static_cast<int>(b.size()) != rows)
+        throw std::invalid_argument("Matrix dimensions do not match for solve");
+    const LUFactors& lu = luFactors();
+    if (lu.singular)
+        throw std::invalid_argument("Matrix is singular");
+
+    int n = rows;
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++) {
+        const double* l = &lu.packed.at(i, 0);
+        double sum = b[lu.pivots[i]];
+        for (int k = 0; k < i; k++)
+            sum -= l[k] * x[k];
+        x[i] = sum;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        const double* u = &lu.packed.at(i, 0);
+        double sum = x[i];
+        for (int k = i + 1; k < n; k++)
+            sum -= u[k] * x[k];
+        x[i] = sum / u[i];
+    }
+    return x;
+}
+
+// Solve AX = B for all columns of B at once, working on whole rows
+Matrix Matrix::solve(const Matrix& b) const {
+    if (rows != cols || b.rows != rows)
+        throw std::invalid_argument("Matrix dimensions do not match for solve");
+    const LUFactors& lu = luFactors();
+    if (lu.singular)
+        throw std::invalid_argument("Matrix is singular");
+
+    int n = rows;
+    int m = b.cols;
+    Matrix x(n, m);
+    for (int i = 0; i < n; i++) {
+        double* xi = &x.at(i, 0);
+        std::copy(&b.at(lu.pivots[i], 0), &b.at(lu.pivots[i], 0) + m, xi);
+        const double* l = &lu.packed.at(i, 0);
+        for (int k = 0; k < i; k++) {
+            if (l[k] == 0)
+                continue;
+            const double* xk = &x.at(k, 0);
+            for (int j = 0; j < m; j++)
+                xi[j] -= l[k] * xk[j];
+        }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double* xi = &x.at(i, 0);
+        const double* u = &lu.packed.at(i, 0);
+        for (int k = i + 1; k < n; k++) {
+            if (u[k] == 0)
+                continue;
+            const double* xk = &x.at(k, 0);
+            for (int j = 0; j < m; j++)
+                xi[j] -= u[k] * xk[j];
+        }
+        double inv = 1.0 / u[i];
+        for (int j = 0; j < m; j++)
+            xi[j] *= inv;
+    }
+    return x;
+}
+
+// Inverse, by solving against the identity
+Matrix Matrix::inverse() const {
+    if (rows != cols)
+        throw std::invalid_argument("Inverse is only defined for square matrices");
+    if (luFactors().singular)
+        throw std::invalid_argument("Matrix is singular and cannot be inverted");
+    return solve(identity(rows));
+}
+
+// Adjoint (adjugate): det(A) * inverse(A) when A is invertible. A singular matrix has a
+// nonzero adjugate only at rank n - 1, where it falls back to cofactor expansion.
+Matrix Matrix::adjoint() const {
+    if (rows != cols)
+        throw std::invalid_argument("Adjoint is only defined for square matrices");
+    int n = rows;
+    if (n == 1)
+        return identity(1);
+    if (!luFactors().singular) {
+        Matrix result = inverse();
+        result *= determinant();
+        return result;
+    }
+
+    Matrix result(n, n);
+    if (rank() < n - 1)
+        return result;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double sign = (i + j) % 2 == 0 ? 1.0 : -1.0;
+            result.at(j, i) = sign * getCofactor(i, j, n).determinant();
+        }
+    }
     return result;
 }
 
-// Multiplication
-Matrix Matrix::operator*(const Matrix& other) const {
-    if (cols != other.rows)
-        throw std::invalid_argument("Matrix dimensions do not match for multiplication");
-    Matrix result(rows, other.cols);
+// Row echelon form by Gaussian elimination with partial pivoting. Entries below a
+// scale-aware tolerance are treated as exact zeros so that rank() is stable.
+Matrix Matrix::rowEchelon() const {
+    Matrix a(*this);
+
+    double maxAbs = 0;
+    for (double value : a.data)
+        maxAbs = std::max(maxAbs, std::abs(value));
+    double tolerance = std::max(rows, cols) * maxAbs * std::numeric_limits<double>::epsilon();
+
+    int pivotRow = 0;
+    for (int col = 0; col < cols && pivotRow < rows; col++) {
+        int pivot = pivotRow;
+        for (int i = pivotRow + 1; i < rows; i++)
+            if (std::abs(a.at(i, col)) > std::abs(a.at(pivot, col)))
+                pivot = i;
+        if (std::abs(a.at(pivot, col)) <= tolerance) {
+            for (int i = pivotRow; i < rows; i++)
+                a.at(i, col) = 0.0;
+            continue;
+        }
+        if (pivot != pivotRow)
+            std::swap_ranges(&a.at(pivotRow, 0), &a.at(pivotRow, 0) + cols, &a.at(pivot, 0));
+
+        const double* rowP = &a.at(pivotRow, 0);
+        for (int i = pivotRow + 1; i < rows; i++) {
+            double* rowI = &a.at(i, 0);
+            double factor = rowI[col] / rowP[col];
+            rowI[col] = 0.0;
+            if (factor == 0)
+                continue;
+            for (int j = col + 1; j < cols; j++)
+                rowI[j] -= factor * rowP[j];
+        }
+        pivotRow++;
+    }
+    return a;
+}
+
+// Rank: number of nonzero rows in the row echelon form
+int Matrix::rank() const {
+    Matrix echelon = rowEchelon();
+    int result = 0;
+    for (int i = 0; i < rows; i++) {
+        const double* row = &echelon.at(i, 0);
+        if (std::any_of(row, row + cols, [](double value) { return value != 0.0; }))
+            result++;
+    }
+    return result;
+}
+
+// Trace
+double Matrix::trace() const {
+    if (rows != cols)
+        throw std::invalid_argument("Trace is only defined for square matrices");
+    double sum = 0;
     for (int i = 0; i < rows; i++)
-        for (int j = 0; j < other.cols; j++)
-            for (int k = 0; k < cols; k++)
-                result.mat[i][j] += mat[i][k] * other.mat[k][j];
+        sum += at(i, i);
+    return sum;
+}
+
+// Characteristic polynomial, expanded from the eigenvalues: prod (x - lambda_i)
+std::vector<double> Matrix::characteristicPolynomial() const {
+    std::vector<std::complex<double>> lambda = eigenvalues();
+    std::vector<std::complex<double>> coeffs{1.0};
+    for (const std::complex<double>& root : lambda) {
+        coeffs.push_back(0.0);
+        for (std::size_t k = coeffs.size() - 1; k > 0; k--)
+            coeffs[k] -= root * coeffs[k - 1];
+    }
+    std::vector<double> result(coeffs.size());
+    for (std::size_t k = 0; k < coeffs.size(); k++)
+        result[k] = coeffs[k].real();
     return result;
 }
 
-// Other methods (transpose, determinant, adjoint, inverse, rank, etc.)...
-// Implement them similarly with error handling.
+// Eigenvalues only (skips accumulating the transformations)
+std::vector<std::complex<double>> Matrix::eigenvalues() const {
+    return EigenSolver(*this, false).eigenvalues();
+}
+
+// Eigenvectors, in the same order as eigenvalues()
+std::vector<std::vector<std::complex<double>>> Matrix::eigenvectors() const {
+    return EigenSolver(*this, true).eigenvectors();
+}
 
 void Matrix::display() const {
-    for (const auto& row : mat) {
-        for (double val : row) {
-            std::cout << std::setw(8) << val << " ";
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            std::cout << std::setw(8) << at(i, j) << " ";
         }
         std::cout << std::endl;
     }
 }
+
+// Parallel execution settings
+void Matrix::setThreadCount(int threads) {
+    ThreadPool::instance().setThreadCount(threads);
+}
+
+int Matrix::threadCount() {
+    return ThreadPool::instance().threadCount();
+}
+
+void Matrix::setParallelThreshold(std::size_t work) {
+    parallelWorkThreshold.store(work, std::memory_order_relaxed);
+}
+
+std::size_t Matrix::parallelThreshold() {
+    return parallelWorkThreshold.load(std::memory_order_relaxed);
+}
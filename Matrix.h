@@ -6,33 +6,126 @@
 #include <stdexcept>
 #include <iomanip>
 #include <cmath>
+#include <memory>
+#include <atomic>
+#include <complex>
+#include <functional>
+#include <utility>
+#include "AlignedAllocator.h"
+#include "MatrixExpr.h"
 
-class Matrix {
+class Matrix : public MatrixExpr<Matrix> {
 private:
-    std::vector<std::vector<double>> mat;
+    // Row-major elements in one aligned buffer; each row is padded to `stride` doubles
+    // so that every row starts on a SIMD boundary.
+    AlignedVector<double> data;
     int rows, cols;
+    std::size_t stride;
 
-    // Helper method for determinant and adjoint calculation
+    double& at(int i, int j) { return data[i * stride + j]; }
+    const double& at(int i, int j) const { return data[i * stride + j]; }
+
+    // Partially pivoted LU factorization (PA = LU), computed on first use by
+    // determinant(), inverse() or solve() and dropped whenever an element changes.
+    // Concurrent first uses on one const matrix may each factor it; the first result
+    // published wins and the others are discarded. Copies start without the cache.
+    struct LUFactors;
+    mutable std::atomic<const LUFactors*> luCache{nullptr};
+    const LUFactors& luFactors() const;
+    // Mutation has exclusive access, so a relaxed load keeps this cheap when empty
+    void dropLUCache() {
+        if (luCache.load(std::memory_order_relaxed))
+            freeLUCache();
+    }
+    void freeLUCache();
+
+    // Helper method for the adjoint of singular matrices
     Matrix getCofactor(int p, int q, int n) const;
 
+    // Expression evaluation: reallocate for new dimensions, then combine each element
+    // of expr into this matrix with op(destination, value) in one pass
+    void reshape(int r, int c);
+    void transposeFrom(const Matrix& source);
+    template <typename E, typename Op>
+    void evaluateInto(const E& expr, Op op);
+
 public:
     // Constructor
     Matrix(int r, int c);
+    Matrix(const Matrix& other);
+    Matrix(Matrix&& other) noexcept;
+    Matrix& operator=(const Matrix& other);
+    Matrix& operator=(Matrix&& other) noexcept;
+    ~Matrix();
+
+    // Evaluate a lazy expression (A + B - C, s * A, transpose(A), ...) in one pass
+    template <typename E>
+    Matrix(const MatrixExpr<E>& expr);
+    Matrix(const MatrixTranspose<Matrix>& expr);
+
+    template <typename E>
+    Matrix& operator=(const MatrixExpr<E>& expr);
+    Matrix& operator=(const MatrixTranspose<Matrix>& expr);
+
+    // In-place accumulation and scaling
+    template <typename E>
+    Matrix& operator+=(const MatrixExpr<E>& expr);
+    template <typename E>
+    Matrix& operator-=(const MatrixExpr<E>& expr);
+    Matrix& operator*=(double scalar);
+
+    // Assignment that skips the aliasing check, for destinations that do not appear
+    // transposed on the right-hand side: C.noalias() += A * 2.0 - B;
+    class NoAlias {
+    private:
+        Matrix& target;
+
+    public:
+        explicit NoAlias(Matrix& m) : target(m) {}
+
+        template <typename E>
+        Matrix& operator=(const MatrixExpr<E>& expr);
+        template <typename E>
+        Matrix& operator+=(const MatrixExpr<E>& expr);
+        template <typename E>
+        Matrix& operator-=(const MatrixExpr<E>& expr);
+    };
+
+    NoAlias noalias() { return NoAlias(*this); }
 
     // Element setters and getters
     void setElement(int i, int j, double value);
     double getElement(int i, int j) const;
 
-    // Matrix operations
-    Matrix operator+(const Matrix& other) const;
-    Matrix operator-(const Matrix& other) const;
+    // Dimensions
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    // Raw row access for kernels; each row is getCols() contiguous doubles
+    double* rowData(int i) { dropLUCache(); return &at(i, 0); }
+    const double* rowData(int i) const { return &at(i, 0); }
+    // Doubles from one row to the next. Parallel bodies take rowData(0) once before the
+    // loop and index with this, since the mutable rowData() resets the LU cache.
+    std::size_t rowStride() const { return stride; }
+
+    // Expression-template hooks: unchecked element access and aliasing queries
+    double operator()(int i, int j) const { return at(i, j); }
+    bool references(const Matrix* m) const { return this == m; }
+    bool transposedAlias(const Matrix*) const { return false; }
+
+    // Matrix operations. Addition, subtraction and scaling are lazy (see MatrixExpr.h);
+    // multiplication evaluates immediately.
     Matrix operator*(const Matrix& other) const;
 
-    Matrix transpose() const;
+    MatrixTranspose<Matrix> transpose() const { return MatrixTranspose<Matrix>(*this); }
     double determinant() const;
     Matrix adjoint() const;
     Matrix inverse() const;
 
+    // Solve Ax = b (or AX = B) from the cached LU factors, without forming the inverse
+    std::vector<double> solve(const std::vector<double>& b) const;
+    Matrix solve(const Matrix& b) const;
+
     // Row echelon form and rank
     Matrix rowEchelon() const;
     int rank() const;
@@ -40,11 +133,111 @@ public:
     // Display matrix
     void display() const;
 
-    // Trace and eigenvalue methods (for 2x2 matrices)
+    // Parallel execution: operations whose work (elements touched, or multiply-adds for
+    // operator*) reaches the threshold are split into tiles and run on the shared
+    // ThreadPool. A thread count of 0 selects the hardware concurrency.
+    static void setThreadCount(int threads);
+    static int threadCount();
+    static void setParallelThreshold(std::size_t work);
+    static std::size_t parallelThreshold();
+
+    // Split [0, rows) into bands and call body(begin, end) for each, on the thread pool
+    // when work reaches the parallel threshold
+    static void forEachRowBand(int rows, std::size_t work, const std::function<void(int, int)>& body);
+
+    // Trace and eigen decomposition (see EigenSolver for the algorithms and ordering).
+    // The characteristic polynomial det(xI - A) is returned highest degree first.
     double trace() const;
-    void characteristicPolynomial() const;
-    std::vector<double> eigenvalues() const;
-    std::vector<std::vector<double>> eigenvectors() const;
+    std::vector<double> characteristicPolynomial() const;
+    std::vector<std::complex<double>> eigenvalues() const;
+    std::vector<std::vector<std::complex<double>>> eigenvectors() const;
 };
 
+template <typename E, typename Op>
+void Matrix::evaluateInto(const E& expr, Op op) {
+    dropLUCache();
+    forEachRowBand(rows, data.size(), [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            double* row = &at(i, 0);
+            for (int j = 0; j < cols; j++)
+                op(row[j], expr(i, j));
+        }
+    });
+}
+
+template <typename E>
+Matrix::Matrix(const MatrixExpr<E>& expr) : Matrix(expr.self().getRows(), expr.self().getCols()) {
+    evaluateInto(expr.self(), [](double& dst, double value) { dst = value; });
+}
+
+template <typename E>
+Matrix& Matrix::operator=(const MatrixExpr<E>& expr) {
+    const E& e = expr.self();
+    if (e.transposedAlias(this)) {
+        Matrix temp(e);
+        return *this = std::move(temp);
+    }
+    return noalias() = e;
+}
+
+template <typename E>
+Matrix& Matrix::operator+=(const MatrixExpr<E>& expr) {
+    const E& e = expr.self();
+    if (e.transposedAlias(this))
+        return noalias() += Matrix(e);
+    return noalias() += e;
+}
+
+template <typename E>
+Matrix& Matrix::operator-=(const MatrixExpr<E>& expr) {
+    const E& e = expr.self();
+    if (e.transposedAlias(this))
+        return noalias() -= Matrix(e);
+    return noalias() -= e;
+}
+
+template <typename E>
+Matrix& Matrix::NoAlias::operator=(const MatrixExpr<E>& expr) {
+    const E& e = expr.self();
+    if (target.rows != e.getRows() || target.cols != e.getCols())
+        target.reshape(e.getRows(), e.getCols());
+    target.evaluateInto(e, [](double& dst, double value) { dst = value; });
+    return target;
+}
+
+template <typename E>
+Matrix& Matrix::NoAlias::operator+=(const MatrixExpr<E>& expr) {
+    const E& e = expr.self();
+    if (target.rows != e.getRows() || target.cols != e.getCols())
+        throw std::invalid_argument("Matrix dimensions do not match for addition");
+    target.evaluateInto(e, [](double& dst, double value) { dst += value; });
+    return target;
+}
+
+template <typename E>
+Matrix& Matrix::NoAlias::operator-=(const MatrixExpr<E>& expr) {
+    const E& e = expr.self();
+    if (target.rows != e.getRows() || target.cols != e.getCols())
+        throw std::invalid_argument("Matrix dimensions do not match for subtraction");
+    target.evaluateInto(e, [](double& dst, double value) { dst -= value; });
+    return target;
+}
+
+// Products involving expressions evaluate their operands first
+inline const Matrix& materialize(const Matrix& m) {
+    return m;
+}
+
+template <typename E>
+Matrix materialize(const MatrixExpr<E>& e) {
+    return Matrix(e.self());
+}
+
+template <typename L, typename R>
+Matrix operator*(const MatrixExpr<L>& l, const MatrixExpr<R>& r) {
+    const Matrix& a = materialize(l.self());
+    const Matrix& b = materialize(r.self());
+    return a * b;
+}
+
 #endif // MATRIX_H
@@ -0,0 +1,257 @@
+#include "MatrixBatch.h"
+#include "FixedMatrix.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+constexpr int LANES = MatrixBatch::LANES;
+
+// The loops over lanes are independent; tell the vectorizer so, since it cannot prove
+// that the input and output blocks never overlap.
+#if defined(__clang__)
+#define BATCH_INDEPENDENT _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define BATCH_INDEPENDENT _Pragma("GCC ivdep")
+#else
+#define BATCH_INDEPENDENT
+#endif
+
+// The lane loops only vectorize once the per-lane helpers below are inlined into them
+#if defined(__GNUC__)
+#define BATCH_INLINE inline __attribute__((always_inline))
+#else
+#define BATCH_INLINE inline
+#endif
+
+// Gather lane l of an N x N block into a fixed-size matrix, and scatter it back. The
+// index sequences unroll the element loops so the loop over lanes is straight-line code.
+template <int N, std::size_t... K>
+BATCH_INLINE FixedMatrix<N, N> gather(const double* block, int l, std::index_sequence<K...>) {
+    FixedMatrix<N, N> a;
+    ((a(K / N, K % N) = block[K * LANES + l]), ...);
+    return a;
+}
+
+template <int N, std::size_t... K>
+BATCH_INLINE void scatter(const FixedMatrix<N, N>& a, double scale, double* block, int l, std::index_sequence<K...>) {
+    ((block[K * LANES + l] = a(K / N, K % N) * scale), ...);
+}
+
+// Run body(b) over every block, on the thread pool for large batches
+template <typename Body>
+void forEachBlock(int blocks, std::size_t work, Body body) {
+    Matrix::forEachRowBand(blocks, work, [&](int begin, int end) {
+        for (int b = begin; b < end; b++)
+            body(b);
+    });
+}
+
+template <int N>
+void multiplyKernel(const MatrixBatch& a, const MatrixBatch& b, MatrixBatch& result) {
+    forEachBlock(a.blockCount(), static_cast<std::size_t>(a.size()) * N * N * N, [&](int k) {
+        const double* x = a.block(k);
+        const double* y = b.block(k);
+        double* out = result.block(k);
+        BATCH_INDEPENDENT
+        for (int l = 0; l < LANES; l++) {
+            FixedMatrix<N, N> p = gather<N>(x, l, std::make_index_sequence<N * N>())
+                                * gather<N>(y, l, std::make_index_sequence<N * N>());
+            scatter<N>(p, 1.0, out, l, std::make_index_sequence<N * N>());
+        }
+    });
+}
+
+template <int N>
+void determinantKernel(const MatrixBatch& batch, double* out) {
+    forEachBlock(batch.blockCount(), static_cast<std::size_t>(batch.size()) * N * N * N, [&](int k) {
+        const double* x = batch.block(k);
+        double* det = out + static_cast<std::size_t>(k) * LANES;
+        BATCH_INDEPENDENT
+        for (int l = 0; l < LANES; l++)
+            det[l] = gather<N>(x, l, std::make_index_sequence<N * N>()).determinant();
+    });
+}
+
+template <int N>
+void inverseKernel(const MatrixBatch& batch, MatrixBatch& result) {
+    forEachBlock(batch.blockCount(), static_cast<std::size_t>(batch.size()) * N * N * N, [&](int k) {
+        const double* x = batch.block(k);
+        double* out = result.block(k);
+        BATCH_INDEPENDENT
+        for (int l = 0; l < LANES; l++) {
+            FixedMatrix<N, N> a = gather<N>(x, l, std::make_index_sequence<N * N>());
+            scatter<N>(a.adjugate(), 1.0 / a.determinant(), out, l, std::make_index_sequence<N * N>());
+        }
+    });
+}
+
+} // namespace
+
+// Constructor
+MatrixBatch::MatrixBatch(int count, int r, int c)
+    : count(count), rows(r), cols(c), blocks((count + LANES - 1) / LANES) {
+    if (count < 0 || r < 0 || c < 0)
+        throw std::invalid_argument("Batch dimensions must be non-negative");
+    data.assign(static_cast<std::size_t>(blocks) * r * c * LANES, 0.0);
+}
+
+// Give an output batch the requested shape; contents are overwritten by the caller
+void MatrixBatch::reshape(int n, int r, int c) {
+    if (n == count && r == rows && c == cols)
+        return;
+    count = n;
+    rows = r;
+    cols = c;
+    blocks = (n + LANES - 1) / LANES;
+    data.resize(static_cast<std::size_t>(blocks) * r * c * LANES);
+}
+
+// Conversion from individual matrices
+MatrixBatch MatrixBatch::fromMatrices(const std::vector<Matrix>& matrices) {
+    if (matrices.empty())
+        return MatrixBatch(0, 0, 0);
+    MatrixBatch batch(static_cast<int>(matrices.size()), matrices[0].getRows(), matrices[0].getCols());
+    for (int k = 0; k < batch.count; k++)
+        batch.set(k, matrices[k]);
+    return batch;
+}
+
+// Conversion to individual matrices
+std::vector<Matrix> MatrixBatch::toMatrices() const {
+    std::vector<Matrix> result;
+    result.reserve(count);
+    for (int k = 0; k < count; k++)
+        result.push_back(get(k));
+    return result;
+}
+
+void MatrixBatch::set(int index, const Matrix& m) {
+    if (index < 0 || index >= count)
+        throw std::out_of_range("Index out of range");
+    if (m.getRows() != rows || m.getCols() != cols)
+        throw std::invalid_argument("Matrix dimensions do not match the batch");
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            data[offset(index, i, j)] = m.rowData(i)[j];
+}
+
+Matrix MatrixBatch::get(int index) const {
+    if (index < 0 || index >= count)
+        throw std::out_of_range("Index out of range");
+    Matrix result(rows, cols);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            result.rowData(i)[j] = data[offset(index, i, j)];
+    return result;
+}
+
+// Element setters and getters
+void MatrixBatch::setElement(int index, int i, int j, double value) {
+    if (index < 0 || index >= count || i < 0 || i >= rows || j < 0 || j >= cols)
+        throw std::out_of_range("Index out of range");
+    data[offset(index, i, j)] = value;
+}
+
+double MatrixBatch::getElement(int index, int i, int j) const {
+    if (index < 0 || index >= count || i < 0 || i >= rows || j < 0 || j >= cols)
+        throw std::out_of_range("Index out of range");
+    return data[offset(index, i, j)];
+}
+
+// Pairwise multiplication. Square shapes up to 4x4 keep each product in registers;
+// other shapes accumulate one output element at a time across the lanes of a block.
+MatrixBatch MatrixBatch::operator*(const MatrixBatch& other) const {
+    MatrixBatch result(0, 0, 0);
+    multiply(other, result);
+    return result;
+}
+
+void MatrixBatch::multiply(const MatrixBatch& other, MatrixBatch& result) const {
+    if (count != other.count)
+        throw std::invalid_argument("Batch sizes do not match for multiplication");
+    if (cols != other.rows)
+        throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+    if (&result == this || &result == &other)
+        throw std::invalid_argument("Result batch must not alias an operand");
+
+    result.reshape(count, rows, other.cols);
+    if (rows == cols && cols == other.cols && rows >= 1 && rows <= 4) {
+        switch (rows) {
+        case 1: multiplyKernel<1>(*this, other, result); break;
+        case 2: multiplyKernel<2>(*this, other, result); break;
+        case 3: multiplyKernel<3>(*this, other, result); break;
+        default: multiplyKernel<4>(*this, other, result); break;
+        }
+        return;
+    }
+
+    int n = other.cols;
+    forEachBlock(blocks, static_cast<std::size_t>(count) * rows * cols * n, [&](int b) {
+        const double* x = block(b);
+        const double* y = other.block(b);
+        double* out = result.block(b);
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < n; j++) {
+                double sum[LANES] = {};
+                for (int k = 0; k < cols; k++) {
+                    const double* xa = x + (i * cols + k) * LANES;
+                    const double* yb = y + (k * n + j) * LANES;
+                    for (int l = 0; l < LANES; l++)
+                        sum[l] += xa[l] * yb[l];
+                }
+                std::copy(sum, sum + LANES, out + (i * n + j) * LANES);
+            }
+        }
+    });
+}
+
+// Transpose: only permutes the element rows of each block
+MatrixBatch MatrixBatch::transpose() const {
+    MatrixBatch result(count, cols, rows);
+    for (int b = 0; b < blocks; b++) {
+        const double* x = block(b);
+        double* out = result.block(b);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++)
+                std::copy(x + (i * cols + j) * LANES, x + (i * cols + j + 1) * LANES, out + (j * rows + i) * LANES);
+    }
+    return result;
+}
+
+// Determinants
+std::vector<double> MatrixBatch::determinant() const {
+    if (rows != cols || rows < 1 || rows > 4)
+        throw std::invalid_argument("Batched determinant supports square matrices up to 4x4");
+    std::vector<double> result(static_cast<std::size_t>(blocks) * LANES);
+    switch (rows) {
+    case 1: determinantKernel<1>(*this, result.data()); break;
+    case 2: determinantKernel<2>(*this, result.data()); break;
+    case 3: determinantKernel<3>(*this, result.data()); break;
+    default: determinantKernel<4>(*this, result.data()); break;
+    }
+    result.resize(count);
+    return result;
+}
+
+// Inverses
+MatrixBatch MatrixBatch::inverse() const {
+    MatrixBatch result(0, 0, 0);
+    inverse(result);
+    return result;
+}
+
+void MatrixBatch::inverse(MatrixBatch& result) const {
+    if (rows != cols || rows < 1 || rows > 4)
+        throw std::invalid_argument("Batched inverse supports square matrices up to 4x4");
+    if (&result == this)
+        throw std::invalid_argument("Result batch must not alias an operand");
+
+    result.reshape(count, rows, cols);
+    switch (rows) {
+    case 1: inverseKernel<1>(*this, result); break;
+    case 2: inverseKernel<2>(*this, result); break;
+    case 3: inverseKernel<3>(*this, result); break;
+    default: inverseKernel<4>(*this, result); break;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef MATRIX_BATCH_H
+#define MATRIX_BATCH_H
+
+#include <vector>
+#include <stdexcept>
+#include "AlignedAllocator.h"
+#include "Matrix.h"
+
+// A batch of same-shaped small matrices in structure-of-arrays layout. Matrices are
+// grouped in blocks of LANES; within a block, element (i, j) of all LANES matrices is
+// contiguous, so the batched kernels process one matrix per SIMD lane while addressing
+// a whole block from a single pointer. Intended for very many independent 2x2 .. 4x4
+// problems.
+class MatrixBatch {
+public:
+    static constexpr int LANES = 8;
+
+private:
+    int count, rows, cols;
+    int blocks;                 // count rounded up to whole blocks; padding lanes are scratch
+    AlignedVector<double> data; // blocks of rows * cols * LANES values
+
+    void reshape(int count, int r, int c);
+
+    std::size_t offset(int index, int i, int j) const {
+        return (static_cast<std::size_t>(index / LANES) * rows * cols + i * cols + j) * LANES + index % LANES;
+    }
+
+public:
+    // Constructor: `count` zero matrices of size r x c
+    MatrixBatch(int count, int r, int c);
+
+    // Conversion from and to individual matrices
+    static MatrixBatch fromMatrices(const std::vector<Matrix>& matrices);
+    std::vector<Matrix> toMatrices() const;
+    void set(int index, const Matrix& m);
+    Matrix get(int index) const;
+
+    // Dimensions
+    int size() const { return count; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    // Raw block access: element (i, j) of matrix b * LANES + l is block(b)[(i * cols + j) * LANES + l]
+    int blockCount() const { return blocks; }
+    double* block(int b) { return data.data() + static_cast<std::size_t>(b) * rows * cols * LANES; }
+    const double* block(int b) const { return data.data() + static_cast<std::size_t>(b) * rows * cols * LANES; }
+
+    // Element setters and getters
+    void setElement(int index, int i, int j, double value);
+    double getElement(int index, int i, int j) const;
+
+    // Pairwise products: result[k] = this[k] * other[k]. The three-argument forms write
+    // into an existing batch, reusing its storage when the shape already matches, so a
+    // per-frame loop does not allocate.
+    MatrixBatch operator*(const MatrixBatch& other) const;
+    void multiply(const MatrixBatch& other, MatrixBatch& result) const;
+
+    MatrixBatch transpose() const;
+
+    // Determinants and inverses of square batches up to 4x4. Singular matrices give
+    // non-finite inverse entries rather than an exception; check determinant() first
+    // when that matters.
+    std::vector<double> determinant() const;
+    MatrixBatch inverse() const;
+    void inverse(MatrixBatch& result) const;
+};
+
+#endif // MATRIX_BATCH_H
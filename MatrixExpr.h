@@ -0,0 +1,136 @@
+#ifndef MATRIX_EXPR_H
+#define MATRIX_EXPR_H
+
+#include <stdexcept>
+
+class Matrix;
+
+// Expression templates for Matrix arithmetic.
+//
+// A + B, A - B, s * A and transposes build lightweight expression objects instead
+// of temporary matrices; the whole expression is evaluated in one fused pass when
+// it is assigned to a Matrix. Every node provides getRows(), getCols(), element
+// access through operator()(i, j), and two aliasing queries used by Matrix to
+// decide whether it can write its result in place.
+//
+// Expression objects hold references to the Matrix operands, so they must not
+// outlive them: store results in a Matrix, not in `auto` variables.
+template <typename E>
+class MatrixExpr {
+public:
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// Matrix operands (leaves) are held by reference, nested expressions by value;
+// other leaf types specialize this as well
+template <typename E>
+struct MatrixExprStorage {
+    using type = const E;
+};
+
+template <>
+struct MatrixExprStorage<Matrix> {
+    using type = const Matrix&;
+};
+
+// Elementwise binary expression (sum or difference)
+template <typename L, typename R, typename Op>
+class MatrixBinaryExpr : public MatrixExpr<MatrixBinaryExpr<L, R, Op>> {
+private:
+    typename MatrixExprStorage<L>::type lhs;
+    typename MatrixExprStorage<R>::type rhs;
+
+public:
+    MatrixBinaryExpr(const L& l, const R& r) : lhs(l), rhs(r) {
+        if (l.getRows() != r.getRows() || l.getCols() != r.getCols())
+            throw std::invalid_argument(Op::mismatchMessage());
+    }
+
+    int getRows() const { return lhs.getRows(); }
+    int getCols() const { return lhs.getCols(); }
+    double operator()(int i, int j) const { return Op::apply(lhs(i, j), rhs(i, j)); }
+
+    bool references(const Matrix* m) const { return lhs.references(m) || rhs.references(m); }
+    bool transposedAlias(const Matrix* m) const { return lhs.transposedAlias(m) || rhs.transposedAlias(m); }
+};
+
+struct MatrixAddOp {
+    static double apply(double a, double b) { return a + b; }
+    static const char* mismatchMessage() { return "Matrix dimensions do not match for addition"; }
+};
+
+struct MatrixSubtractOp {
+    static double apply(double a, double b) { return a - b; }
+    static const char* mismatchMessage() { return "Matrix dimensions do not match for subtraction"; }
+};
+
+template <typename L, typename R>
+using MatrixSum = MatrixBinaryExpr<L, R, MatrixAddOp>;
+
+template <typename L, typename R>
+using MatrixDifference = MatrixBinaryExpr<L, R, MatrixSubtractOp>;
+
+// Scalar multiple
+template <typename E>
+class MatrixScaled : public MatrixExpr<MatrixScaled<E>> {
+private:
+    typename MatrixExprStorage<E>::type operand;
+    double scalar;
+
+public:
+    MatrixScaled(const E& e, double s) : operand(e), scalar(s) {}
+
+    int getRows() const { return operand.getRows(); }
+    int getCols() const { return operand.getCols(); }
+    double operator()(int i, int j) const { return scalar * operand(i, j); }
+
+    bool references(const Matrix* m) const { return operand.references(m); }
+    bool transposedAlias(const Matrix* m) const { return operand.transposedAlias(m); }
+};
+
+// Transpose. Writing A^T into A itself would read elements that were already
+// overwritten, so a transpose of the destination forces a temporary.
+template <typename E>
+class MatrixTranspose : public MatrixExpr<MatrixTranspose<E>> {
+private:
+    typename MatrixExprStorage<E>::type operand;
+
+public:
+    explicit MatrixTranspose(const E& e) : operand(e) {}
+
+    const E& nested() const { return operand; }
+
+    int getRows() const { return operand.getCols(); }
+    int getCols() const { return operand.getRows(); }
+    double operator()(int i, int j) const { return operand(j, i); }
+
+    bool references(const Matrix* m) const { return operand.references(m); }
+    bool transposedAlias(const Matrix* m) const { return operand.references(m); }
+};
+
+template <typename L, typename R>
+MatrixSum<L, R> operator+(const MatrixExpr<L>& l, const MatrixExpr<R>& r) {
+    return MatrixSum<L, R>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+MatrixDifference<L, R> operator-(const MatrixExpr<L>& l, const MatrixExpr<R>& r) {
+    return MatrixDifference<L, R>(l.self(), r.self());
+}
+
+template <typename E>
+MatrixScaled<E> operator*(const MatrixExpr<E>& e, double scalar) {
+    return MatrixScaled<E>(e.self(), scalar);
+}
+
+template <typename E>
+MatrixScaled<E> operator*(double scalar, const MatrixExpr<E>& e) {
+    return MatrixScaled<E>(e.self(), scalar);
+}
+
+template <typename E>
+MatrixTranspose<E> transpose(const MatrixExpr<E>& e) {
+    return MatrixTranspose<E>(e.self());
+}
+
+#endif // MATRIX_EXPR_H
@@ -0,0 +1,97 @@
+#include "NumberTheory.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace numbertheory {
+
+namespace {
+
+// Arrays at least this long are split into tasks of TASK_VALUES values
+constexpr std::size_t PARALLEL_VALUES = std::size_t(1) << 16;
+constexpr std::size_t TASK_VALUES = std::size_t(1) << 14;
+
+int taskCount(std::size_t n) {
+    return static_cast<int>((n + TASK_VALUES - 1) / TASK_VALUES);
+}
+
+bool runSerially(std::size_t n) {
+    return n < PARALLEL_VALUES || ThreadPool::instance().threadCount() <= 1;
+}
+
+// Calls run(begin, end) over consecutive ranges that cover [0, n)
+template <typename Run>
+void forEachRange(std::size_t n, Run run) {
+    if (runSerially(n)) {
+        run(0, n);
+        return;
+    }
+    ThreadPool::instance().parallelFor(taskCount(n), [&](int t) {
+        std::size_t begin = static_cast<std::size_t>(t) * TASK_VALUES;
+        run(begin, std::min(n, begin + TASK_VALUES));
+    });
+}
+
+void checkSizes(std::size_t a, std::size_t b, std::size_t out) {
+    if (a != b || a != out) {
+        throw std::invalid_argument("Error: Array sizes do not match.");
+    }
+}
+
+} // namespace
+
+std::uint64_t gcd(std::span<const std::uint64_t> values) {
+    // Every task shares the running result, so a 1 found anywhere ends the others early
+    std::atomic<std::uint64_t> result{0};
+    forEachRange(values.size(), [&](std::size_t begin, std::size_t end) {
+        std::uint64_t g = 0;
+        for (std::size_t i = begin; i < end && result.load(std::memory_order_relaxed) != 1; i++) {
+            g = gcd64(g, values[i]);
+            if (g == 1)
+                break;
+        }
+        std::uint64_t current = result.load(std::memory_order_relaxed);
+        while (!result.compare_exchange_weak(current, gcd64(current, g), std::memory_order_relaxed)) {
+        }
+    });
+    return result.load();
+}
+
+std::uint64_t lcm(std::span<const std::uint64_t> values) {
+    if (runSerially(values.size())) {
+        std::uint64_t l = 1;
+        for (std::uint64_t v : values)
+            l = lcm64(l, v);
+        return l;
+    }
+    std::vector<std::uint64_t> partial(taskCount(values.size()), 1);
+    forEachRange(values.size(), [&](std::size_t begin, std::size_t end) {
+        std::uint64_t l = 1;
+        for (std::size_t i = begin; i < end; i++)
+            l = lcm64(l, values[i]);
+        partial[begin / TASK_VALUES] = l;
+    });
+    std::uint64_t l = 1;
+    for (std::uint64_t p : partial)
+        l = lcm64(l, p);
+    return l;
+}
+
+void gcd(std::span<const std::uint64_t> a, std::span<const std::uint64_t> b, std::span<std::uint64_t> out) {
+    checkSizes(a.size(), b.size(), out.size());
+    forEachRange(a.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            out[i] = gcd64(a[i], b[i]);
+    });
+}
+
+void lcm(std::span<const std::uint64_t> a, std::span<const std::uint64_t> b, std::span<std::uint64_t> out) {
+    checkSizes(a.size(), b.size(), out.size());
+    forEachRange(a.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            out[i] = lcm64(a[i], b[i]);
+    });
+}
+
+} // namespace numbertheory
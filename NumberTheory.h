@@ -0,0 +1,129 @@
+#ifndef NUMBER_THEORY_H
+#define NUMBER_THEORY_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+// Greatest common divisors and least common multiples of unsigned 64- and 128-bit
+// integers.
+//
+// gcd uses Stein's binary algorithm: common factors of two are removed with a single
+// count-trailing-zeros, and each step of the loop is a subtraction and a shift rather
+// than a division. 128-bit operands move to the 64-bit loop once both fit, after one
+// division if only one does. lcm divides by the gcd before multiplying and throws
+// std::overflow_error when the result itself does not fit. gcd(0, 0) == 0 and
+// lcm(0, x) == 0.
+namespace numbertheory {
+
+namespace detail {
+
+// |v| for any long long, LLONG_MIN included
+constexpr std::uint64_t unsignedAbs(long long v) {
+    return v < 0 ? 0ULL - static_cast<std::uint64_t>(v) : static_cast<std::uint64_t>(v);
+}
+
+constexpr int countTrailingZeros(unsigned __int128 v) {
+    std::uint64_t low = static_cast<std::uint64_t>(v);
+    return low != 0 ? std::countr_zero(low) : 64 + std::countr_zero(static_cast<std::uint64_t>(v >> 64));
+}
+
+} // namespace detail
+
+constexpr std::uint64_t gcd64(std::uint64_t a, std::uint64_t b) {
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+    // Subtraction removes about one bit per pass, so a much smaller operand is first
+    // brought into range with one division
+    int aWidth = std::bit_width(a), bWidth = std::bit_width(b);
+    if (aWidth > bWidth + 16) {
+        a %= b;
+        if (a == 0)
+            return b;
+    } else if (bWidth > aWidth + 16) {
+        b %= a;
+        if (b == 0)
+            return a;
+    }
+    int az = std::countr_zero(a), bz = std::countr_zero(b);
+    int shift = std::min(az, bz);
+    b >>= bz;
+    // b stays odd and a is shifted odd, so |b - a| is even and each pass removes at
+    // least one bit. The trailing zeros of b - a are those of |b - a|, so counting them
+    // overlaps with the selects, which compile without branches.
+    while (a != 0) {
+        a >>= az;
+        std::uint64_t difference = b - a;
+        az = std::countr_zero(difference);
+        std::uint64_t distance = b < a ? a - b : difference;
+        b = std::min(a, b);
+        a = distance;
+    }
+    return b << shift;
+}
+
+constexpr unsigned __int128 gcd128(unsigned __int128 a, unsigned __int128 b) {
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+    // Once one operand fits in 64 bits, a single division brings the other down too
+    constexpr unsigned __int128 WORD = static_cast<unsigned __int128>(1) << 64;
+    if (a < WORD && b < WORD)
+        return gcd64(static_cast<std::uint64_t>(a), static_cast<std::uint64_t>(b));
+    if (a < WORD)
+        return gcd64(static_cast<std::uint64_t>(a), static_cast<std::uint64_t>(b % a));
+    if (b < WORD)
+        return gcd64(static_cast<std::uint64_t>(a % b), static_cast<std::uint64_t>(b));
+    int az = detail::countTrailingZeros(a), bz = detail::countTrailingZeros(b);
+    int shift = std::min(az, bz);
+    b >>= bz;
+    while (a != 0) {
+        a >>= az;
+        if ((a | b) < WORD)
+            return static_cast<unsigned __int128>(gcd64(static_cast<std::uint64_t>(a), static_cast<std::uint64_t>(b))) << shift;
+        unsigned __int128 difference = b - a;
+        az = detail::countTrailingZeros(difference);
+        unsigned __int128 distance = b < a ? a - b : difference;
+        b = std::min(a, b);
+        a = distance;
+    }
+    return b << shift;
+}
+
+constexpr std::uint64_t lcm64(std::uint64_t a, std::uint64_t b) {
+    if (a == 0 || b == 0)
+        return 0;
+    std::uint64_t result;
+    if (__builtin_mul_overflow(a / gcd64(a, b), b, &result))
+        throw std::overflow_error("Error: Least common multiple exceeds 64 bits.");
+    return result;
+}
+
+constexpr unsigned __int128 lcm128(unsigned __int128 a, unsigned __int128 b) {
+    if (a == 0 || b == 0)
+        return 0;
+    unsigned __int128 result;
+    if (__builtin_mul_overflow(a / gcd128(a, b), b, &result))
+        throw std::overflow_error("Error: Least common multiple exceeds 128 bits.");
+    return result;
+}
+
+// Reductions over a whole array: gcd of all values (0 for an empty array) and lcm of
+// all values (1 for an empty array). Large arrays are split across the thread pool;
+// the gcd stops early once it reaches 1.
+std::uint64_t gcd(std::span<const std::uint64_t> values);
+std::uint64_t lcm(std::span<const std::uint64_t> values);
+
+// Elementwise: out[i] = gcd(a[i], b[i]) and out[i] = lcm(a[i], b[i]). All three spans
+// have the same length; out may be a or b itself.
+void gcd(std::span<const std::uint64_t> a, std::span<const std::uint64_t> b, std::span<std::uint64_t> out);
+void lcm(std::span<const std::uint64_t> a, std::span<const std::uint64_t> b, std::span<std::uint64_t> out);
+
+} // namespace numbertheory
+
+#endif // NUMBER_THEORY_H
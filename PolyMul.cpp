@@ -0,0 +1,174 @@
+#include "PolyMul.h"
+#include "FFT.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace polymul {
+
+namespace {
+
+using Complex = std::complex<double>;
+
+// out[0 .. na + nb - 1) = a * b
+void schoolbook(const double* a, int na, const double* b, int nb, double* out) {
+    std::fill(out, out + na + nb - 1, 0.0);
+    for (int i = 0; i < na; i++) {
+        double ai = a[i];
+        double* row = out + i;
+        for (int j = 0; j < nb; j++)
+            row[j] += ai * b[j];
+    }
+}
+
+// out[0 .. 2n - 1) = a * b for two n-coefficient operands. Scratch needs 8n doubles.
+void karatsuba(const double* a, const double* b, int n, double* out, double* scratch) {
+    if (n <= KARATSUBA_THRESHOLD) {
+        schoolbook(a, n, b, n, out);
+        return;
+    }
+    int h = n / 2;      // low half
+    int hh = n - h;     // high half, hh >= h
+    double* sa = scratch;
+    double* sb = sa + hh;
+    double* mid = sb + hh;
+    double* next = mid + 2 * hh;
+
+    // low * low in out[0 .. 2h - 1), high * high in out[2h .. 2n - 1)
+    karatsuba(a, b, h, out, next);
+    out[2 * h - 1] = 0.0;
+    karatsuba(a + h, b + h, hh, out + 2 * h, next);
+
+    // (low + high)(low + high) - low * low - high * high, added at offset h
+    for (int i = 0; i < hh; i++) {
+        sa[i] = a[h + i] + (i < h ? a[i] : 0.0);
+        sb[i] = b[h + i] + (i < h ? b[i] : 0.0);
+    }
+    karatsuba(sa, sb, hh, mid, next);
+    for (int i = 0; i < 2 * h - 1; i++)
+        mid[i] -= out[i];
+    for (int i = 0; i < 2 * hh - 1; i++)
+        mid[i] -= out[2 * h + i];
+    for (int i = 0; i < 2 * hh - 1; i++)
+        out[h + i] += mid[i];
+}
+
+// Unbalanced operands: multiply the longer one in chunks the size of the shorter.
+template <typename Kernel>
+std::vector<double> chunked(const std::vector<double>& a, const std::vector<double>& b, Kernel kernel) {
+    const std::vector<double>& longer = a.size() >= b.size() ? a : b;
+    const std::vector<double>& shorter = a.size() >= b.size() ? b : a;
+    int n = static_cast<int>(shorter.size());
+    int nl = static_cast<int>(longer.size());
+
+    std::vector<double> result(nl + n - 1, 0.0);
+    std::vector<double> chunk(n), product(2 * n - 1);
+    for (int off = 0; off < nl; off += n) {
+        int len = std::min(n, nl - off);
+        std::copy(longer.begin() + off, longer.begin() + off + len, chunk.begin());
+        std::fill(chunk.begin() + len, chunk.end(), 0.0);
+        kernel(chunk.data(), shorter.data(), n, product.data());
+        int valid = std::min(2 * n - 1, nl + n - 1 - off);
+        for (int i = 0; i < valid; i++)
+            result[off + i] += product[i];
+    }
+    return result;
+}
+
+// Plain complex product; std::complex's operator* adds NaN/Inf recovery calls at -O2.
+inline Complex mul(Complex x, Complex y) {
+    return Complex(x.real() * y.real() - x.imag() * y.imag(), x.real() * y.imag() + x.imag() * y.real());
+}
+
+// Smallest n >= minimum whose prime factors are all 2, 3 or 5; those lengths run as
+// pure Stockham passes and waste far less padding than the next power of two.
+int smoothSize(int minimum) {
+    int best = 1;
+    while (best < minimum)
+        best <<= 1;
+    for (long long p5 = 1; p5 < best; p5 *= 5) {
+        for (long long p35 = p5; p35 < best; p35 *= 3) {
+            long long n = p35;
+            while (n < minimum)
+                n <<= 1;
+            best = static_cast<int>(std::min<long long>(best, n));
+        }
+    }
+    return best;
+}
+
+double maxAbs(const std::vector<double>& v) {
+    double m = 0.0;
+    for (double x : v)
+        m = std::max(m, std::abs(x));
+    return m;
+}
+
+} // namespace
+
+std::vector<double> multiplySchoolbook(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty())
+        return {};
+    std::vector<double> result(a.size() + b.size() - 1);
+    schoolbook(a.data(), static_cast<int>(a.size()), b.data(), static_cast<int>(b.size()), result.data());
+    return result;
+}
+
+std::vector<double> multiplyKaratsuba(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty())
+        return {};
+    std::vector<double> scratch(8 * std::min(a.size(), b.size()) + 64);
+    return chunked(a, b, [&](const double* x, const double* y, int n, double* out) {
+        karatsuba(x, y, n, out, scratch.data());
+    });
+}
+
+std::vector<double> multiplyFFT(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.empty() || b.empty())
+        return {};
+    int resultSize = static_cast<int>(a.size() + b.size() - 1);
+    int n = smoothSize(resultSize);
+    std::shared_ptr<const FFTPlan> plan = FFTPlan::get(n);
+
+    // Balance magnitudes so neither operand drowns in the other's rounding error.
+    double scaleA = maxAbs(a), scaleB = maxAbs(b);
+    if (scaleA == 0.0 || scaleB == 0.0)
+        return std::vector<double>(resultSize, 0.0);
+    double ratio = scaleA / scaleB;
+
+    // One complex transform of a + i * ratio * b carries both spectra:
+    // A[k] = (Z[k] + conj(Z[-k])) / 2 and B[k] = (Z[k] - conj(Z[-k])) / 2i,
+    // so A[k] * B[k] = (Z[k]^2 - conj(Z[-k])^2) / 4i.
+    std::vector<Complex> z(n);
+    for (std::size_t i = 0; i < a.size(); i++)
+        z[i].real(a[i]);
+    for (std::size_t i = 0; i < b.size(); i++)
+        z[i].imag(b[i] * ratio);
+    plan->forward(z.data());
+
+    std::vector<Complex> product(n);
+    for (int k = 0; k < n; k++) {
+        Complex zk = z[k];
+        Complex zm = std::conj(z[k == 0 ? 0 : n - k]);
+        Complex d = mul(zk, zk) - mul(zm, zm);
+        product[k] = Complex(d.imag() * 0.25, -d.real() * 0.25); // d / 4i
+    }
+    plan->inverse(product.data());
+
+    std::vector<double> result(resultSize);
+    double unscale = 1.0 / ratio;
+    for (int i = 0; i < resultSize; i++)
+        result[i] = product[i].real() * unscale;
+    return result;
+}
+
+std::vector<double> multiply(const std::vector<double>& a, const std::vector<double>& b) {
+    std::size_t shorter = std::min(a.size(), b.size());
+    if (shorter <= static_cast<std::size_t>(KARATSUBA_THRESHOLD))
+        return multiplySchoolbook(a, b);
+    if (shorter <= static_cast<std::size_t>(FFT_THRESHOLD))
+        return multiplyKaratsuba(a, b);
+    return multiplyFFT(a, b);
+}
+
+} // namespace polymul
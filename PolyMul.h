@@ -0,0 +1,36 @@
+#ifndef POLY_MUL_H
+#define POLY_MUL_H
+
+#include <vector>
+
+// Polynomial (linear convolution) multiply kernels behind Polynomial::operator*.
+// Coefficient order does not matter as long as both operands use the same one; the
+// result has a.size() + b.size() - 1 coefficients in that order.
+namespace polymul {
+
+// Crossovers on the shorter operand's coefficient count: schoolbook up to
+// KARATSUBA_THRESHOLD, Karatsuba up to FFT_THRESHOLD, FFT beyond. Measured with
+// bench/PolyMulBench on x86-64 at -O2, where the FFT overtakes Karatsuba between 64 and
+// 80 coefficients (3.0 vs 4.1 us at 80, 5.9 vs 7.6 us at 128).
+constexpr int KARATSUBA_THRESHOLD = 32;
+constexpr int FFT_THRESHOLD = 64;
+
+// Size-dispatched product.
+std::vector<double> multiply(const std::vector<double>& a, const std::vector<double>& b);
+
+// Individual algorithms, kept for verification and tuning.
+std::vector<double> multiplySchoolbook(const std::vector<double>& a, const std::vector<double>& b);
+std::vector<double> multiplyKaratsuba(const std::vector<double>& a, const std::vector<double>& b);
+
+// Floating-point FFT convolution. Both operands are packed into one complex transform
+// of the smallest length N >= a.size() + b.size() - 1 with no prime factor above 5,
+// with b rescaled to a's magnitude first. Every result coefficient then satisfies
+//     |computed - exact| <= ||a||_2 * ||b||_2 * eps * (3 * log2(N) + 8)
+// with eps = 2^-53. The bound is absolute: coefficients much smaller than
+// ||a||_2 * ||b||_2 lose relative accuracy, so use the schoolbook product when
+// exact integer or tiny coefficients matter.
+std::vector<double> multiplyFFT(const std::vector<double>& a, const std::vector<double>& b);
+
+} // namespace polymul
+
+#endif // POLY_MUL_H
@@ -1,46 +1,332 @@
 #include "Polynomial.h"
+#include "PolyMul.h"
+#include "ThreadPool.h"
+#include "EigenSolver.h"
+#include <algorithm>
 #include <iomanip>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POLYNOMIAL_HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Points evaluated together by one Horner sweep over the coefficients. Enough
+// independent accumulators to hide the multiply-add latency.
+constexpr int EVAL_BLOCK = 32;
+
+// Points per thread-pool task, and the minimum points * coefficients worth splitting.
+constexpr std::size_t EVAL_TASK_POINTS = 8192;
+constexpr std::size_t PARALLEL_EVAL_WORK = std::size_t(1) << 18;
+
+using HornerKernel = void (*)(const double* c, int degree, const double* x, double* out);
+
+// Portable kernel; the fixed-size lane loop is vectorized by the compiler.
+void hornerBlockGeneric(const double* c, int degree, const double* x, double* out) {
+    double xs[EVAL_BLOCK], acc[EVAL_BLOCK];
+    for (int l = 0; l < EVAL_BLOCK; l++) {
+        xs[l] = x[l];
+        acc[l] = c[0];
+    }
+    for (int k = 1; k <= degree; k++) {
+        double ck = c[k];
+        for (int l = 0; l < EVAL_BLOCK; l++)
+            acc[l] = acc[l] * xs[l] + ck;
+    }
+    std::copy(acc, acc + EVAL_BLOCK, out);
+}
+
+#ifdef POLYNOMIAL_HAVE_X86_DISPATCH
+// AVX2/FMA kernel: the 32 points and their accumulators live in sixteen ymm registers.
+__attribute__((target("avx2,fma")))
+void hornerBlockAvx2(const double* c, int degree, const double* x, double* out) {
+    __m256d x0 = _mm256_loadu_pd(x), x1 = _mm256_loadu_pd(x + 4);
+    __m256d x2 = _mm256_loadu_pd(x + 8), x3 = _mm256_loadu_pd(x + 12);
+    __m256d x4 = _mm256_loadu_pd(x + 16), x5 = _mm256_loadu_pd(x + 20);
+    __m256d x6 = _mm256_loadu_pd(x + 24), x7 = _mm256_loadu_pd(x + 28);
+    __m256d a0 = _mm256_broadcast_sd(c);
+    __m256d a1 = a0, a2 = a0, a3 = a0, a4 = a0, a5 = a0, a6 = a0, a7 = a0;
+
+    for (int k = 1; k <= degree; k++) {
+        __m256d ck = _mm256_broadcast_sd(c + k);
+        a0 = _mm256_fmadd_pd(a0, x0, ck);
+        a1 = _mm256_fmadd_pd(a1, x1, ck);
+        a2 = _mm256_fmadd_pd(a2, x2, ck);
+        a3 = _mm256_fmadd_pd(a3, x3, ck);
+        a4 = _mm256_fmadd_pd(a4, x4, ck);
+        a5 = _mm256_fmadd_pd(a5, x5, ck);
+        a6 = _mm256_fmadd_pd(a6, x6, ck);
+        a7 = _mm256_fmadd_pd(a7, x7, ck);
+    }
+
+    _mm256_storeu_pd(out, a0);
+    _mm256_storeu_pd(out + 4, a1);
+    _mm256_storeu_pd(out + 8, a2);
+    _mm256_storeu_pd(out + 12, a3);
+    _mm256_storeu_pd(out + 16, a4);
+    _mm256_storeu_pd(out + 20, a5);
+    _mm256_storeu_pd(out + 24, a6);
+    _mm256_storeu_pd(out + 28, a7);
+}
+#endif
+
+HornerKernel selectHornerKernel() {
+#ifdef POLYNOMIAL_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return hornerBlockAvx2;
+#endif
+    return hornerBlockGeneric;
+}
+
+// Polynomials solved per thread-pool task in findRootsBatch()
+constexpr int ROOT_BATCH_TASK = 16;
+
+// Complex product without the NaN/Inf recovery calls of std::complex's operator*
+inline std::complex<double> mul(std::complex<double> x, std::complex<double> y) {
+    return {x.real() * y.real() - x.imag() * y.imag(), x.real() * y.imag() + x.imag() * y.real()};
+}
+
+// 1 / z, likewise without the overflow-guarded library division
+inline std::complex<double> reciprocal(std::complex<double> z) {
+    double scale = 1.0 / (z.real() * z.real() + z.imag() * z.imag());
+    return {z.real() * scale, -z.imag() * scale};
+}
+
+// Newton correction p(z) / p'(z) for the n-th degree c (highest first), and whether
+// |p(z)| is within the rounding error of its evaluation. For |z| > 1 the reversed
+// polynomial is evaluated at 1 / z instead, which keeps Horner's rule from overflowing
+// at high degree.
+std::complex<double> newtonCorrection(const std::vector<double>& c, std::complex<double> z, bool& small) {
+    int n = static_cast<int>(c.size()) - 1;
+    bool reversed = std::norm(z) > 1.0;
+    std::complex<double> y = reversed ? reciprocal(z) : z;
+    double ay = std::sqrt(std::norm(y));
+
+    std::complex<double> p = reversed ? c[n] : c[0];
+    std::complex<double> dp = 0.0;
+    double bound = std::abs(p.real());
+    for (int k = 1; k <= n; k++) {
+        double ck = reversed ? c[n - k] : c[k];
+        dp = mul(dp, y) + p;
+        p = mul(p, y) + ck;
+        bound = bound * ay + std::abs(ck);
+    }
+    double tolerance = 4.0 * n * std::numeric_limits<double>::epsilon() * bound;
+    small = std::norm(p) <= tolerance * tolerance;
+    if (!reversed)
+        return mul(p, reciprocal(dp));
+    return mul(mul(z, p), reciprocal(static_cast<double>(n) * p - mul(y, dp)));
+}
+
+// Polynomials of degree at most this in the quotient or divisor use long division; above
+// it, the quotient comes from a Newton-iteration reciprocal and fast multiplication.
+constexpr int LONG_DIVISION_THRESHOLD = 640;
+
+// Subproduct-tree nodes with at most this many points are evaluated by Horner's rule.
+constexpr int MULTIPOINT_LEAF = 32;
+
+// Multipoint evaluation keeps the error bound of each result within this multiple of
+// the bound n eps sum |c_k| |x|^k that Horner's rule guarantees for p itself.
+constexpr double MULTIPOINT_ERROR_LIMIT = 16.0;
+
+double largestMagnitude(const std::vector<double>& c) {
+    double m = 0.0;
+    for (double v : c)
+        m = std::max(m, std::abs(v));
+    return m;
+}
+
+// sum |c_k| rho^k for highest-first coefficients: bounds |c(x)| for |x| <= rho, and
+// scales the rounding error of Horner's rule on c there
+double absoluteAt(const std::vector<double>& c, double rho) {
+    double s = 0.0;
+    for (double v : c)
+        s = s * rho + std::abs(v);
+    return s;
+}
+
+// sum of rho^k for k < count: turns a per-coefficient error into one on values at |x| <= rho
+double powerSum(double rho, std::size_t count) {
+    if (rho == 1.0)
+        return static_cast<double>(count);
+    return (1.0 - std::pow(rho, static_cast<double>(count))) / (1.0 - rho);
+}
+
+// Bound on the error of the values of polymul::multiply(a, b) at |x| <= rho, from the
+// algorithm it picks. Schoolbook error is componentwise, n eps (|a| * |b|). Karatsuba's
+// sums mix coefficients of different powers, so each of its coefficients is only held
+// to n eps ||a||_1 ||b||_1. The FFT bound is the absolute one documented in PolyMul.h,
+// ||a||_2 ||b||_2 eps (3 log2 N + 8). Per-coefficient bounds are summed over rho^k.
+double productError(const std::vector<double>& a, const std::vector<double>& b, double rho) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    std::size_t shorter = std::min(a.size(), b.size());
+    std::size_t length = a.size() + b.size() - 1;
+    if (shorter <= static_cast<std::size_t>(polymul::KARATSUBA_THRESHOLD))
+        return eps * static_cast<double>(shorter) * absoluteAt(a, rho) * absoluteAt(b, rho);
+    if (shorter <= static_cast<std::size_t>(polymul::FFT_THRESHOLD))
+        return eps * static_cast<double>(shorter) * absoluteAt(a, 1.0) * absoluteAt(b, 1.0) * powerSum(rho, length);
+    double na = 0.0, nb = 0.0;
+    for (double v : a)
+        na += v * v;
+    for (double v : b)
+        nb += v * v;
+    return std::sqrt(na * nb) * eps * (3.0 * std::log2(static_cast<double>(length)) + 8.0) * powerSum(rho, length);
+}
+
+// Drop leading coefficients that are zero (or at most tolerance in magnitude), keeping
+// at least one.
+void trimLeading(std::vector<double>& c, double tolerance = 0.0) {
+    std::size_t first = 0;
+    while (first + 1 < c.size() && std::abs(c[first]) <= tolerance)
+        ++first;
+    c.erase(c.begin(), c.begin() + first);
+}
+
+// a + sign * b for highest-first coefficient lists of any lengths, aligned at the
+// constant term; leading zeros of the result are trimmed.
+std::vector<double> addAligned(const std::vector<double>& a, const std::vector<double>& b, double sign) {
+    std::vector<double> c(std::max(a.size(), b.size()), 0.0);
+    std::size_t offsetA = c.size() - a.size(), offsetB = c.size() - b.size();
+    for (std::size_t i = 0; i < a.size(); ++i)
+        c[offsetA + i] += a[i];
+    for (std::size_t i = 0; i < b.size(); ++i)
+        c[offsetB + i] += sign * b[i];
+    trimLeading(c);
+    return c;
+}
+
+// Power series inverse: g with f * g = 1 mod x^k, where f is read lowest order first
+// (which for highest-first coefficients is the reversed polynomial). Newton doubling
+// g <- g (2 - f g) mod x^2l.
+std::vector<double> seriesInverse(const std::vector<double>& f, int k) {
+    std::vector<double> g{1.0 / f[0]};
+    for (int l = 1; l < k;) {
+        int next = std::min(2 * l, k);
+        std::vector<double> head(f.begin(), f.begin() + std::min<std::size_t>(next, f.size()));
+        std::vector<double> e = polymul::multiply(head, g);
+        e.resize(next);
+        for (double& v : e)
+            v = -v;
+        e[0] += 2.0;
+        g = polymul::multiply(g, e);
+        g.resize(next);
+        l = next;
+    }
+    return g;
+}
+
+// a = q * b + r for highest-first coefficients, b[0] != 0 and a.size() >= b.size().
+// r has b.size() - 1 coefficients (at least one). If dropped is given, it receives the
+// leading q.size() coefficients of a - q * b as computed, which the division discards
+// and which exact arithmetic would make zero.
+void divideCoefficients(const std::vector<double>& a, const std::vector<double>& b,
+                        std::vector<double>& q, std::vector<double>& r,
+                        std::vector<double>* dropped = nullptr) {
+    int n = static_cast<int>(a.size()) - 1;
+    int m = static_cast<int>(b.size()) - 1;
+    int k = n - m + 1; // quotient length
+
+    if (std::min(k, m) <= LONG_DIVISION_THRESHOLD) {
+        std::vector<double> work(a);
+        q.assign(k, 0.0);
+        double lead = 1.0 / b[0];
+        for (int i = 0; i < k; i++) {
+            double t = work[i] * lead;
+            q[i] = t;
+            if (dropped)
+                dropped->push_back(std::fma(-t, b[0], work[i]));
+            for (int j = 1; j <= m; j++)
+                work[i + j] -= t * b[j];
+        }
+        r.assign(work.begin() + k, work.end());
+    } else {
+        // Reversal turns division into power series inversion: the first k
+        // coefficients of rev(a) / rev(b) are rev(q), and stored highest-first
+        // vectors already are the reversed polynomials.
+        std::vector<double> head(a.begin(), a.begin() + k);
+        q = polymul::multiply(head, seriesInverse(b, k));
+        q.resize(k);
+        std::vector<double> qb = polymul::multiply(q, b);
+        r.resize(m);
+        for (int i = 0; i < m; i++)
+            r[i] = a[k + i] - qb[k + i];
+        if (dropped) {
+            for (int i = 0; i < k; i++)
+                dropped->push_back(a[i] - qb[i]);
+        }
+    }
+    if (r.empty())
+        r.push_back(0.0);
+}
+
+double horner(const double* c, int degree, double x) {
+    double result = c[0];
+    for (int k = 1; k <= degree; k++)
+        result = result * x + c[k];
+    return result;
+}
+
+} // namespace
 
 Polynomial::Polynomial(int degree, const std::vector<double>& coefficients) : degree(degree), coeffs(coefficients) {
-    if (degree < 2 || degree > 3) {
-        throw std::invalid_argument("Only 2nd and 3rd degree polynomials are supported.");
+    if (degree < 0) {
+        throw std::invalid_argument("Polynomial degree must be non-negative.");
     }
-    if (coeffs.size() != degree + 1) {
+    if (coeffs.size() != static_cast<std::size_t>(degree) + 1) {
         throw std::invalid_argument("Coefficient size must match polynomial degree + 1.");
     }
 }
 
-Polynomial Polynomial::operator+(const Polynomial& other) const {
-    if (degree != other.degree) {
-        throw std::invalid_argument("Polynomials must have the same degree for addition.");
+double Polynomial::evaluate(double x) const {
+    return horner(coeffs.data(), degree, x);
+}
+
+void Polynomial::evaluate(std::span<const double> xs, std::span<double> out) const {
+    if (xs.size() != out.size()) {
+        throw std::invalid_argument("Input and output sizes must match for evaluation.");
     }
-    std::vector<double> result_coeffs(degree + 1);
-    for (int i = 0; i <= degree; ++i) {
-        result_coeffs[i] = coeffs[i] + other.coeffs[i];
+    static const HornerKernel kernel = selectHornerKernel();
+    const double* c = coeffs.data();
+
+    auto evaluateRange = [&](std::size_t begin, std::size_t end) {
+        std::size_t i = begin;
+        for (; i + EVAL_BLOCK <= end; i += EVAL_BLOCK)
+            kernel(c, degree, xs.data() + i, out.data() + i);
+        for (; i < end; i++)
+            out[i] = horner(c, degree, xs[i]);
+    };
+
+    std::size_t n = xs.size();
+    int tasks = static_cast<int>((n + EVAL_TASK_POINTS - 1) / EVAL_TASK_POINTS);
+    if (tasks > 1 && n * (degree + 1) >= PARALLEL_EVAL_WORK && ThreadPool::instance().threadCount() > 1) {
+        ThreadPool::instance().parallelFor(tasks, [&](int t) {
+            std::size_t begin = t * EVAL_TASK_POINTS;
+            evaluateRange(begin, std::min(begin + EVAL_TASK_POINTS, n));
+        });
+        return;
     }
-    return Polynomial(degree, result_coeffs);
+    evaluateRange(0, n);
+}
+
+// Sum and difference of any degrees; the result has the degree of its highest
+// non-zero coefficient
+Polynomial Polynomial::operator+(const Polynomial& other) const {
+    std::vector<double> result_coeffs = addAligned(coeffs, other.coeffs, 1.0);
+    return Polynomial(static_cast<int>(result_coeffs.size()) - 1, result_coeffs);
 }
 
 Polynomial Polynomial::operator-(const Polynomial& other) const {
-    if (degree != other.degree) {
-        throw std::invalid_argument("Polynomials must have the same degree for subtraction.");
-    }
-    std::vector<double> result_coeffs(degree + 1);
-    for (int i = 0; i <= degree; ++i) {
-        result_coeffs[i] = coeffs[i] - other.coeffs[i];
-    }
-    return Polynomial(degree, result_coeffs);
+    std::vector<double> result_coeffs = addAligned(coeffs, other.coeffs, -1.0);
+    return Polynomial(static_cast<int>(result_coeffs.size()) - 1, result_coeffs);
 }
 
+// Schoolbook, Karatsuba or FFT depending on size; see PolyMul.h for the crossovers
+// and the FFT error bound
 Polynomial Polynomial::operator*(const Polynomial& other) const {
-    int new_degree = degree + other.degree;
-    std::vector<double> result_coeffs(new_degree + 1, 0);
-    for (int i = 0; i <= degree; ++i) {
-        for (int j = 0; j <= other.degree; ++j) {
-            result_coeffs[i + j] += coeffs[i] * other.coeffs[j];
-        }
-    }
-    return Polynomial(new_degree, result_coeffs);
+    return Polynomial(degree + other.degree, polymul::multiply(coeffs, other.coeffs));
 }
 
 Polynomial Polynomial::operator/(double scalar) const {
@@ -54,31 +340,300 @@ Polynomial Polynomial::operator/(double scalar) const {
     return Polynomial(degree, result_coeffs);
 }
 
-void Polynomial::findRoots() const {
-    if (degree == 2) {
-        double a = coeffs[0], b = coeffs[1], c = coeffs[2];
-        double discriminant = b * b - 4 * a * c;
-        if (discriminant >= 0) {
-            double root1 = (-b + std::sqrt(discriminant)) / (2 * a);
-            double root2 = (-b - std::sqrt(discriminant)) / (2 * a);
-            std::cout << "Roots: " << root1 << ", " << root2 << "\n";
-        } else {
-            std::complex<double> root1 = (-b + std::sqrt(std::complex<double>(discriminant))) / (2.0 * a);
-            std::complex<double> root2 = (-b - std::sqrt(std::complex<double>(discriminant))) / (2.0 * a);
-            std::cout << "Complex Roots: " << root1 << ", " << root2 << "\n";
+// Quotient and remainder
+std::pair<Polynomial, Polynomial> Polynomial::divide(const Polynomial& divisor) const {
+    std::vector<double> b = divisor.coeffs;
+    trimLeading(b);
+    if (b[0] == 0.0) {
+        throw std::invalid_argument("Division by the zero polynomial.");
+    }
+    std::vector<double> a = coeffs;
+    trimLeading(a);
+    if (a.size() < b.size()) {
+        return {Polynomial(0, {0.0}), Polynomial(static_cast<int>(a.size()) - 1, a)};
+    }
+    std::vector<double> q, r;
+    divideCoefficients(a, b, q, r);
+    return {Polynomial(static_cast<int>(q.size()) - 1, q), Polynomial(static_cast<int>(r.size()) - 1, r)};
+}
+
+Polynomial Polynomial::operator/(const Polynomial& divisor) const {
+    return divide(divisor).first;
+}
+
+Polynomial Polynomial::operator%(const Polynomial& divisor) const {
+    return divide(divisor).second;
+}
+
+// Monic GCD by the Euclidean algorithm. A remainder counts as zero once all of its
+// coefficients are at most tolerance times the largest coefficient of its dividend.
+Polynomial Polynomial::gcd(const Polynomial& a, const Polynomial& b, double tolerance) {
+    std::vector<double> x = a.coeffs, y = b.coeffs;
+    trimLeading(x);
+    trimLeading(y);
+    if (x.size() < y.size())
+        std::swap(x, y);
+    if (x[0] == 0.0) {
+        throw std::invalid_argument("The GCD of two zero polynomials is undefined.");
+    }
+
+    while (!(y.size() == 1 && y[0] == 0.0)) {
+        trimLeading(y, tolerance * largestMagnitude(y));
+        std::vector<double> q, r;
+        divideCoefficients(x, y, q, r);
+        double scale = largestMagnitude(x);
+        trimLeading(r, tolerance * scale);
+        if (r.size() == 1 && std::abs(r[0]) <= tolerance * scale)
+            r[0] = 0.0;
+        x = std::move(y);
+        y = std::move(r);
+    }
+
+    double lead = x[0];
+    for (double& v : x)
+        v /= lead;
+    return Polynomial(static_cast<int>(x.size()) - 1, x);
+}
+
+// Multipoint evaluation: reduce p modulo the products of (x - x_i) over halves of the
+// points, recursively, until a node is small enough for Horner's rule.
+//
+// Each node carries a bound on how far its polynomial can be from p at the node's
+// points, for |x| <= rho, the largest |x_i| among them. A reduction poly = q m + r adds
+// |q|(rho) times the rounding error of m at those points, the rounding of r itself and
+// the leading coefficients the division drops, with |c|(rho) = sum |c_k| rho^k. Once
+// that bound plus Horner's error on r would exceed MULTIPOINT_ERROR_LIMIT times
+// Horner's bound for p, the node's points are evaluated from poly by Horner's rule
+// instead. Near x = +-1 |m|(rho) grows like 2^deg m, so spread points stop reducing
+// early; points clustered well inside the unit disc reduce all the way down.
+void Polynomial::evaluateMultipoint(std::span<const double> xs, std::span<double> out) const {
+    if (xs.size() != out.size()) {
+        throw std::invalid_argument("Input and output sizes must match for evaluation.");
+    }
+    int n = static_cast<int>(xs.size());
+    if (n == 0)
+        return;
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    // tree[level][node]: product of (x - x_i) over the node's points. Level 0 holds the
+    // leaves of MULTIPOINT_LEAF points; node i has children 2i and 2i + 1 one level down.
+    // radius is the node's largest |x_i|, and modulusError bounds |tree(x_i)| at the
+    // node's points, zero in exact arithmetic.
+    std::vector<std::vector<std::vector<double>>> tree(1);
+    std::vector<std::vector<double>> radius(1), modulusError(1);
+    for (int begin = 0; begin < n; begin += MULTIPOINT_LEAF) {
+        int end = std::min(n, begin + MULTIPOINT_LEAF);
+        std::vector<double> product{1.0};
+        double rho = 0.0;
+        for (int i = begin; i < end; i++) {
+            product.push_back(0.0);
+            for (std::size_t j = product.size() - 1; j > 0; j--)
+                product[j] -= xs[i] * product[j - 1];
+            rho = std::max(rho, std::abs(xs[i]));
+        }
+        radius[0].push_back(rho);
+        modulusError[0].push_back(2.0 * eps * product.size() * absoluteAt(product, rho));
+        tree[0].push_back(std::move(product));
+    }
+    while (tree.back().size() > 1) {
+        const auto& below = tree.back();
+        const auto& belowRadius = radius.back();
+        const auto& belowError = modulusError.back();
+        std::vector<std::vector<double>> level;
+        std::vector<double> levelRadius, levelError;
+        for (std::size_t i = 0; i + 1 < below.size(); i += 2) {
+            double rho = std::max(belowRadius[i], belowRadius[i + 1]);
+            std::vector<double> product = polymul::multiply(below[i], below[i + 1]);
+            double rounding = productError(below[i], below[i + 1], rho);
+            levelError.push_back(std::max(belowError[i] * absoluteAt(below[i + 1], rho),
+                                          belowError[i + 1] * absoluteAt(below[i], rho)) + rounding);
+            levelRadius.push_back(rho);
+            level.push_back(std::move(product));
+        }
+        if (below.size() % 2) {
+            level.push_back(below.back());
+            levelRadius.push_back(belowRadius.back());
+            levelError.push_back(belowError.back());
+        }
+        tree.push_back(std::move(level));
+        radius.push_back(std::move(levelRadius));
+        modulusError.push_back(std::move(levelError));
+    }
+
+    std::vector<double> p = coeffs;
+    trimLeading(p);
+
+    auto evaluateRange = [&](const std::vector<double>& poly, int level, int node) {
+        int begin = (node << level) * MULTIPOINT_LEAF;
+        int end = std::min(n, ((node + 1) << level) * MULTIPOINT_LEAF);
+        Polynomial(static_cast<int>(poly.size()) - 1, poly)
+            .evaluate(xs.subspan(begin, end - begin), out.subspan(begin, end - begin));
+    };
+
+    struct Node {
+        int level, index;
+        std::vector<double> poly; // agrees with p at the node's points, to within error
+        double error;
+    };
+    std::vector<Node> pending;
+    pending.push_back({static_cast<int>(tree.size()) - 1, 0, std::move(p), 0.0});
+    while (!pending.empty()) {
+        Node node = std::move(pending.back());
+        pending.pop_back();
+        if (node.level == 0) {
+            evaluateRange(node.poly, 0, node.index);
+            continue;
+        }
+
+        const std::vector<double>& modulus = tree[node.level][node.index];
+        std::vector<double> r = node.poly;
+        double error = node.error;
+        if (node.poly.size() >= modulus.size()) {
+            double rho = radius[node.level][node.index];
+            std::vector<double> q, dropped;
+            divideCoefficients(node.poly, modulus, q, r, &dropped);
+            double qAt = absoluteAt(q, rho);
+            double m = static_cast<double>(modulus.size()) - 1.0;
+            error += qAt * modulusError[node.level][node.index]
+                     + absoluteAt(dropped, rho) * std::pow(rho, m)
+                     + eps * static_cast<double>(q.size() + 1) * (absoluteAt(node.poly, rho) + qAt * absoluteAt(modulus, rho))
+                     + productError(q, modulus, rho);
+            double horner = eps * static_cast<double>(r.size()) * absoluteAt(r, rho);
+            double allowed = MULTIPOINT_ERROR_LIMIT * eps * static_cast<double>(coeffs.size()) * absoluteAt(coeffs, rho);
+            if (!(error + horner <= allowed)) {
+                evaluateRange(node.poly, node.level, node.index);
+                continue;
+            }
+        }
+        int children = static_cast<int>(tree[node.level - 1].size());
+        if (2 * node.index + 1 < children)
+            pending.push_back({node.level - 1, 2 * node.index + 1, r, error});
+        pending.push_back({node.level - 1, 2 * node.index, std::move(r), error});
+    }
+}
+
+// All complex roots by Aberth-Ehrlich iteration, falling back to the eigenvalues of
+// the companion matrix if some root has not converged after MAX_ROOT_ITERATIONS sweeps
+std::vector<std::complex<double>> Polynomial::findRoots() const {
+    RootFindingStats stats;
+    return findRoots(stats);
+}
+
+std::vector<std::complex<double>> Polynomial::findRoots(RootFindingStats& stats) const {
+    stats = RootFindingStats();
+    stats.converged = true;
+
+    // Leading zero coefficients lower the effective degree; trailing zeros are roots at 0
+    int first = 0, last = degree;
+    while (first <= degree && coeffs[first] == 0.0)
+        ++first;
+    if (first > degree) {
+        throw std::invalid_argument("The zero polynomial has no well-defined roots.");
+    }
+    while (coeffs[last] == 0.0)
+        --last;
+    std::vector<std::complex<double>> roots(degree - last, 0.0);
+    std::vector<double> c(coeffs.begin() + first, coeffs.begin() + last + 1);
+    int n = last - first;
+
+    if (n == 1) {
+        roots.push_back(-c[1] / c[0]);
+    } else if (n == 2) {
+        // Stable quadratic formula: avoid cancelling -b against the square root
+        std::complex<double> sq = std::sqrt(std::complex<double>(c[1] * c[1] - 4.0 * c[0] * c[2]));
+        if (std::real(sq) * c[1] < 0)
+            sq = -sq;
+        std::complex<double> q = -0.5 * (c[1] + sq);
+        std::complex<double> r1 = q / c[0];
+        std::complex<double> r2 = q == 0.0 ? r1 : c[2] / q;
+        roots.push_back(r1);
+        roots.push_back(r2);
+    } else if (n > 2) {
+        std::vector<std::complex<double>> found(n);
+        aberthRoots(c, found, stats);
+        if (!stats.converged) {
+            stats.usedCompanionMatrix = true;
+            found = companionRoots(c);
         }
-    } else {
-        std::cout << "Root-finding for cubic polynomials is not implemented.\n";
+        roots.insert(roots.end(), found.begin(), found.end());
     }
+    return roots;
 }
 
-void Polynomial::findRoots(double guess) const {
-    if (degree == 3) {
-        std::cout << "Finding roots for 3rd degree polynomial (approximate): " << std::endl;
-        // Placeholder for actual cubic root calculation (advanced techniques required)
-    } else {
-        std::cout << "Root-finding for cubic polynomials is not implemented.\n";
+std::vector<std::vector<std::complex<double>>> Polynomial::findRootsBatch(
+    const std::vector<Polynomial>& polynomials, std::vector<RootFindingStats>* stats) {
+    std::vector<std::vector<std::complex<double>>> roots(polynomials.size());
+    if (stats)
+        stats->assign(polynomials.size(), RootFindingStats());
+
+    int count = static_cast<int>(polynomials.size());
+    int tasks = (count + ROOT_BATCH_TASK - 1) / ROOT_BATCH_TASK;
+    ThreadPool::instance().parallelFor(tasks, [&](int t) {
+        int end = std::min(count, (t + 1) * ROOT_BATCH_TASK);
+        RootFindingStats local;
+        for (int k = t * ROOT_BATCH_TASK; k < end; k++) {
+            roots[k] = polynomials[k].findRoots(local);
+            if (stats)
+                (*stats)[k] = local;
+        }
+    });
+    return roots;
+}
+
+// Aberth-Ehrlich simultaneous iteration on the n > 2 roots of c (nonzero c[0] and
+// c[n]). Starting points lie on a circle around the centroid of the roots with radius
+// |c[n] / c[0]|^(1/n), rotated off the real axis so conjugate pairs can separate.
+void Polynomial::aberthRoots(const std::vector<double>& c, std::vector<std::complex<double>>& z,
+                             RootFindingStats& stats) {
+    int n = static_cast<int>(c.size()) - 1;
+    const double pi = std::acos(-1.0);
+    double centre = -c[1] / (n * c[0]);
+    double radius = std::pow(std::abs(c[n] / c[0]), 1.0 / n);
+    for (int i = 0; i < n; i++)
+        z[i] = centre + std::polar(radius, 2.0 * pi * i / n + 0.4);
+
+    std::vector<char> done(n, 0);
+    int remaining = n;
+    for (int iter = 1; iter <= MAX_ROOT_ITERATIONS && remaining > 0; iter++) {
+        stats.iterations = iter;
+        for (int i = 0; i < n; i++) {
+            if (done[i])
+                continue;
+            bool small;
+            std::complex<double> ratio = newtonCorrection(c, z[i], small);
+            if (small) {
+                done[i] = 1;
+                --remaining;
+                continue;
+            }
+            std::complex<double> repulsion = 0.0;
+            for (int j = 0; j < n; j++)
+                if (j != i)
+                    repulsion += reciprocal(z[i] - z[j]);
+            std::complex<double> step = mul(ratio, reciprocal(1.0 - mul(ratio, repulsion)));
+            z[i] -= step;
+            const double eps = std::numeric_limits<double>::epsilon();
+            if (std::norm(step) <= eps * eps * std::norm(z[i])) {
+                done[i] = 1;
+                --remaining;
+            }
+        }
     }
+    stats.converged = remaining == 0;
+    for (const auto& root : z)
+        if (!std::isfinite(root.real()) || !std::isfinite(root.imag()))
+            stats.converged = false;
+}
+
+// Eigenvalues of the companion matrix of c
+std::vector<std::complex<double>> Polynomial::companionRoots(const std::vector<double>& c) {
+    int n = static_cast<int>(c.size()) - 1;
+    Matrix companion(n, n);
+    for (int j = 0; j < n; j++)
+        companion.setElement(0, j, -c[j + 1] / c[0]);
+    for (int i = 1; i < n; i++)
+        companion.setElement(i, i - 1, 1.0);
+    return EigenSolver(companion, false).eigenvalues();
 }
 
 void Polynomial::display() const {
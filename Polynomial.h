@@ -4,18 +4,45 @@
 #include <iostream>
 #include <cmath>
 #include <complex>
+#include <span>
+#include <utility>
 #include <vector>
 #include <stdexcept> // For exception handling
 
+// Convergence report of one root-finding run
+struct RootFindingStats {
+    int iterations = 0;               // Aberth sweeps performed
+    bool converged = false;           // every root met the stopping criterion
+    bool usedCompanionMatrix = false; // Aberth did not converge; eigenvalues were used
+};
+
+// Coefficients are stored highest degree first: coeffs[0] * x^degree + ... + coeffs[degree].
 class Polynomial {
 private:
     int degree;
     std::vector<double> coeffs;
 
+    static constexpr int MAX_ROOT_ITERATIONS = 100;
+
+    static void aberthRoots(const std::vector<double>& c, std::vector<std::complex<double>>& z,
+                            RootFindingStats& stats);
+    static std::vector<std::complex<double>> companionRoots(const std::vector<double>& c);
+
 public:
-    // Constructor for a polynomial of given degree
+    // Constructor for a polynomial of given degree (any degree >= 0)
     Polynomial(int degree, const std::vector<double>& coefficients);
 
+    int getDegree() const { return degree; }
+    const std::vector<double>& getCoefficients() const { return coeffs; }
+
+    // Evaluate p(x) by Horner's rule
+    double evaluate(double x) const;
+
+    // Evaluate p at every point of xs into out (same length). Blocks of points advance
+    // through the coefficients together, one point per SIMD lane; large inputs are
+    // split across the thread pool.
+    void evaluate(std::span<const double> xs, std::span<double> out) const;
+
     // Overloading + operator
     Polynomial operator+(const Polynomial& other) const;
 
@@ -28,11 +55,38 @@ public:
     // Overloading / operator
     Polynomial operator/(double scalar) const;
 
-    // Function to find roots for 2nd degree polynomial
-    void findRoots() const;
+    // Polynomial division: *this = quotient * divisor + remainder, with the remainder's
+    // degree below the divisor's. Long division for small quotients or divisors; above
+    // that a Newton-iteration reciprocal with the fast multiply. Throws for a zero
+    // divisor. operator/ and operator% return the two parts.
+    std::pair<Polynomial, Polynomial> divide(const Polynomial& divisor) const;
+    Polynomial operator/(const Polynomial& divisor) const;
+    Polynomial operator%(const Polynomial& divisor) const;
+
+    // Monic greatest common divisor by the Euclidean algorithm. With floating-point
+    // coefficients remainders rarely vanish exactly, so one is treated as zero once its
+    // coefficients fall below tolerance relative to the dividend.
+    static Polynomial gcd(const Polynomial& a, const Polynomial& b, double tolerance = 1e-9);
+
+    // Evaluate at many points through a subproduct tree, O(n log^2 n) for n points and
+    // degree n. Each result stays within 16 times Horner's error bound
+    // n eps sum |c_k| rho^k, with rho the largest |x| in its subtree: a subtree whose
+    // accumulated reduction error could exceed that is evaluated by Horner's rule
+    // instead. Points spread over [-1, 1] or near +-1 therefore fall back almost at
+    // once; only points clustered well inside the unit interval reduce far. The SIMD
+    // evaluate() was faster in every case measured (bench/PolynomialMultipointCheck).
+    void evaluateMultipoint(std::span<const double> xs, std::span<double> out) const;
+
+    // All complex roots, with multiplicity. Degrees 1 and 2 are solved in closed form,
+    // higher degrees by Aberth-Ehrlich iteration with a companion-matrix eigenvalue
+    // fallback. Throws for the zero polynomial.
+    std::vector<std::complex<double>> findRoots() const;
+    std::vector<std::complex<double>> findRoots(RootFindingStats& stats) const;
 
-    // Function to find roots for 3rd degree polynomial (approximate solution)
-    void findRoots(double guess) const;
+    // Roots of many polynomials, solved in parallel on the thread pool. Per-polynomial
+    // statistics are written to stats when given.
+    static std::vector<std::vector<std::complex<double>>> findRootsBatch(
+        const std::vector<Polynomial>& polynomials, std::vector<RootFindingStats>* stats = nullptr);
 
     // Display polynomial
     void display() const;
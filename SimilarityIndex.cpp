@@ -0,0 +1,330 @@
+#include "SimilarityIndex.h"
+#include "Gemm.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Vectors scored per GEMM call, and queries scored together against them (one GEMM
+// row block).
+constexpr int SCAN_BLOCK = 1024;
+constexpr int QUERY_BLOCK = 96;
+// Vectors per task when assigning vectors to clusters
+constexpr int ASSIGN_BLOCK = 512;
+// k-means is trained on a sample of at most this many vectors per cluster
+constexpr int TRAINING_POINTS_PER_CLUSTER = 64;
+// Multiply-adds below which a search stays on the calling thread
+constexpr double PARALLEL_SEARCH_WORK = 1 << 20;
+
+bool ranksAbove(const SimilarityMatch& a, const SimilarityMatch& b) {
+    return a.similarity > b.similarity || (a.similarity == b.similarity && a.index < b.index);
+}
+
+// Bounded heap of the k best matches; the worst kept match sits at the front
+void offer(std::vector<SimilarityMatch>& heap, int k, const SimilarityMatch& match) {
+    if (static_cast<int>(heap.size()) < k) {
+        heap.push_back(match);
+        std::push_heap(heap.begin(), heap.end(), ranksAbove);
+    } else if (ranksAbove(match, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), ranksAbove);
+        heap.back() = match;
+        std::push_heap(heap.begin(), heap.end(), ranksAbove);
+    }
+}
+
+std::vector<SimilarityMatch> sorted(std::vector<SimilarityMatch> heap) {
+    std::sort(heap.begin(), heap.end(), ranksAbove);
+    return heap;
+}
+
+bool parallelWorthwhile(double work) {
+    return work >= PARALLEL_SEARCH_WORK && ThreadPool::instance().threadCount() > 1;
+}
+
+// labels[j] = index of the centroid row with the largest dot product with column j of
+// the dimension x n matrix `cols` (leading dimension ld)
+void assign(const double* cols, std::size_t ld, int n, const double* centroids, int clusters,
+            int dimension, int* labels) {
+    int tasks = (n + ASSIGN_BLOCK - 1) / ASSIGN_BLOCK;
+    auto assignBlock = [&](int t) {
+        int j0 = t * ASSIGN_BLOCK;
+        int nb = std::min(ASSIGN_BLOCK, n - j0);
+        std::vector<double> tile(static_cast<std::size_t>(clusters) * nb, 0.0);
+        gemm::multiplyAdd(clusters, nb, dimension, centroids, dimension, cols + j0, ld, tile.data(), nb);
+        for (int j = 0; j < nb; j++) {
+            int best = 0;
+            for (int c = 1; c < clusters; c++)
+                if (tile[c * nb + j] > tile[best * nb + j])
+                    best = c;
+            labels[j0 + j] = best;
+        }
+    };
+    if (tasks > 1 && parallelWorthwhile(static_cast<double>(n) * clusters * dimension))
+        ThreadPool::instance().parallelFor(tasks, assignBlock);
+    else
+        for (int t = 0; t < tasks; t++)
+            assignBlock(t);
+}
+
+} // namespace
+
+// Constructors
+SimilarityIndex::SimilarityIndex(const std::vector<DenseVector>& vectors)
+    : dimension(0), count(static_cast<int>(vectors.size())), probes(1) {
+    if (vectors.empty())
+        throw std::invalid_argument("Similarity index needs at least one vector");
+    dimension = vectors[0].size();
+    columns.assign(static_cast<std::size_t>(dimension) * count, 0.0);
+    ids.resize(count);
+    for (int j = 0; j < count; j++)
+        fill(j, vectors[j]);
+    listStart = {0, count};
+}
+
+SimilarityIndex::SimilarityIndex(const std::vector<Vector>& vectors)
+    : dimension(0), count(static_cast<int>(vectors.size())), probes(1) {
+    if (vectors.empty())
+        throw std::invalid_argument("Similarity index needs at least one vector");
+    dimension = vectors[0].values().size();
+    columns.assign(static_cast<std::size_t>(dimension) * count, 0.0);
+    ids.resize(count);
+    for (int j = 0; j < count; j++)
+        fill(j, vectors[j].values());
+    listStart = {0, count};
+}
+
+// Store vector `index` as a unit column
+void SimilarityIndex::fill(int index, const DenseVector& v) {
+    if (v.size() != dimension)
+        throw std::invalid_argument("All vectors in a similarity index must have the same dimension");
+    double mag = v.magnitude();
+    if (mag == 0)
+        throw std::invalid_argument("Cannot index a zero vector");
+    for (int d = 0; d < dimension; d++)
+        columns[static_cast<std::size_t>(d) * count + index] = v[d] / mag;
+    ids[index] = index;
+}
+
+// Offer columns [begin, end) to the heaps of queryCount row-major unit queries
+void SimilarityIndex::scan(const double* queries, int queryCount, int begin, int end,
+                           std::vector<SimilarityMatch>* heaps, int k) const {
+    thread_local AlignedVector<double> scores;
+    scores.resize(static_cast<std::size_t>(QUERY_BLOCK) * SCAN_BLOCK);
+    double* tile = scores.data();
+    for (int q0 = 0; q0 < queryCount; q0 += QUERY_BLOCK) {
+        int qb = std::min(QUERY_BLOCK, queryCount - q0);
+        for (int j0 = begin; j0 < end; j0 += SCAN_BLOCK) {
+            int nb = std::min(SCAN_BLOCK, end - j0);
+            std::fill(tile, tile + qb * nb, 0.0);
+            if (qb == 1) {
+                // A single query is a matrix-vector product; accumulate it row by row
+                // rather than paying for GEMM packing that one row cannot amortize
+                for (int d = 0; d < dimension; d++)
+                    vectorkernels::axpy(queries[static_cast<std::size_t>(q0) * dimension + d],
+                                        columns.data() + static_cast<std::size_t>(d) * count + j0, tile, nb);
+            } else {
+                gemm::multiplyAdd(qb, nb, dimension, queries + static_cast<std::size_t>(q0) * dimension, dimension,
+                                  columns.data() + j0, count, tile, nb);
+            }
+            for (int q = 0; q < qb; q++) {
+                std::vector<SimilarityMatch>& heap = heaps[q0 + q];
+                const double* row = tile + q * nb;
+                double threshold = static_cast<int>(heap.size()) < k
+                    ? -std::numeric_limits<double>::infinity() : heap.front().similarity;
+                for (int j = 0; j < nb; j++) {
+                    if (row[j] < threshold)
+                        continue;
+                    offer(heap, k, {ids[j0 + j], row[j]});
+                    if (static_cast<int>(heap.size()) == k)
+                        threshold = heap.front().similarity;
+                }
+            }
+        }
+    }
+}
+
+// Unit-length queries, row-major
+std::vector<double> SimilarityIndex::normalizedQueries(const std::vector<DenseVector>& queries) const {
+    std::vector<double> result(queries.size() * dimension);
+    for (std::size_t q = 0; q < queries.size(); q++) {
+        if (queries[q].size() != dimension)
+            throw std::invalid_argument("Query dimension does not match the similarity index");
+        double mag = queries[q].magnitude();
+        if (mag == 0)
+            throw std::invalid_argument("Cannot search with a zero vector");
+        for (int d = 0; d < dimension; d++)
+            result[q * dimension + d] = queries[q][d] / mag;
+    }
+    return result;
+}
+
+// Brute force over all columns. Tasks cover blocks of queries times ranges of columns,
+// so a single query is still spread over the threads; per-range heaps are merged.
+std::vector<std::vector<SimilarityMatch>> SimilarityIndex::searchExact(const std::vector<double>& queries,
+                                                                       int k) const {
+    int queryCount = static_cast<int>(queries.size() / dimension);
+    int queryBlocks = (queryCount + QUERY_BLOCK - 1) / QUERY_BLOCK;
+    int ranges = 1;
+    if (parallelWorthwhile(static_cast<double>(queryCount) * count * dimension)) {
+        int threads = ThreadPool::instance().threadCount();
+        ranges = std::max(1, std::min((threads + queryBlocks - 1) / queryBlocks, count / SCAN_BLOCK));
+    }
+
+    std::vector<std::vector<SimilarityMatch>> heaps(static_cast<std::size_t>(ranges) * queryCount);
+    auto runTask = [&](int t) {
+        int block = t / ranges, range = t % ranges;
+        int q0 = block * QUERY_BLOCK;
+        int qb = std::min(QUERY_BLOCK, queryCount - q0);
+        int begin = static_cast<int>(static_cast<long long>(count) * range / ranges);
+        int end = static_cast<int>(static_cast<long long>(count) * (range + 1) / ranges);
+        scan(queries.data() + static_cast<std::size_t>(q0) * dimension, qb, begin, end,
+             heaps.data() + static_cast<std::size_t>(range) * queryCount + q0, k);
+    };
+    int tasks = queryBlocks * ranges;
+    if (tasks > 1 && parallelWorthwhile(static_cast<double>(queryCount) * count * dimension))
+        ThreadPool::instance().parallelFor(tasks, runTask);
+    else
+        for (int t = 0; t < tasks; t++)
+            runTask(t);
+
+    std::vector<std::vector<SimilarityMatch>> results(queryCount);
+    for (int q = 0; q < queryCount; q++) {
+        std::vector<SimilarityMatch> merged = std::move(heaps[q]);
+        for (int r = 1; r < ranges; r++)
+            for (const SimilarityMatch& match : heaps[static_cast<std::size_t>(r) * queryCount + q])
+                offer(merged, k, match);
+        results[q] = sorted(std::move(merged));
+    }
+    return results;
+}
+
+// Scan the lists of the clusters whose centroids are most similar to the query
+std::vector<SimilarityMatch> SimilarityIndex::searchClusters(const double* query, int k) const {
+    int clusters = getClusterCount();
+    std::vector<SimilarityMatch> heap;
+    if (clusters == 1) {
+        scan(query, 1, 0, count, &heap, k);
+        return sorted(std::move(heap));
+    }
+
+    std::vector<double> scores(clusters, 0.0);
+    gemm::multiplyAdd(clusters, 1, dimension, centroids.data(), dimension, query, 1, scores.data(), 1);
+    std::vector<int> order(clusters);
+    for (int c = 0; c < clusters; c++)
+        order[c] = c;
+    int probed = std::min(probes, clusters);
+    std::partial_sort(order.begin(), order.begin() + probed, order.end(),
+                      [&](int a, int b) { return scores[a] > scores[b]; });
+    for (int p = 0; p < probed; p++)
+        scan(query, 1, listStart[order[p]], listStart[order[p] + 1], &heap, k);
+    return sorted(std::move(heap));
+}
+
+// Search
+std::vector<SimilarityMatch> SimilarityIndex::search(const DenseVector& query, int k, SearchMode mode) const {
+    return searchBatch({query}, k, mode)[0];
+}
+
+std::vector<SimilarityMatch> SimilarityIndex::search(const Vector& query, int k, SearchMode mode) const {
+    return search(query.values(), k, mode);
+}
+
+std::vector<std::vector<SimilarityMatch>> SimilarityIndex::searchBatch(const std::vector<DenseVector>& queries,
+                                                                       int k, SearchMode mode) const {
+    if (k <= 0)
+        throw std::invalid_argument("Number of matches must be positive");
+    std::vector<double> unit = normalizedQueries(queries);
+    if (mode == SearchMode::Exact || getClusterCount() == 1)
+        return searchExact(unit, k);
+
+    int queryCount = static_cast<int>(queries.size());
+    std::vector<std::vector<SimilarityMatch>> results(queryCount);
+    auto searchOne = [&](int q) {
+        results[q] = searchClusters(unit.data() + static_cast<std::size_t>(q) * dimension, k);
+    };
+    double work = static_cast<double>(queryCount) * count / getClusterCount() * std::min(probes, getClusterCount())
+        * dimension;
+    if (queryCount > 1 && parallelWorthwhile(work))
+        ThreadPool::instance().parallelFor(queryCount, searchOne);
+    else
+        for (int q = 0; q < queryCount; q++)
+            searchOne(q);
+    return results;
+}
+
+// Spherical k-means on a strided sample, then a final assignment of every vector and
+// a counting sort of the columns into contiguous lists
+void SimilarityIndex::buildClusters(int clusters, int iterations) {
+    if (clusters <= 0 || clusters > count)
+        throw std::invalid_argument("Cluster count must be between 1 and the number of vectors");
+    if (iterations < 0)
+        throw std::invalid_argument("Iteration count must be non-negative");
+
+    int step = std::max(1, count / (clusters * TRAINING_POINTS_PER_CLUSTER));
+    int samples = (count + step - 1) / step;
+    std::vector<double> sample(static_cast<std::size_t>(dimension) * samples);
+    for (int d = 0; d < dimension; d++)
+        for (int s = 0; s < samples; s++)
+            sample[static_cast<std::size_t>(d) * samples + s] = columns[static_cast<std::size_t>(d) * count + s * step];
+
+    // Seeds spread evenly over the sample
+    centroids.assign(static_cast<std::size_t>(clusters) * dimension, 0.0);
+    for (int c = 0; c < clusters; c++) {
+        int s = static_cast<int>(static_cast<long long>(c) * samples / clusters);
+        for (int d = 0; d < dimension; d++)
+            centroids[static_cast<std::size_t>(c) * dimension + d] = sample[static_cast<std::size_t>(d) * samples + s];
+    }
+
+    std::vector<int> labels(samples);
+    std::vector<double> sums(static_cast<std::size_t>(clusters) * dimension);
+    for (int it = 0; it < iterations; it++) {
+        assign(sample.data(), samples, samples, centroids.data(), clusters, dimension, labels.data());
+        std::fill(sums.begin(), sums.end(), 0.0);
+        for (int d = 0; d < dimension; d++)
+            for (int s = 0; s < samples; s++)
+                sums[static_cast<std::size_t>(labels[s]) * dimension + d] += sample[static_cast<std::size_t>(d) * samples + s];
+        // The new centroid is the normalized mean direction; an empty cluster keeps its old one
+        for (int c = 0; c < clusters; c++) {
+            double* sum = sums.data() + static_cast<std::size_t>(c) * dimension;
+            double norm = std::sqrt(vectorkernels::squaredNorm(sum, dimension));
+            if (norm > 0)
+                for (int d = 0; d < dimension; d++)
+                    centroids[static_cast<std::size_t>(c) * dimension + d] = sum[d] / norm;
+        }
+    }
+
+    std::vector<int> columnLabels(count);
+    assign(columns.data(), count, count, centroids.data(), clusters, dimension, columnLabels.data());
+
+    listStart.assign(clusters + 1, 0);
+    for (int j = 0; j < count; j++)
+        listStart[columnLabels[j] + 1]++;
+    for (int c = 0; c < clusters; c++)
+        listStart[c + 1] += listStart[c];
+
+    std::vector<int> position(listStart.begin(), listStart.end() - 1);
+    std::vector<int> target(count);
+    for (int j = 0; j < count; j++)
+        target[j] = position[columnLabels[j]]++;
+
+    AlignedVector<double> reordered(columns.size());
+    std::vector<int> reorderedIds(count);
+    for (int j = 0; j < count; j++)
+        reorderedIds[target[j]] = ids[j];
+    for (int d = 0; d < dimension; d++) {
+        const double* from = columns.data() + static_cast<std::size_t>(d) * count;
+        double* to = reordered.data() + static_cast<std::size_t>(d) * count;
+        for (int j = 0; j < count; j++)
+            to[target[j]] = from[j];
+    }
+    columns.swap(reordered);
+    ids.swap(reorderedIds);
+}
+
+void SimilarityIndex::setProbeCount(int probes) {
+    if (probes <= 0)
+        throw std::invalid_argument("Probe count must be positive");
+    this->probes = probes;
+}
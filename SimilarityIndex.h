@@ -0,0 +1,72 @@
+#ifndef SIMILARITY_INDEX_H
+#define SIMILARITY_INDEX_H
+
+#include <vector>
+#include <stdexcept>
+#include "AlignedAllocator.h"
+#include "DenseVector.h"
+#include "VectorOperations.h"
+
+// One search hit: position of the vector in the collection the index was built from,
+// and its cosine similarity to the query.
+struct SimilarityMatch {
+    int index;
+    double similarity;
+};
+
+// Cosine-similarity search over a fixed collection of vectors. The vectors are
+// normalized once and stored contiguously as the columns of a dimension x size matrix,
+// so scoring a block of queries against a block of vectors is a single GEMM call and
+// cosine similarity is a plain dot product.
+//
+// Exact search scans every vector. After buildClusters(), approximate search only
+// scans the clusters (inverted lists) whose centroids are closest to the query; the
+// probe count trades recall for latency.
+class SimilarityIndex {
+public:
+    enum class SearchMode { Exact, Approximate };
+
+private:
+    int dimension, count;
+    AlignedVector<double> columns;   // dimension x count, column j is the normalized vector ids[j]
+    std::vector<int> ids;            // original index of each column
+    AlignedVector<double> centroids; // clusters x dimension, unit rows
+    std::vector<int> listStart;      // columns of cluster c are [listStart[c], listStart[c + 1])
+    int probes;
+
+    void fill(int index, const DenseVector& v);
+    void scan(const double* queries, int queryCount, int begin, int end,
+              std::vector<SimilarityMatch>* heaps, int k) const;
+    std::vector<double> normalizedQueries(const std::vector<DenseVector>& queries) const;
+    std::vector<std::vector<SimilarityMatch>> searchExact(const std::vector<double>& queries, int k) const;
+    std::vector<SimilarityMatch> searchClusters(const double* query, int k) const;
+
+public:
+    // Build from a non-empty collection of non-zero vectors of equal dimension
+    explicit SimilarityIndex(const std::vector<DenseVector>& vectors);
+    explicit SimilarityIndex(const std::vector<Vector>& vectors);
+
+    int size() const { return count; }
+    int getDimension() const { return dimension; }
+
+    // The k most similar vectors, best first (ties broken by lower index). Returns
+    // fewer than k matches if the collection, or the probed clusters, hold fewer.
+    std::vector<SimilarityMatch> search(const DenseVector& query, int k,
+                                        SearchMode mode = SearchMode::Exact) const;
+    std::vector<SimilarityMatch> search(const Vector& query, int k,
+                                        SearchMode mode = SearchMode::Exact) const;
+    std::vector<std::vector<SimilarityMatch>> searchBatch(const std::vector<DenseVector>& queries, int k,
+                                                          SearchMode mode = SearchMode::Exact) const;
+
+    // Partition the vectors into `clusters` inverted lists with spherical k-means for
+    // approximate search; until then there is a single list and approximate search is
+    // exact. Clustering is deterministic.
+    void buildClusters(int clusters, int iterations = 10);
+    int getClusterCount() const { return static_cast<int>(listStart.size()) - 1; }
+
+    // Clusters scanned per approximate query (default 1, clamped to the cluster count)
+    void setProbeCount(int probes);
+    int getProbeCount() const { return probes; }
+};
+
+#endif // SIMILARITY_INDEX_H
@@ -0,0 +1,155 @@
+#include "SparseMatrix.h"
+#include <algorithm>
+
+// Constructor
+SparseMatrix::SparseMatrix(int r, int c) : rows(r), cols(c), rowStart(r + 1, 0) {
+    if (r < 0 || c < 0)
+        throw std::invalid_argument("Matrix dimensions must be non-negative");
+}
+
+// Construct from triplets: bucket by row, sort each row by column, merge duplicates
+SparseMatrix::SparseMatrix(int r, int c, const std::vector<Triplet>& triplets) : SparseMatrix(r, c) {
+    std::vector<int> counts(r + 1, 0);
+    for (const Triplet& t : triplets) {
+        if (t.row < 0 || t.row >= r || t.col < 0 || t.col >= c)
+            throw std::out_of_range("Index out of range");
+        counts[t.row + 1]++;
+    }
+    for (int i = 0; i < r; i++)
+        counts[i + 1] += counts[i];
+
+    std::vector<std::pair<int, double>> entries(triplets.size());
+    std::vector<int> next(counts.begin(), counts.end() - 1);
+    for (const Triplet& t : triplets)
+        entries[next[t.row]++] = {t.col, t.value};
+
+    colIndex.reserve(triplets.size());
+    values.reserve(triplets.size());
+    for (int i = 0; i < r; i++) {
+        auto begin = entries.begin() + counts[i];
+        auto end = entries.begin() + counts[i + 1];
+        std::sort(begin, end, [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto it = begin; it != end;) {
+            int col = it->first;
+            double sum = 0;
+            for (; it != end && it->first == col; ++it)
+                sum += it->second;
+            if (sum != 0) {
+                colIndex.push_back(col);
+                values.push_back(sum);
+            }
+        }
+        rowStart[i + 1] = static_cast<int>(values.size());
+    }
+}
+
+// Conversion from a dense matrix
+SparseMatrix SparseMatrix::fromDense(const Matrix& dense, double tolerance) {
+    SparseMatrix result(dense.getRows(), dense.getCols());
+    for (int i = 0; i < dense.getRows(); i++) {
+        const double* row = dense.rowData(i);
+        for (int j = 0; j < dense.getCols(); j++) {
+            if (std::abs(row[j]) > tolerance) {
+                result.colIndex.push_back(j);
+                result.values.push_back(row[j]);
+            }
+        }
+        result.rowStart[i + 1] = result.nonZeros();
+    }
+    return result;
+}
+
+// Conversion to a dense matrix
+Matrix SparseMatrix::toDense() const {
+    Matrix result(rows, cols);
+    for (int i = 0; i < rows; i++) {
+        double* row = result.rowData(i);
+        for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+            row[colIndex[k]] = values[k];
+    }
+    return result;
+}
+
+// Element lookup
+double SparseMatrix::getElement(int i, int j) const {
+    if (i < 0 || i >= rows || j < 0 || j >= cols)
+        throw std::out_of_range("Index out of range");
+    auto begin = colIndex.begin() + rowStart[i];
+    auto end = colIndex.begin() + rowStart[i + 1];
+    auto it = std::lower_bound(begin, end, j);
+    if (it == end || *it != j)
+        return 0.0;
+    return values[it - colIndex.begin()];
+}
+
+// Transpose by counting sort on column indices; rows of the result come out sorted
+SparseMatrix SparseMatrix::transpose() const {
+    SparseMatrix result(cols, rows);
+    for (int col : colIndex)
+        result.rowStart[col + 1]++;
+    for (int j = 0; j < cols; j++)
+        result.rowStart[j + 1] += result.rowStart[j];
+
+    result.colIndex.resize(values.size());
+    result.values.resize(values.size());
+    std::vector<int> next(result.rowStart.begin(), result.rowStart.end() - 1);
+    for (int i = 0; i < rows; i++) {
+        for (int k = rowStart[i]; k < rowStart[i + 1]; k++) {
+            int dst = next[colIndex[k]]++;
+            result.colIndex[dst] = i;
+            result.values[dst] = values[k];
+        }
+    }
+    return result;
+}
+
+// Sparse x dense: each nonzero scales one contiguous row of the dense operand
+Matrix SparseMatrix::operator*(const Matrix& dense) const {
+    if (cols != dense.getRows())
+        throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+    int n = dense.getCols();
+    Matrix result(rows, n);
+    if (values.empty() || n == 0)
+        return result;
+    // Row pointers come from one base taken here: the mutable rowData() resets the
+    // result's LU cache and must not run on several threads at once
+    double* base = result.rowData(0);
+    std::size_t stride = result.rowStride();
+    std::size_t work = values.size() * static_cast<std::size_t>(n);
+    Matrix::forEachRowBand(rows, work, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            double* out = base + i * stride;
+            for (int k = rowStart[i]; k < rowStart[i + 1]; k++) {
+                double v = values[k];
+                const double* in = dense.rowData(colIndex[k]);
+                for (int j = 0; j < n; j++)
+                    out[j] += v * in[j];
+            }
+        }
+    });
+    return result;
+}
+
+// Sparse x vector
+std::vector<double> SparseMatrix::operator*(const std::vector<double>& x) const {
+    if (static_cast<int>(x.size()) != cols)
+        throw std::invalid_argument("Matrix and vector dimensions do not match for multiplication");
+    std::vector<double> result(rows, 0.0);
+    Matrix::forEachRowBand(rows, values.size(), [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            double sum = 0;
+            for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+                sum += values[k] * x[colIndex[k]];
+            result[i] = sum;
+        }
+    });
+    return result;
+}
+
+// Display nonzero entries
+void SparseMatrix::display() const {
+    std::cout << rows << "x" << cols << " sparse matrix, " << nonZeros() << " nonzeros" << std::endl;
+    for (int i = 0; i < rows; i++)
+        for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+            std::cout << "(" << i << ", " << colIndex[k] << ") " << values[k] << std::endl;
+}
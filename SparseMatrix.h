@@ -0,0 +1,61 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include "Matrix.h"
+
+// Sparse matrix in compressed sparse row (CSR) form. Storage and the cost of every
+// operation scale with the number of nonzeros rather than rows * cols.
+//
+// The compressed column (CSC) form of A has exactly the arrays of the CSR form of
+// A^T, so transpose() doubles as the CSR <-> CSC conversion.
+class SparseMatrix {
+private:
+    int rows, cols;
+    std::vector<int> rowStart;    // rows + 1 offsets into colIndex/values
+    std::vector<int> colIndex;    // column of each nonzero, ascending within a row
+    std::vector<double> values;
+
+public:
+    // One (row, column, value) entry used for construction
+    struct Triplet {
+        int row;
+        int col;
+        double value;
+    };
+
+    // Empty (all-zero) matrix
+    SparseMatrix(int r, int c);
+
+    // From unordered triplets; duplicate entries are summed and zeros dropped
+    SparseMatrix(int r, int c, const std::vector<Triplet>& triplets);
+
+    // Conversion to and from dense matrices; entries with |value| <= tolerance are dropped
+    static SparseMatrix fromDense(const Matrix& dense, double tolerance = 0.0);
+    Matrix toDense() const;
+
+    // Dimensions and storage
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int nonZeros() const { return static_cast<int>(values.size()); }
+    const std::vector<int>& rowOffsets() const { return rowStart; }
+    const std::vector<int>& columnIndices() const { return colIndex; }
+    const std::vector<double>& nonZeroValues() const { return values; }
+
+    // Element lookup (binary search within the row)
+    double getElement(int i, int j) const;
+
+    // Transpose in O(nonzeros + rows + cols)
+    SparseMatrix transpose() const;
+
+    // Sparse x dense and sparse x vector products
+    Matrix operator*(const Matrix& dense) const;
+    std::vector<double> operator*(const std::vector<double>& x) const;
+
+    // Display as a list of nonzero entries
+    void display() const;
+};
+
+#endif // SPARSE_MATRIX_H
@@ -0,0 +1,149 @@
+#include "ThreadPool.h"
+
+namespace {
+
+// Index of the pool queue owned by the current thread; external threads use queue 0.
+thread_local int currentQueue = 0;
+
+int resolveThreadCount(int threads) {
+    if (threads > 0)
+        return threads;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(int threads) {
+    start(resolveThreadCount(threads));
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool(0);
+    return pool;
+}
+
+void ThreadPool::start(int threads) {
+    stopping = false;
+    queues.clear();
+    for (int i = 0; i < threads; i++)
+        queues.push_back(std::make_unique<WorkQueue>());
+    for (int i = 1; i < threads; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+void ThreadPool::setThreadCount(int threads) {
+    threads = resolveThreadCount(threads);
+    if (threads == threadCount())
+        return;
+    stop();
+    start(threads);
+}
+
+int ThreadPool::threadCount() const {
+    return static_cast<int>(queues.size());
+}
+
+void ThreadPool::runTask(const Task& task) {
+    Job* job = task.job;
+    try {
+        (*job->body)(task.index);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job->errorMutex);
+        if (!job->error)
+            job->error = std::current_exception();
+    }
+    job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool ThreadPool::tryRunOne(int self) {
+    Task task{nullptr, 0};
+    int count = threadCount();
+
+    // Own queue first (LIFO keeps recently queued tiles warm), then steal FIFO.
+    for (int offset = 0; offset < count && !task.job; offset++) {
+        WorkQueue& queue = *queues[(self + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        if (offset == 0) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        } else {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task.job)
+        return false;
+
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    runTask(task);
+    return true;
+}
+
+void ThreadPool::workerLoop(int self) {
+    currentQueue = self;
+    while (true) {
+        if (tryRunOne(self))
+            continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0)
+            return;
+    }
+}
+
+void ThreadPool::parallelFor(int taskCount, const std::function<void(int)>& body) {
+    if (taskCount <= 0)
+        return;
+    int count = threadCount();
+    if (count == 1 || taskCount == 1) {
+        for (int i = 0; i < taskCount; i++)
+            body(i);
+        return;
+    }
+
+    Job job;
+    job.body = &body;
+    job.remaining.store(taskCount);
+
+    // Deal contiguous runs of tasks to each queue so neighbouring tiles share a thread.
+    int self = currentQueue;
+    for (int q = 0; q < count; q++) {
+        int begin = static_cast<int>(static_cast<long long>(taskCount) * q / count);
+        int end = static_cast<int>(static_cast<long long>(taskCount) * (q + 1) / count);
+        WorkQueue& queue = *queues[(self + q) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (int i = begin; i < end; i++)
+            queue.tasks.push_back(Task{&job, i});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(taskCount);
+    }
+    wake.notify_all();
+
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne(self))
+            std::this_thread::yield();
+    }
+
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
@@ -0,0 +1,72 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Shared work-stealing thread pool used by the parallel kernels.
+//
+// parallelFor() spreads task indices over per-thread deques; each thread pops from the
+// back of its own deque and steals from the front of the others once it runs dry, so
+// uneven tasks do not leave threads idle. The calling thread takes part in the work,
+// which also makes nested parallelFor() calls safe.
+class ThreadPool {
+private:
+    struct Job {
+        const std::function<void(int)>* body;
+        std::atomic<int> remaining;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        Job* job;
+        int index;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues; // queues[0] is shared by external callers
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued{0};
+    bool stopping = false;
+
+    explicit ThreadPool(int threads);
+
+    void start(int threads);
+    void stop();
+    void workerLoop(int self);
+    bool tryRunOne(int self);
+    static void runTask(const Task& task);
+
+public:
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool, sized to the hardware concurrency on first use
+    static ThreadPool& instance();
+
+    // Resize the pool (0 selects the hardware concurrency). Must not be called
+    // while a parallelFor() is in flight.
+    void setThreadCount(int threads);
+    int threadCount() const;
+
+    // Run body(i) for every i in [0, taskCount) and wait for completion. The first
+    // exception thrown by a task is rethrown here after all tasks have finished.
+    void parallelFor(int taskCount, const std::function<void(int)>& body);
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,286 @@
+#include "VectorKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTORKERNELS_HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace vectorkernels {
+
+namespace {
+
+// Pairwise summation recurses down to blocks of this many elements.
+constexpr std::size_t PAIRWISE_BLOCK = 1024;
+
+struct Kernels {
+    const char* name;
+    double (*dot)(const double* a, const double* b, std::size_t n);
+    double (*dotCompensated)(const double* a, const double* b, std::size_t n);
+    void (*axpy)(double alpha, const double* x, double* y, std::size_t n);
+    void (*scale)(double* a, std::size_t n, double s);
+};
+
+// Error-free sum: s + e == x + y exactly
+inline void twoSum(double x, double y, double& s, double& e) {
+    s = x + y;
+    double z = s - x;
+    e = (x - (s - z)) + (y - z);
+}
+
+// Finish a compensated reduction from per-lane partial sums and error terms
+double sumCompensated(const double* sums, const double* errors, int lanes) {
+    double p = 0.0, s = 0.0;
+    for (int l = 0; l < lanes; l++) {
+        double q;
+        twoSum(p, sums[l], p, q);
+        s += q + errors[l];
+    }
+    return p + s;
+}
+
+// Portable kernels. Four accumulators break the add dependency chain.
+double dotScalar(const double* a, const double* b, std::size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; i++)
+        s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+double dotCompensatedScalar(const double* a, const double* b, std::size_t n) {
+    double p = 0.0, s = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+        double h = a[i] * b[i];
+        double r = std::fma(a[i], b[i], -h);
+        double q;
+        twoSum(p, h, p, q);
+        s += q + r;
+    }
+    return p + s;
+}
+
+void axpyScalar(double alpha, const double* x, double* y, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++)
+        y[i] += alpha * x[i];
+}
+
+void scaleScalar(double* a, std::size_t n, double s) {
+    for (std::size_t i = 0; i < n; i++)
+        a[i] *= s;
+}
+
+#ifdef VECTORKERNELS_HAVE_X86_DISPATCH
+// AVX2/FMA kernels: four ymm accumulators, 16 elements per iteration.
+__attribute__((target("avx2,fma")))
+double dotAvx2(const double* a, const double* b, std::size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
+    }
+    for (; i + 4 <= n; i += 4)
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    double result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++)
+        result += a[i] * b[i];
+    return result;
+}
+
+__attribute__((target("avx2,fma")))
+double dotCompensatedAvx2(const double* a, const double* b, std::size_t n) {
+    __m256d p = _mm256_setzero_pd(), s = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(a + i);
+        __m256d y = _mm256_loadu_pd(b + i);
+        __m256d h = _mm256_mul_pd(x, y);
+        __m256d r = _mm256_fmsub_pd(x, y, h);
+        __m256d t = _mm256_add_pd(p, h);
+        __m256d z = _mm256_sub_pd(t, p);
+        __m256d q = _mm256_add_pd(_mm256_sub_pd(p, _mm256_sub_pd(t, z)), _mm256_sub_pd(h, z));
+        p = t;
+        s = _mm256_add_pd(s, _mm256_add_pd(q, r));
+    }
+    alignas(32) double sums[5], errors[5];
+    _mm256_store_pd(sums, p);
+    _mm256_store_pd(errors, s);
+    sums[4] = 0.0;
+    errors[4] = 0.0;
+    if (i < n) {
+        sums[4] = dotCompensatedScalar(a + i, b + i, n - i);
+    }
+    return sumCompensated(sums, errors, 5);
+}
+
+__attribute__((target("avx2,fma")))
+void axpyAvx2(double alpha, const double* x, double* y, std::size_t n) {
+    __m256d va = _mm256_set1_pd(alpha);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        _mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+    }
+    for (; i < n; i++)
+        y[i] += alpha * x[i];
+}
+
+__attribute__((target("avx2,fma")))
+void scaleAvx2(double* a, std::size_t n, double s) {
+    __m256d vs = _mm256_set1_pd(s);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_pd(a + i, _mm256_mul_pd(vs, _mm256_loadu_pd(a + i)));
+        _mm256_storeu_pd(a + i + 4, _mm256_mul_pd(vs, _mm256_loadu_pd(a + i + 4)));
+    }
+    for (; i < n; i++)
+        a[i] *= s;
+}
+
+// AVX-512 kernels: four zmm accumulators, 32 elements per iteration, masked tails.
+__attribute__((target("avx512f")))
+double dotAvx512(const double* a, const double* b, std::size_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), s3);
+    }
+    for (; i + 8 <= n; i += 8)
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+    if (i < n) {
+        __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+        s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i), s1);
+    }
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, _mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+__attribute__((target("avx512f")))
+double dotCompensatedAvx512(const double* a, const double* b, std::size_t n) {
+    __m512d p = _mm512_setzero_pd(), s = _mm512_setzero_pd();
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 mask = n - i >= 8 ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d x = _mm512_maskz_loadu_pd(mask, a + i);
+        __m512d y = _mm512_maskz_loadu_pd(mask, b + i);
+        __m512d h = _mm512_mul_pd(x, y);
+        __m512d r = _mm512_fmsub_pd(x, y, h);
+        __m512d t = _mm512_add_pd(p, h);
+        __m512d z = _mm512_sub_pd(t, p);
+        __m512d q = _mm512_add_pd(_mm512_sub_pd(p, _mm512_sub_pd(t, z)), _mm512_sub_pd(h, z));
+        p = t;
+        s = _mm512_add_pd(s, _mm512_add_pd(q, r));
+    }
+    alignas(64) double sums[8], errors[8];
+    _mm512_store_pd(sums, p);
+    _mm512_store_pd(errors, s);
+    return sumCompensated(sums, errors, 8);
+}
+
+__attribute__((target("avx512f")))
+void axpyAvx512(double alpha, const double* x, double* y, std::size_t n) {
+    __m512d va = _mm512_set1_pd(alpha);
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 mask = n - i >= 8 ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d r = _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(mask, x + i), _mm512_maskz_loadu_pd(mask, y + i));
+        _mm512_mask_storeu_pd(y + i, mask, r);
+    }
+}
+
+__attribute__((target("avx512f")))
+void scaleAvx512(double* a, std::size_t n, double s) {
+    __m512d vs = _mm512_set1_pd(s);
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 mask = n - i >= 8 ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        _mm512_mask_storeu_pd(a + i, mask, _mm512_mul_pd(vs, _mm512_maskz_loadu_pd(mask, a + i)));
+    }
+}
+#endif
+
+Kernels selectKernels() {
+#ifdef VECTORKERNELS_HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return {"avx512", dotAvx512, dotCompensatedAvx512, axpyAvx512, scaleAvx512};
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return {"avx2", dotAvx2, dotCompensatedAvx2, axpyAvx2, scaleAvx2};
+#endif
+    return {"scalar", dotScalar, dotCompensatedScalar, axpyScalar, scaleScalar};
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+double dotPairwise(const double* a, const double* b, std::size_t n) {
+    if (n <= PAIRWISE_BLOCK)
+        return kernels().dot(a, b, n);
+    std::size_t half = (n / 2 + PAIRWISE_BLOCK - 1) / PAIRWISE_BLOCK * PAIRWISE_BLOCK;
+    return dotPairwise(a, b, half) + dotPairwise(a + half, b + half, n - half);
+}
+
+} // namespace
+
+double dot(const double* a, const double* b, std::size_t n, Summation mode) {
+    switch (mode) {
+    case Summation::Pairwise:
+        return dotPairwise(a, b, n);
+    case Summation::Compensated:
+        return kernels().dotCompensated(a, b, n);
+    default:
+        return kernels().dot(a, b, n);
+    }
+}
+
+double squaredNorm(const double* a, std::size_t n, Summation mode) {
+    return dot(a, a, n, mode);
+}
+
+void axpy(double alpha, const double* x, double* y, std::size_t n) {
+    kernels().axpy(alpha, x, y, n);
+}
+
+void scale(double* a, std::size_t n, double s) {
+    kernels().scale(a, n, s);
+}
+
+double normalize(double* a, std::size_t n, Summation mode) {
+    double norm = std::sqrt(squaredNorm(a, n, mode));
+    if (norm != 0.0)
+        scale(a, n, 1.0 / norm);
+    return norm;
+}
+
+double angle(const double* a, const double* b, std::size_t n, Summation mode) {
+    double normA = std::sqrt(squaredNorm(a, n, mode));
+    double normB = std::sqrt(squaredNorm(b, n, mode));
+    if (normA == 0 || normB == 0)
+        throw std::invalid_argument("Cannot calculate the angle with a zero vector");
+    double c = dot(a, b, n, mode) / (normA * normB);
+    return std::acos(std::clamp(c, -1.0, 1.0));
+}
+
+const char* implementation() {
+    return kernels().name;
+}
+
+} // namespace vectorkernels
@@ -0,0 +1,42 @@
+#ifndef VECTOR_KERNELS_H
+#define VECTOR_KERNELS_H
+
+#include <cstddef>
+
+// Level-1 kernels on contiguous double arrays, shared by DenseVector and the other
+// vector containers. The implementation is picked once at run time: AVX-512, AVX2/FMA
+// or portable scalar code.
+namespace vectorkernels {
+
+// How reductions (dot products and squared norms) accumulate.
+enum class Summation {
+    Fast,        // several independent SIMD accumulators; error grows like n * eps
+    Pairwise,    // blocks of the fast kernel combined pairwise; error grows like log(n) * eps
+    Compensated  // error-free transformations (Ogita-Rump-Oishi Dot2): as accurate as
+                 // evaluating in twice the working precision, then rounding once
+};
+
+double dot(const double* a, const double* b, std::size_t n, Summation mode = Summation::Fast);
+double squaredNorm(const double* a, std::size_t n, Summation mode = Summation::Fast);
+
+// y += alpha * x
+void axpy(double alpha, const double* x, double* y, std::size_t n);
+
+// a *= s
+void scale(double* a, std::size_t n, double s);
+
+// Scale a to unit length and return its original norm; a zero vector is left
+// unchanged and 0 is returned.
+double normalize(double* a, std::size_t n, Summation mode = Summation::Fast);
+
+// Angle between a and b in radians; the cosine is clamped to [-1, 1] so that rounding
+// cannot produce NaN for (anti)parallel vectors. Throws std::invalid_argument if either
+// vector is zero.
+double angle(const double* a, const double* b, std::size_t n, Summation mode = Summation::Fast);
+
+// Name of the selected implementation: "avx512", "avx2" or "scalar".
+const char* implementation();
+
+} // namespace vectorkernels
+
+#endif // VECTOR_KERNELS_H
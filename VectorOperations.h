@@ -2,9 +2,11 @@
 #define VECTOR_OPERATIONS_H
 
 #include <vector>
+#include <initializer_list>
 #include <stdexcept>
 #include <cmath>
 #include <iostream>
+#include "DenseVector.h"
 
 using namespace std;
 
@@ -23,12 +25,19 @@ public:
     virtual ~VectorOperations() = default;
 };
 
+// Adapter exposing a DenseVector through the VectorOperations interface. The pointer
+// returning operations allocate and must be deleted by the caller; arithmetic in hot
+// loops should use DenseVector (via values()) directly.
 class Vector : public VectorOperations {
 private:
-    vector<double> components;
+    DenseVector components;
 
 public:
     Vector(const vector<double>& components);
+    Vector(std::initializer_list<double> components);
+    explicit Vector(DenseVector components);
+
+    const DenseVector& values() const { return components; }
 
     void display() const override;
 
@@ -0,0 +1,49 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Helpers shared by the benchmark drivers in this directory. Each driver is a
+// standalone program with its own main(); from the repository root, build one with
+//
+//     g++ -std=c++20 -O2 -I. bench/<Driver>.cpp $(ls *.cpp | grep -v _Main_File_) -pthread
+//
+// Timings are the best of several runs, so one-off scheduling noise drops out.
+namespace bench {
+
+// Best wall-clock time in seconds over `repeats` calls of f
+template <typename F>
+double bestTime(int repeats, F f) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+// Keeps the compiler from discarding a computed value
+template <typename T>
+void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// n values uniform in [lo, hi), the same on every run
+inline std::vector<double> randomValues(std::size_t n, double lo = -1.0, double hi = 1.0, unsigned seed = 1) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<double> values(n);
+    for (double& v : values)
+        v = dist(rng);
+    return values;
+}
+
+} // namespace bench
+
+#endif // BENCH_UTIL_H
@@ -0,0 +1,59 @@
+// Per-call latency of the map-returning Calculator bundles against the bitmask-selected
+// *Values structs, for everything and for the narrow requests a caller usually makes.
+// Arguments cycle through a table so no call can be hoisted out of the loop.
+#include <cstdio>
+#include <vector>
+#include "BenchUtil.h"
+#include "Calculator.h"
+
+namespace {
+
+const int COUNT = 4096, ROUNDS = 50;
+
+// Nanoseconds per call of f(x) over ROUNDS passes of the table
+template <typename F>
+double perCall(const std::vector<double>& xs, F f) {
+    double seconds = bench::bestTime(5, [&] {
+        for (int r = 0; r < ROUNDS; r++)
+            for (double x : xs)
+                bench::keep(f(x));
+    });
+    return seconds / (static_cast<double>(ROUNDS) * COUNT) * 1e9;
+}
+
+void row(const char* name, double ns) {
+    std::printf("%-40s %10.1f\n", name, ns);
+}
+
+} // namespace
+
+int main() {
+    // Angles in (-1, 1) keep every inverse function in its domain
+    std::vector<double> angles = bench::randomValues(COUNT, -0.99, 0.99);
+    std::vector<double> positives = bench::randomValues(COUNT, 0.01, 100.0);
+    std::vector<double> exponents = bench::randomValues(COUNT, -20.0, 20.0);
+
+    std::printf("%-40s %10s\n", "call", "ns");
+    row("trigonometryFunctions (map)", perCall(angles, trigonometryFunctions));
+    row("trigonometryValues, All", perCall(angles, [](double x) { return trigonometryValues(x); }));
+    row("trigonometryValues, Sin", perCall(angles, [](double x) {
+        return trigonometryValues(x, TrigFunctions::Sin);
+    }));
+    row("trigonometryValues, Sin | Cos", perCall(angles, [](double x) {
+        return trigonometryValues(x, TrigFunctions::Sin | TrigFunctions::Cos);
+    }));
+    row("trigonometryValues, Sinh | Cosh | Tanh", perCall(angles, [](double x) {
+        return trigonometryValues(x, TrigFunctions::Sinh | TrigFunctions::Cosh | TrigFunctions::Tanh);
+    }));
+    row("std::sin", perCall(angles, [](double x) { return std::sin(x); }));
+
+    row("logarithmicFunctions (map)", perCall(positives, logarithmicFunctions));
+    row("logarithmicValues, All", perCall(positives, [](double x) { return logarithmicValues(x); }));
+    row("logarithmicValues, Ln", perCall(positives, [](double x) { return logarithmicValues(x, LogFunctions::Ln); }));
+
+    row("exponentialFunctions (map)", perCall(exponents, exponentialFunctions));
+    row("exponentialValues, All", perCall(exponents, [](double x) { return exponentialValues(x); }));
+    row("exponentialValues, Exp", perCall(exponents, [](double x) {
+        return exponentialValues(x, ExpFunctions::Exp);
+    }));
+}
@@ -0,0 +1,81 @@
+// Per-operation cost of 3D vector arithmetic through the pointer-returning
+// VectorOperations interface (a heap-allocated result per call, deleted here) against
+// DenseVector by value and in place. Each row runs the operation over a ring of
+// vectors so nothing folds away.
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "BenchUtil.h"
+#include "DenseVector.h"
+#include "VectorOperations.h"
+
+namespace {
+
+const int COUNT = 1024;
+const int ROUNDS = 1000;
+
+// Nanoseconds per call of op(i) over ROUNDS passes of i in [0, COUNT)
+template <typename Op>
+double perOp(Op op) {
+    double seconds = bench::bestTime(5, [&] {
+        for (int r = 0; r < ROUNDS; r++)
+            for (int i = 0; i < COUNT; i++)
+                op(i);
+    });
+    return seconds / (static_cast<double>(ROUNDS) * COUNT) * 1e9;
+}
+
+} // namespace
+
+int main() {
+    std::vector<double> values = bench::randomValues(3 * COUNT, 0.5, 1.5);
+    std::vector<Vector> adapters;
+    std::vector<DenseVector> dense;
+    for (int i = 0; i < COUNT; i++) {
+        adapters.emplace_back(std::vector<double>(values.begin() + 3 * i, values.begin() + 3 * i + 3));
+        dense.push_back(adapters.back().values());
+    }
+    auto next = [](int i) { return (i + 1) % COUNT; };
+    DenseVector sum(3);
+
+    std::printf("%-12s %14s %14s %14s\n", "3D op", "adapter ns", "value ns", "in place ns");
+    double adapterAdd = perOp([&](int i) {
+        std::unique_ptr<VectorOperations> r(adapters[i] + adapters[next(i)]);
+        bench::keep(r);
+    });
+    double valueAdd = perOp([&](int i) { bench::keep(dense[i] + dense[next(i)]); });
+    double inPlaceAdd = perOp([&](int i) { sum += dense[i]; });
+    std::printf("%-12s %14.2f %14.2f %14.2f\n", "add", adapterAdd, valueAdd, inPlaceAdd);
+
+    double adapterCross = perOp([&](int i) {
+        std::unique_ptr<VectorOperations> r(adapters[i].cross(adapters[next(i)]));
+        bench::keep(r);
+    });
+    double valueCross = perOp([&](int i) { bench::keep(dense[i].cross(dense[next(i)])); });
+    std::printf("%-12s %14.2f %14.2f %14s\n", "cross", adapterCross, valueCross, "-");
+
+    double adapterNormalize = perOp([&](int i) {
+        std::unique_ptr<VectorOperations> r(adapters[i].normalize());
+        bench::keep(r);
+    });
+    double valueNormalize = perOp([&](int i) { bench::keep(dense[i].normalize()); });
+    DenseVector scratch(3);
+    double inPlaceNormalize = perOp([&](int i) {
+        scratch = dense[i];
+        scratch.normalizeInPlace();
+        bench::keep(scratch);
+    });
+    std::printf("%-12s %14.2f %14.2f %14.2f\n", "normalize", adapterNormalize, valueNormalize, inPlaceNormalize);
+
+    double adapterProject = perOp([&](int i) {
+        std::unique_ptr<VectorOperations> r(adapters[i].projectOnto(adapters[next(i)]));
+        bench::keep(r);
+    });
+    double valueProject = perOp([&](int i) { bench::keep(dense[i].projectOnto(dense[next(i)])); });
+    std::printf("%-12s %14.2f %14.2f %14s\n", "projectOnto", adapterProject, valueProject, "-");
+
+    double adapterDot = perOp([&](int i) { bench::keep(adapters[i].dot(adapters[next(i)])); });
+    double valueDot = perOp([&](int i) { bench::keep(dense[i].dot(dense[next(i)])); });
+    std::printf("%-12s %14.2f %14.2f %14s\n", "dot", adapterDot, valueDot, "-");
+    bench::keep(sum);
+}
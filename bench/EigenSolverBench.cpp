@@ -0,0 +1,55 @@
+// EigenSolver timings for both paths, the symmetric one (tridiagonal QL) and the
+// general one (Hessenberg + shifted QR), with and without eigenvectors. The last
+// column is the largest residual |A v - lambda v| over all eigenpairs.
+#include <algorithm>
+#include <complex>
+#include <cstdio>
+#include <vector>
+#include "BenchUtil.h"
+#include "EigenSolver.h"
+#include "Matrix.h"
+
+namespace {
+
+Matrix randomMatrix(int n, bool symmetric) {
+    std::vector<double> values = bench::randomValues(static_cast<std::size_t>(n) * n);
+    Matrix m(n, n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            m.setElement(i, j, symmetric ? values[std::min(i, j) * n + std::max(i, j)] : values[i * n + j]);
+    return m;
+}
+
+double residual(const Matrix& a, const EigenSolver& solver) {
+    int n = a.getRows();
+    double worst = 0;
+    for (int k = 0; k < n; k++) {
+        std::complex<double> lambda = solver.eigenvalues()[k];
+        const std::vector<std::complex<double>>& v = solver.eigenvectors()[k];
+        for (int i = 0; i < n; i++) {
+            std::complex<double> sum = -lambda * v[i];
+            for (int j = 0; j < n; j++)
+                sum += a.getElement(i, j) * v[j];
+            worst = std::max(worst, std::abs(sum));
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    Matrix::setThreadCount(1);
+    std::printf("%6s %10s %14s %14s %10s\n", "n", "path", "values ms", "vectors ms", "residual");
+    for (int n : {50, 100, 200, 400}) {
+        for (bool symmetric : {true, false}) {
+            Matrix a = randomMatrix(n, symmetric);
+            int repeats = n <= 100 ? 5 : 2;
+            double valuesOnly = bench::bestTime(repeats, [&] { bench::keep(EigenSolver(a, false).eigenvalues()); });
+            double withVectors = bench::bestTime(repeats, [&] { bench::keep(EigenSolver(a, true).eigenvectors()); });
+            EigenSolver solver(a, true);
+            std::printf("%6d %10s %14.2f %14.2f %10.1e\n", n, solver.isSymmetric() ? "symmetric" : "general",
+                        valuesOnly * 1e3, withVectors * 1e3, residual(a, solver));
+        }
+    }
+}
@@ -0,0 +1,84 @@
+// FFTPlan against a naive O(n^2) DFT written on the project's Complex type, over
+// power-of-two, smooth mixed-radix and prime (Bluestein) lengths. The FFT is timed both
+// through the std::vector<Complex> interop and in place on std::complex<double>, with a
+// cached plan; the last column is the largest difference from the naive DFT relative
+// to the largest output. A real-input and a batched row follow.
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <numbers>
+#include <vector>
+#include "BenchUtil.h"
+#include "Complex.h"
+#include "FFT.h"
+#include "Matrix.h"
+
+namespace {
+
+std::vector<Complex> naiveDFT(const std::vector<Complex>& x) {
+    std::size_t n = x.size();
+    std::vector<Complex> roots(n);
+    for (std::size_t k = 0; k < n; k++) {
+        double angle = -2 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n);
+        roots[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+    std::vector<Complex> result(n);
+    for (std::size_t k = 0; k < n; k++) {
+        Complex sum;
+        for (std::size_t j = 0; j < n; j++)
+            sum = sum + x[j] * roots[j * k % n];
+        result[k] = sum;
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    Matrix::setThreadCount(1);
+    std::printf("%7s %10s %12s %14s %14s %10s\n", "n", "kind", "naive us", "Complex fft us", "in place us",
+                "rel diff");
+    for (int n : {64, 256, 1000, 1024, 1009, 4096, 4093, 65536, 1 << 20}) {
+        const std::vector<double> values = bench::randomValues(2 * static_cast<std::size_t>(n));
+        std::vector<Complex> signal(n);
+        std::vector<std::complex<double>> raw(n);
+        for (int i = 0; i < n; i++) {
+            signal[i] = Complex(values[2 * i], values[2 * i + 1]);
+            raw[i] = {values[2 * i], values[2 * i + 1]};
+        }
+        std::shared_ptr<const FFTPlan> plan = FFTPlan::get(n);
+        int repeats = n <= 4096 ? 20 : 5;
+        double fftTime = bench::bestTime(repeats, [&] { bench::keep(plan->forward(signal)); });
+        double inPlaceTime = bench::bestTime(repeats, [&] {
+            plan->forward(raw.data());
+            plan->inverse(raw.data());
+        }) / 2;
+        const char* kind = plan->usesBluestein() ? "bluestein" : "stockham";
+        if (n > 4096) {
+            std::printf("%7d %10s %12s %14.1f %14.1f %10s\n", n, kind, "-", fftTime * 1e6, inPlaceTime * 1e6, "-");
+            continue;
+        }
+        std::vector<Complex> naive;
+        double naiveTime = bench::bestTime(1, [&] { naive = naiveDFT(signal); });
+        std::vector<Complex> fast = plan->forward(signal);
+        double worst = 0, largest = 0;
+        for (int k = 0; k < n; k++) {
+            worst = std::max(worst, magnitude(fast[k] - naive[k]));
+            largest = std::max(largest, magnitude(naive[k]));
+        }
+        std::printf("%7d %10s %12.0f %14.1f %14.1f %10.1e\n", n, kind, naiveTime * 1e6, fftTime * 1e6,
+                    inPlaceTime * 1e6, worst / largest);
+    }
+
+    const int n = 4096, count = 256;
+    std::vector<double> signals = bench::randomValues(static_cast<std::size_t>(n) * count);
+    std::vector<std::complex<double>> spectra(static_cast<std::size_t>(RealFFTPlan(n).spectrumSize()) * count);
+    std::vector<std::complex<double>> complexSignals(signals.begin(), signals.end());
+    std::shared_ptr<const RealFFTPlan> realPlan = RealFFTPlan::get(n);
+    std::shared_ptr<const FFTPlan> plan = FFTPlan::get(n);
+    double realTime = bench::bestTime(5, [&] { realPlan->forward(signals.data(), spectra.data(), count); });
+    double complexTime = bench::bestTime(5, [&] { plan->forward(complexSignals.data(), count); });
+    std::printf("\n%d signals of %d: real batch %.2f ms, complex batch %.2f ms\n", count, n, realTime * 1e3,
+                complexTime * 1e3);
+}
@@ -0,0 +1,66 @@
+// Fraction addition cost on the inline 64-bit path and after promotion to BigInteger,
+// from harmonic sums H_n = 1 + 1/2 + ... + 1/n, whose reduced value outgrows 64 bits
+// at n = 47. The reference is the unchecked long long fraction the class replaced
+// (Euclid gcd, no overflow detection), which is fast and silently wrong past that point.
+// It wraps modulo 2^64 here rather than overflowing, to stay well-defined.
+#include <cstdio>
+#include <numeric>
+#include <vector>
+#include "BenchUtil.h"
+#include "Fraction.h"
+
+namespace {
+
+struct PlainFraction {
+    long long num, den;
+};
+
+PlainFraction add(PlainFraction a, PlainFraction b) {
+    using U = unsigned long long;
+    long long num = static_cast<long long>(U(a.num) * U(b.den) + U(b.num) * U(a.den));
+    long long den = static_cast<long long>(U(a.den) * U(b.den));
+    long long g = std::gcd(num, den);
+    return {num / g, den / g};
+}
+
+} // namespace
+
+int main() {
+    std::printf("%6s %16s %16s %10s %12s\n", "n", "Fraction ns/add", "plain ns/add", "promoted", "plain right");
+    for (int n : {10, 20, 30, 46, 47, 50, 100, 400, 1000}) {
+        Fraction sum;
+        double fractionTime = bench::bestTime(n <= 100 ? 200 : 3, [&] {
+            sum = Fraction();
+            for (int k = 1; k <= n; k++)
+                sum += Fraction(1, k);
+            bench::keep(sum);
+        });
+        PlainFraction plain{0, 1};
+        double plainTime = bench::bestTime(n <= 100 ? 200 : 3, [&] {
+            plain = {0, 1};
+            for (int k = 1; k <= n; k++)
+                plain = add(plain, {1, k});
+            bench::keep(plain);
+        });
+        bool plainRight = sum == Fraction(plain.num, plain.den);
+        std::printf("%6d %16.1f %16.1f %10s %12s\n", n, fractionTime / n * 1e9, plainTime / n * 1e9,
+                    sum.isPromoted() ? "yes" : "no", plainRight ? "yes" : "no");
+    }
+
+    // Random small fractions: the common case stays on the inline path
+    const int count = 1 << 16;
+    std::vector<double> values = bench::randomValues(2 * count, 1.0, 1000.0);
+    std::vector<Fraction> operands;
+    for (int i = 0; i < count; i++)
+        operands.emplace_back(static_cast<long long>(values[2 * i]) - 500, static_cast<long long>(values[2 * i + 1]));
+    double multiplyTime = bench::bestTime(5, [&] {
+        for (int i = 0; i + 1 < count; i++)
+            bench::keep(operands[i] * operands[i + 1]);
+    });
+    double addTime = bench::bestTime(5, [&] {
+        for (int i = 0; i + 1 < count; i++)
+            bench::keep(operands[i] + operands[i + 1]);
+    });
+    std::printf("\nsmall operands: %.1f ns per add, %.1f ns per multiply\n", addTime / (count - 1) * 1e9,
+                multiplyTime / (count - 1) * 1e9);
+}
@@ -0,0 +1,105 @@
+// gcd64 and gcd128 against std::gcd and the division-based Euclid loop they replaced,
+// on random operand pairs of several shapes, then the span reductions and elementwise
+// forms against plain loops. Times are nanoseconds per gcd.
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "BenchUtil.h"
+#include "NumberTheory.h"
+
+namespace {
+
+const std::size_t PAIRS = 1 << 16;
+
+template <typename T>
+T euclid(T a, T b) {
+    while (b != 0) {
+        T r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Pairs of the given bit widths (each operand uniform below 2^bits)
+template <typename T>
+void pairs(int aBits, int bBits, std::vector<T>& a, std::vector<T>& b, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    auto draw = [&](int bits) {
+        T v = (static_cast<T>(rng()) << 64 % (sizeof(T) * 8)) ^ static_cast<T>(rng());
+        return bits >= static_cast<int>(sizeof(T) * 8) ? v : (v & ((T(1) << bits) - 1)) | 1;
+    };
+    a.resize(PAIRS);
+    b.resize(PAIRS);
+    for (std::size_t i = 0; i < PAIRS; i++) {
+        a[i] = draw(aBits);
+        b[i] = draw(bBits);
+    }
+}
+
+// Nanoseconds per gcd(a[i], b[i])
+template <typename T, typename Gcd>
+double perGcd(const std::vector<T>& a, const std::vector<T>& b, Gcd gcd) {
+    T sink = 0;
+    double seconds = bench::bestTime(5, [&] {
+        for (std::size_t i = 0; i < PAIRS; i++)
+            sink += gcd(a[i], b[i]);
+    });
+    bench::keep(sink);
+    return seconds / PAIRS * 1e9;
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-22s %10s %10s %10s\n", "64-bit operands", "gcd64", "std::gcd", "euclid");
+    struct Shape {
+        const char* name;
+        int aBits, bBits;
+    };
+    for (Shape s : {Shape{"64 x 64 bits", 64, 64}, Shape{"32 x 32 bits", 32, 32}, Shape{"16 x 16 bits", 16, 16},
+                    Shape{"64 x 8 bits", 64, 8}}) {
+        std::vector<std::uint64_t> a, b;
+        pairs(s.aBits, s.bBits, a, b, s.aBits * 100 + s.bBits);
+        std::printf("%-22s %10.1f %10.1f %10.1f\n", s.name, perGcd(a, b, numbertheory::gcd64),
+                    perGcd(a, b, [](std::uint64_t x, std::uint64_t y) { return std::gcd(x, y); }),
+                    perGcd(a, b, euclid<std::uint64_t>));
+    }
+
+    std::printf("\n%-22s %10s %10s\n", "128-bit operands", "gcd128", "euclid");
+    for (Shape s : {Shape{"128 x 128 bits", 128, 128}, Shape{"128 x 64 bits", 128, 64}, Shape{"96 x 96 bits", 96, 96}}) {
+        std::vector<unsigned __int128> a, b;
+        pairs(s.aBits, s.bBits, a, b, s.aBits * 100 + s.bBits);
+        std::printf("%-22s %10.1f %10.1f\n", s.name, perGcd(a, b, numbertheory::gcd128),
+                    perGcd(a, b, euclid<unsigned __int128>));
+    }
+
+    // Reductions and elementwise forms over 2^22 values sharing a factor of 3 * 2^5,
+    // so the gcd reduction cannot stop early
+    const std::size_t n = std::size_t(1) << 22;
+    std::mt19937_64 rng(9);
+    std::vector<std::uint64_t> values(n), other(n), out(n);
+    for (std::size_t i = 0; i < n; i++) {
+        values[i] = 96 * (rng() >> 8);
+        other[i] = rng() >> 1;
+    }
+    double loopReduce = bench::bestTime(3, [&] {
+        std::uint64_t g = 0;
+        for (std::uint64_t v : values)
+            g = std::gcd(g, v);
+        bench::keep(g);
+    });
+    double spanReduce = bench::bestTime(3, [&] { bench::keep(numbertheory::gcd(values)); });
+    double loopElementwise = bench::bestTime(3, [&] {
+        for (std::size_t i = 0; i < n; i++)
+            out[i] = std::gcd(values[i], other[i]);
+        bench::keep(out);
+    });
+    double spanElementwise = bench::bestTime(3, [&] { numbertheory::gcd(values, other, out); });
+    std::printf("\n2^22 values, ms:   std::gcd loop  numbertheory\n");
+    std::printf("gcd reduction      %13.1f %13.1f  (result %llu)\n", loopReduce * 1e3, spanReduce * 1e3,
+                static_cast<unsigned long long>(numbertheory::gcd(values)));
+    std::printf("elementwise gcd    %13.1f %13.1f\n", loopElementwise * 1e3, spanElementwise * 1e3);
+}
@@ -0,0 +1,255 @@
+// Accuracy harness for MathKernels.h. For each function and tier it reports the largest
+// error over random arguments in several ranges, in ulps of the correctly rounded
+// result, using the long double C library (64-bit significand) as the reference; the
+// double C library is measured the same way for comparison. Special values (NaN, +-inf,
+// +-0, subnormals, huge arguments, overflowing and subnormal results) are the ones the
+// kernels hand to the C library, so they must match it bit for bit. Exits non-zero if
+// an Accurate result is more than 1 ulp off (other than one taken from the C library,
+// which is itself up to about 2 ulps off for sinh, cosh and tanh), a Fast result has a
+// relative error above 1e-12, or a special value differs.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+#include "MathKernels.h"
+
+namespace {
+
+using mathkernels::Accuracy;
+using Kernel = void (*)(const double*, double*, std::size_t, Accuracy);
+
+const std::size_t SAMPLES = 1 << 20;
+const double INF = std::numeric_limits<double>::infinity();
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+const double DENORM = std::numeric_limits<double>::denorm_min();
+const double TINY = std::numeric_limits<double>::min();
+const double HUGE_VALUE = std::numeric_limits<double>::max();
+
+struct Function {
+    const char* name;
+    Kernel kernel;
+    double (*libm)(double);
+    long double (*reference)(long double);
+};
+
+struct Range {
+    double lo, hi;
+    bool logarithmic; // log-uniform magnitude in [lo, hi] with a random sign if lo < 0
+};
+
+// Error of `computed` in ulps of the double nearest to `exact`
+double ulpError(double computed, long double exact) {
+    if (std::isnan(computed) || std::isnan(static_cast<double>(exact)))
+        return std::isnan(computed) && std::isnan(static_cast<double>(exact)) ? 0 : INF;
+    double rounded = static_cast<double>(exact);
+    if (std::isinf(rounded) || std::isinf(computed))
+        return computed == rounded ? 0 : INF;
+    double ulp = std::nextafter(std::abs(rounded), INF) - std::abs(rounded);
+    return static_cast<double>(std::abs(static_cast<long double>(computed) - exact) / ulp);
+}
+
+std::vector<double> sample(const Range& range, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<double> xs(SAMPLES);
+    if (!range.logarithmic) {
+        std::uniform_real_distribution<double> dist(range.lo, range.hi);
+        for (double& x : xs)
+            x = dist(rng);
+        return xs;
+    }
+    double lo = std::abs(range.lo) < std::abs(range.hi) ? std::abs(range.lo) : std::abs(range.hi);
+    double hi = std::abs(range.lo) < std::abs(range.hi) ? std::abs(range.hi) : std::abs(range.lo);
+    if (range.lo < 0 && range.hi > 0)
+        lo = TINY;
+    std::uniform_real_distribution<double> exponent(std::log2(lo), std::log2(hi));
+    for (double& x : xs) {
+        x = std::exp2(exponent(rng));
+        if (range.lo < 0 && (range.hi <= 0 || (rng() & 1)))
+            x = -x;
+    }
+    return xs;
+}
+
+bool sameResult(double a, double b) {
+    if (std::isnan(a) || std::isnan(b))
+        return std::isnan(a) && std::isnan(b);
+    return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+struct Errors {
+    double accurate = 0, fast = 0, libm = 0, fastRelative = 0;
+    int accurateOver = 0; // Accurate results above 1 ulp that are not the C library's
+};
+
+template <typename Reference, typename Libm, typename Run>
+Errors measure(const std::vector<double>& xs, Reference reference, Libm libm, Run run) {
+    Errors e;
+    std::vector<double> accurate(xs.size()), fast(xs.size());
+    run(accurate.data(), Accuracy::Accurate);
+    run(fast.data(), Accuracy::Fast);
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        long double exact = reference(i);
+        double accurateError = ulpError(accurate[i], exact);
+        e.accurate = std::max(e.accurate, accurateError);
+        e.accurateOver += accurateError > 1.0 && !sameResult(accurate[i], libm(i));
+        e.fast = std::max(e.fast, ulpError(fast[i], exact));
+        e.libm = std::max(e.libm, ulpError(libm(i), exact));
+        // Subnormal results carry fewer significant bits, so only normal ones count
+        if (std::isfinite(static_cast<double>(exact)) && std::abs(exact) >= TINY)
+            e.fastRelative = std::max(e.fastRelative,
+                                      static_cast<double>(std::abs((fast[i] - exact) / exact)));
+    }
+    return e;
+}
+
+bool report(const char* name, const char* range, const Errors& e) {
+    bool ok = e.accurateOver == 0 && e.fastRelative <= 1e-12;
+    std::printf("%-7s %-32s %10.3f %10.3f %12.1e %10.3f %s\n", name, range, e.accurate, e.fast, e.fastRelative,
+                e.libm, ok ? "" : "FAIL");
+    return ok;
+}
+
+// Special arguments, each followed by two ordinary values so that blocks of four mix
+// the two; only the special results are compared
+int checkSpecials(const char* name, const std::vector<double>& specials, Kernel kernel, double (*libm)(double)) {
+    int failures = 0;
+    for (Accuracy accuracy : {Accuracy::Accurate, Accuracy::Fast}) {
+        std::vector<double> xs;
+        for (double s : specials) {
+            xs.push_back(s);
+            xs.push_back(0.5);
+            xs.push_back(0.25);
+        }
+        std::vector<double> out(xs.size());
+        kernel(xs.data(), out.data(), xs.size(), accuracy);
+        for (std::size_t i = 0; i < xs.size(); i += 3) {
+            if (!sameResult(out[i], libm(xs[i]))) {
+                std::printf("  %s(%a) = %a, C library %a (%s)\n", name, xs[i], out[i], libm(xs[i]),
+                            accuracy == Accuracy::Accurate ? "accurate" : "fast");
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    std::printf("implementation: %s\n\n", mathkernels::implementation());
+    std::printf("%-7s %-32s %10s %10s %12s %10s\n", "", "range", "accurate", "fast", "fast rel",
+                "C library");
+    std::printf("%-7s %-32s %10s %10s %12s %10s\n", "", "", "max ulp", "max ulp", "max error", "max ulp");
+
+    const double PI = 3.141592653589793;
+    const double TWO20 = 1048576.0;
+    struct Case {
+        Function function;
+        std::vector<Range> ranges;
+    };
+    std::vector<Case> cases = {
+        {{"sin", mathkernels::sin, std::sin, sinl}, {{-PI, PI, false}, {-1e3, 1e3, false}, {-TWO20, TWO20, false}, {1e-300, 1e-3, true}}},
+        {{"cos", mathkernels::cos, std::cos, cosl}, {{-PI, PI, false}, {-1e3, 1e3, false}, {-TWO20, TWO20, false}, {1e-300, 1e-3, true}}},
+        {{"tan", mathkernels::tan, std::tan, tanl}, {{-PI / 2, PI / 2, false}, {-1e3, 1e3, false}, {-TWO20, TWO20, false}, {1e-300, 1e-3, true}}},
+        {{"exp", mathkernels::exp, std::exp, expl}, {{-1, 1, false}, {-708, 709.7, false}, {-745, -708, false}, {1e-300, 1e-3, true}}},
+        {{"log", mathkernels::log, std::log, logl}, {{0.5, 2, false}, {1e-300, 1e300, true}, {0.999, 1.001, false}}},
+        {{"log2", mathkernels::log2, std::log2, log2l}, {{0.5, 2, false}, {1e-300, 1e300, true}, {0.999, 1.001, false}}},
+        {{"log10", mathkernels::log10, std::log10, log10l}, {{0.5, 2, false}, {1e-300, 1e300, true}, {0.999, 1.001, false}}},
+        {{"sinh", mathkernels::sinh, std::sinh, sinhl}, {{-1, 1, false}, {-710, 710, false}, {1e-300, 1e-3, true}}},
+        {{"cosh", mathkernels::cosh, std::cosh, coshl}, {{-1, 1, false}, {-710, 710, false}}},
+        {{"tanh", mathkernels::tanh, std::tanh, tanhl}, {{-1, 1, false}, {-20, 20, false}, {1e-300, 1e-3, true}}},
+    };
+
+    bool ok = true;
+    unsigned seed = 1;
+    for (const Case& c : cases) {
+        const Function& f = c.function;
+        for (const Range& range : c.ranges) {
+            std::vector<double> xs = sample(range, seed++);
+            Errors e = measure(
+                xs, [&](std::size_t i) { return f.reference(xs[i]); }, [&](std::size_t i) { return f.libm(xs[i]); },
+                [&](double* out, Accuracy accuracy) { f.kernel(xs.data(), out, xs.size(), accuracy); });
+            char label[64];
+            std::snprintf(label, sizeof label, "%s[%g, %g]", range.logarithmic ? "log " : "", range.lo, range.hi);
+            ok &= report(f.name, label, e);
+        }
+    }
+
+    // pow: both arguments random, then the scalar-exponent form
+    {
+        std::vector<double> xs = sample({1e-3, 1e3, true}, seed++), ys = sample({-50, 50, false}, seed++);
+        Errors e = measure(
+            xs, [&](std::size_t i) { return powl(xs[i], ys[i]); }, [&](std::size_t i) { return std::pow(xs[i], ys[i]); },
+            [&](double* out, Accuracy accuracy) { mathkernels::pow(xs.data(), ys.data(), out, xs.size(), accuracy); });
+        ok &= report("pow", "x log[1e-3, 1e3], y [-50, 50]", e);
+        std::vector<double> near = sample({0.99, 1.01, false}, seed++), big = sample({-5e4, 5e4, false}, seed++);
+        e = measure(
+            near, [&](std::size_t i) { return powl(near[i], big[i]); }, [&](std::size_t i) { return std::pow(near[i], big[i]); },
+            [&](double* out, Accuracy accuracy) { mathkernels::pow(near.data(), big.data(), out, near.size(), accuracy); });
+        ok &= report("pow", "x [0.99, 1.01], y [-5e4, 5e4]", e);
+        for (double y : {0.5, -1.0 / 3, 2.5, 17.0}) {
+            e = measure(
+                xs, [&](std::size_t i) { return powl(xs[i], y); }, [&](std::size_t i) { return std::pow(xs[i], y); },
+                [&](double* out, Accuracy accuracy) { mathkernels::pow(xs.data(), y, out, xs.size(), accuracy); });
+            char label[64];
+            std::snprintf(label, sizeof label, "x log[1e-3, 1e3], y = %g", y);
+            ok &= report("pow", label, e);
+        }
+    }
+
+    // Special values against the double C library
+    std::vector<double> common = {NaN, -NaN, INF, -INF, 0.0, -0.0, DENORM, -DENORM, TINY, -TINY, HUGE_VALUE, -HUGE_VALUE};
+    std::vector<double> trig = common;
+    for (double x : {std::nextafter(TWO20, INF), -std::nextafter(TWO20, INF), 1e22, 1e300})
+        trig.push_back(x);
+    std::vector<double> exponential = common; // overflowing and subnormal results
+    for (double x : {709.79, 710.0, -708.4, -745.13321910194, -745.2})
+        exponential.push_back(x);
+    std::vector<double> logarithm = common;
+    for (double x : {-1.0, -1e-300})
+        logarithm.push_back(x);
+    std::vector<double> hyperbolic = common;
+    for (double x : {710.0, -710.0, 710.5})
+        hyperbolic.push_back(x);
+    int failures = 0;
+    failures += checkSpecials("sin", trig, mathkernels::sin, std::sin);
+    failures += checkSpecials("cos", trig, mathkernels::cos, std::cos);
+    failures += checkSpecials("tan", trig, mathkernels::tan, std::tan);
+    failures += checkSpecials("exp", exponential, mathkernels::exp, std::exp);
+    failures += checkSpecials("log", logarithm, mathkernels::log, std::log);
+    failures += checkSpecials("log2", logarithm, mathkernels::log2, std::log2);
+    failures += checkSpecials("log10", logarithm, mathkernels::log10, std::log10);
+    failures += checkSpecials("sinh", hyperbolic, mathkernels::sinh, std::sinh);
+    failures += checkSpecials("cosh", hyperbolic, mathkernels::cosh, std::cosh);
+    failures += checkSpecials("tanh", hyperbolic, mathkernels::tanh, std::tanh);
+
+    // pow: every pairing of these bases and exponents, in both forms, compared where the
+    // base is not a positive normal number, the exponent is not finite, or the result
+    // overflows or is subnormal
+    std::vector<double> powSpecial = {NaN, INF, -INF, 0.0, -0.0, 1.0, -1.0, 0.5, 2.0, -2.0, DENORM, HUGE_VALUE, -HUGE_VALUE};
+    std::vector<double> powExponent = {NaN, INF, -INF, 0.0, -0.0, 1.0, -1.0, 0.5, 2.0, 3.0, -3.0, 1e300, 1075.0, -1075.0};
+    for (Accuracy accuracy : {Accuracy::Accurate, Accuracy::Fast}) {
+        for (double y : powExponent) {
+            std::vector<double> ys(powSpecial.size(), y), out(powSpecial.size()), scalarOut(powSpecial.size());
+            mathkernels::pow(powSpecial.data(), ys.data(), out.data(), out.size(), accuracy);
+            mathkernels::pow(powSpecial.data(), y, scalarOut.data(), out.size(), accuracy);
+            for (std::size_t i = 0; i < out.size(); i++) {
+                double x = powSpecial[i], expected = std::pow(x, y);
+                bool special = !(x >= TINY && x <= HUGE_VALUE) || !std::isfinite(y) || !std::isfinite(expected) ||
+                               std::abs(expected) < TINY;
+                if (special && (!sameResult(out[i], expected) || !sameResult(scalarOut[i], expected))) {
+                    std::printf("  pow(%a, %a) = %a / %a, C library %a\n", powSpecial[i], y, out[i], scalarOut[i],
+                                expected);
+                    failures++;
+                }
+            }
+        }
+    }
+    std::printf("\nspecial values differing from the C library: %d\n", failures);
+    ok &= failures == 0;
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+// Throughput of the MathKernels.h array functions in both tiers against a loop over the
+// C library, on 2^20 arguments per call drawn from each function's usual range.
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "BenchUtil.h"
+#include "Matrix.h"
+#include "MathKernels.h"
+
+namespace {
+
+using mathkernels::Accuracy;
+
+const std::size_t N = std::size_t(1) << 20;
+
+void row(const char* name, double libm, double accurate, double fast) {
+    std::printf("%-8s %12.0f %12.0f %12.0f %10.1f %10.1f\n", name, N / libm * 1e-6, N / accurate * 1e-6,
+                N / fast * 1e-6, libm / accurate, libm / fast);
+}
+
+void unary(const char* name, void (*kernel)(const double*, double*, std::size_t, Accuracy), double (*libm)(double),
+           double lo, double hi) {
+    std::vector<double> x = bench::randomValues(N, lo, hi), out(N);
+    double libmTime = bench::bestTime(5, [&] {
+        for (std::size_t i = 0; i < N; i++)
+            out[i] = libm(x[i]);
+        bench::keep(out);
+    });
+    double accurateTime = bench::bestTime(5, [&] { kernel(x.data(), out.data(), N, Accuracy::Accurate); });
+    double fastTime = bench::bestTime(5, [&] { kernel(x.data(), out.data(), N, Accuracy::Fast); });
+    row(name, libmTime, accurateTime, fastTime);
+}
+
+} // namespace
+
+int main() {
+    Matrix::setThreadCount(1);
+    std::printf("implementation: %s, single thread\n\n", mathkernels::implementation());
+    std::printf("%-8s %12s %12s %12s %10s %10s\n", "", "C library", "accurate", "fast", "accurate", "fast");
+    std::printf("%-8s %12s %12s %12s %10s %10s\n", "", "Mvalues/s", "Mvalues/s", "Mvalues/s", "speedup", "speedup");
+    unary("sin", mathkernels::sin, std::sin, -100, 100);
+    unary("cos", mathkernels::cos, std::cos, -100, 100);
+    unary("tan", mathkernels::tan, std::tan, -100, 100);
+    unary("exp", mathkernels::exp, std::exp, -700, 700);
+    unary("log", mathkernels::log, std::log, 1e-3, 1e6);
+    unary("log2", mathkernels::log2, std::log2, 1e-3, 1e6);
+    unary("log10", mathkernels::log10, std::log10, 1e-3, 1e6);
+    unary("sinh", mathkernels::sinh, std::sinh, -20, 20);
+    unary("cosh", mathkernels::cosh, std::cosh, -20, 20);
+    unary("tanh", mathkernels::tanh, std::tanh, -5, 5);
+
+    std::vector<double> x = bench::randomValues(N, 1e-3, 1e3), y = bench::randomValues(N, -20, 20), out(N);
+    double libmTime = bench::bestTime(5, [&] {
+        for (std::size_t i = 0; i < N; i++)
+            out[i] = std::pow(x[i], y[i]);
+        bench::keep(out);
+    });
+    double accurateTime = bench::bestTime(5, [&] { mathkernels::pow(x.data(), y.data(), out.data(), N); });
+    double fastTime = bench::bestTime(5, [&] { mathkernels::pow(x.data(), y.data(), out.data(), N, Accuracy::Fast); });
+    row("pow", libmTime, accurateTime, fastTime);
+    libmTime = bench::bestTime(5, [&] {
+        for (std::size_t i = 0; i < N; i++)
+            out[i] = std::pow(x[i], 2.5);
+        bench::keep(out);
+    });
+    accurateTime = bench::bestTime(5, [&] { mathkernels::pow(x.data(), 2.5, out.data(), N); });
+    fastTime = bench::bestTime(5, [&] { mathkernels::pow(x.data(), 2.5, out.data(), N, Accuracy::Fast); });
+    row("pow(x,c)", libmTime, accurateTime, fastTime);
+}
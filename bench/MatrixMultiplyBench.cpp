@@ -0,0 +1,53 @@
+// GFLOP/s of Matrix::operator* against the original implementation: a vector of row
+// vectors multiplied with the plain i-j-k loop. Runs single-threaded so the kernel
+// itself is measured; see ThreadScalingBench for the parallel path.
+#include <cstdio>
+#include <vector>
+#include "BenchUtil.h"
+#include "Matrix.h"
+
+namespace {
+
+using Rows = std::vector<std::vector<double>>;
+
+// The multiply as it was before the contiguous storage and blocked kernel
+Rows multiplyRows(const Rows& a, const Rows& b) {
+    int n = static_cast<int>(a.size()), m = static_cast<int>(b[0].size()), p = static_cast<int>(b.size());
+    Rows result(n, std::vector<double>(m, 0.0));
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < m; j++)
+            for (int k = 0; k < p; k++)
+                result[i][j] += a[i][k] * b[k][j];
+    return result;
+}
+
+} // namespace
+
+int main() {
+    Matrix::setThreadCount(1);
+    std::printf("%6s %14s %14s %10s\n", "n", "rows GFLOP/s", "Matrix GFLOP/s", "max diff");
+    for (int n : {32, 64, 128, 256, 512, 1024}) {
+        std::vector<double> values = bench::randomValues(2 * static_cast<std::size_t>(n) * n);
+        Matrix a(n, n), b(n, n);
+        Rows ra(n, std::vector<double>(n)), rb(n, std::vector<double>(n));
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                ra[i][j] = values[i * n + j];
+                rb[i][j] = values[n * n + i * n + j];
+                a.setElement(i, j, ra[i][j]);
+                b.setElement(i, j, rb[i][j]);
+            }
+        }
+        double flops = 2.0 * n * n * n;
+        int repeats = n <= 256 ? 5 : 2;
+        Rows rc;
+        Matrix c(n, n);
+        double rowsTime = bench::bestTime(n <= 512 ? repeats : 1, [&] { rc = multiplyRows(ra, rb); });
+        double matrixTime = bench::bestTime(repeats, [&] { c = a * b; });
+        double diff = 0;
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                diff = std::max(diff, std::abs(c.getElement(i, j) - rc[i][j]));
+        std::printf("%6d %14.2f %14.2f %10.1e\n", n, flops / rowsTime * 1e-9, flops / matrixTime * 1e-9, diff);
+    }
+}
@@ -0,0 +1,22 @@
+// Polynomial multiply crossovers: schoolbook, Karatsuba and FFT on two operands of n
+// coefficients each, next to the size-dispatched polymul::multiply. The thresholds in
+// PolyMul.h should sit where the fastest column changes.
+#include <cstdio>
+#include <vector>
+#include "BenchUtil.h"
+#include "PolyMul.h"
+
+int main() {
+    std::printf("KARATSUBA_THRESHOLD = %d, FFT_THRESHOLD = %d\n", polymul::KARATSUBA_THRESHOLD,
+                polymul::FFT_THRESHOLD);
+    std::printf("%6s %14s %14s %14s %14s\n", "n", "schoolbook us", "karatsuba us", "fft us", "dispatch us");
+    for (int n : {8, 16, 32, 48, 64, 80, 96, 112, 128, 256, 320, 384, 512, 1024, 4096}) {
+        std::vector<double> a = bench::randomValues(n, -1.0, 1.0, 1), b = bench::randomValues(n, -1.0, 1.0, 2);
+        int repeats = n <= 512 ? 200 : 10;
+        auto time = [&](std::vector<double> (*multiply)(const std::vector<double>&, const std::vector<double>&)) {
+            return bench::bestTime(repeats, [&] { bench::keep(multiply(a, b)); }) * 1e6;
+        };
+        std::printf("%6d %14.2f %14.2f %14.2f %14.2f\n", n, time(polymul::multiplySchoolbook),
+                    time(polymul::multiplyKaratsuba), time(polymul::multiplyFFT), time(polymul::multiply));
+    }
+}
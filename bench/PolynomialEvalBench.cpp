@@ -0,0 +1,41 @@
+// Polynomial evaluation throughput: a loop over the scalar Horner evaluate(x) against
+// the batch evaluate(xs, out), which runs one point per SIMD lane and splits large
+// inputs across the thread pool. Points are uniform in [-1, 1]; fewer are used at high
+// degrees to bound the run time. Differences are relative to sum |c_k|, the largest
+// |p(x)| can be on [-1, 1].
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <span>
+#include <vector>
+#include "BenchUtil.h"
+#include "Polynomial.h"
+
+int main() {
+    std::printf("%8s %16s %16s %8s %12s\n", "degree", "scalar Mpts/s", "batch Mpts/s", "speedup", "max diff");
+    for (int degree : {4, 16, 64, 256, 1024, 4096}) {
+        std::size_t points = std::min(std::size_t(1) << 20, (std::size_t(1) << 28) / degree);
+        std::vector<double> xs = bench::randomValues(points, -1.0, 1.0, 2);
+        std::vector<double> scalar(points), batch(points);
+        std::vector<double> coefficients = bench::randomValues(degree + 1, -1.0, 1.0, degree);
+        Polynomial p(degree, coefficients);
+        double scale = 0;
+        for (double c : coefficients)
+            scale += std::abs(c);
+        int repeats = degree <= 256 ? 5 : 2;
+        double scalarTime = bench::bestTime(repeats, [&] {
+            for (std::size_t i = 0; i < points; i++)
+                scalar[i] = p.evaluate(xs[i]);
+            bench::keep(scalar);
+        });
+        double batchTime = bench::bestTime(repeats, [&] {
+            p.evaluate(std::span<const double>(xs), std::span<double>(batch));
+            bench::keep(batch);
+        });
+        double worst = 0;
+        for (std::size_t i = 0; i < points; i++)
+            worst = std::max(worst, std::abs(batch[i] - scalar[i]) / scale);
+        std::printf("%8d %16.1f %16.1f %8.2f %12.1e\n", degree, points / scalarTime * 1e-6,
+                    points / batchTime * 1e-6, scalarTime / batchTime, worst);
+    }
+}
@@ -0,0 +1,66 @@
+// Accuracy check for Polynomial::evaluateMultipoint at high degree. Each case compares
+// it against the batch evaluate() on random coefficients in [-1, 1] and reports the
+// largest difference next to the largest |p(x)|, with both timings. A result may be off
+// by at most 16 times Horner's bound n eps sum |c_k| R^k, R the largest |x|, and
+// evaluate() by that bound once more; exits non-zero if a difference exceeds 18 times
+// it.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <span>
+#include <vector>
+#include "BenchUtil.h"
+#include "Polynomial.h"
+
+namespace {
+
+struct Case {
+    int degree;
+    std::size_t points;
+    double lo, hi;
+};
+
+} // namespace
+
+int main() {
+    const double eps = std::numeric_limits<double>::epsilon();
+    const Case cases[] = {
+        {2000, 1001, -1.0, 1.0},   {4000, 1001, -1.0, 1.0},    {4000, 5000, -1.0, 1.0},
+        {2000, 20000, -0.5, 0.5},  {4000, 20000, -0.05, 0.05}, {8000, 20000, -0.05, 0.05},
+    };
+    bool ok = true;
+    std::printf("%8s %8s %16s %12s %12s %12s %12s %12s\n", "degree", "points", "range", "max |p|", "max diff",
+                "allowed", "Horner ms", "multi ms");
+    for (const Case& c : cases) {
+        std::vector<double> coefficients = bench::randomValues(c.degree + 1, -1.0, 1.0, c.degree);
+        std::vector<double> xs = bench::randomValues(c.points, c.lo, c.hi, 3);
+        Polynomial p(c.degree, coefficients);
+        std::vector<double> horner(c.points), multi(c.points);
+        double hornerTime = bench::bestTime(3, [&] {
+            p.evaluate(std::span<const double>(xs), std::span<double>(horner));
+            bench::keep(horner);
+        });
+        double multiTime = bench::bestTime(3, [&] {
+            p.evaluateMultipoint(std::span<const double>(xs), std::span<double>(multi));
+            bench::keep(multi);
+        });
+
+        double radius = std::max(std::abs(c.lo), std::abs(c.hi)), bound = 0;
+        for (double coefficient : coefficients)
+            bound = bound * radius + std::abs(coefficient);
+        double allowed = 18.0 * eps * (c.degree + 1) * bound;
+        double worst = 0, largest = 0;
+        for (std::size_t i = 0; i < c.points; i++) {
+            double diff = std::abs(multi[i] - horner[i]);
+            worst = std::isnan(diff) ? diff : std::max(worst, diff);
+            largest = std::max(largest, std::abs(horner[i]));
+        }
+        bool pass = worst <= allowed;
+        ok &= pass;
+        std::printf("%8d %8zu [%6.2f,%5.2f] %12.3g %12.3g %12.3g %12.2f %12.2f%s\n", c.degree, c.points, c.lo, c.hi,
+                    largest, worst, allowed, hornerTime * 1e3, multiTime * 1e3, pass ? "" : "  <-");
+    }
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
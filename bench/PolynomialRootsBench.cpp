@@ -0,0 +1,69 @@
+// All-roots timings: Polynomial::findRoots (Aberth-Ehrlich) against the eigenvalues of
+// the companion matrix through EigenSolver, the usual dense approach, on random
+// coefficients. Then findRootsBatch against a loop of findRoots over many polynomials.
+#include <algorithm>
+#include <complex>
+#include <cstdio>
+#include <vector>
+#include "BenchUtil.h"
+#include "EigenSolver.h"
+#include "Matrix.h"
+#include "Polynomial.h"
+
+namespace {
+
+// Eigenvalues of the companion matrix of the monic polynomial c / c[0]
+std::vector<std::complex<double>> companionRoots(const std::vector<double>& c) {
+    int n = static_cast<int>(c.size()) - 1;
+    Matrix companion(n, n);
+    for (int j = 0; j < n; j++)
+        companion.setElement(0, j, -c[j + 1] / c[0]);
+    for (int i = 1; i < n; i++)
+        companion.setElement(i, i - 1, 1.0);
+    return EigenSolver(companion, false).eigenvalues();
+}
+
+// Largest |p(z)| / sum |c_k| |z|^k over the roots, the backward error of the set
+double backwardError(const std::vector<double>& c, const std::vector<std::complex<double>>& roots) {
+    double worst = 0;
+    for (std::complex<double> z : roots) {
+        std::complex<double> value = 0;
+        double scale = 0;
+        for (double ck : c) {
+            value = value * z + ck;
+            scale = scale * std::abs(z) + std::abs(ck);
+        }
+        worst = std::max(worst, std::abs(value) / scale);
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    Matrix::setThreadCount(1);
+    std::printf("%7s %12s %6s %10s %14s %10s\n", "degree", "aberth ms", "iters", "error", "companion ms", "error");
+    for (int degree : {5, 10, 20, 50, 100, 200, 400}) {
+        std::vector<double> c = bench::randomValues(degree + 1, -1.0, 1.0, degree);
+        Polynomial p(degree, c);
+        int repeats = degree <= 100 ? 10 : 3;
+        RootFindingStats stats;
+        std::vector<std::complex<double>> aberth = p.findRoots(stats);
+        double aberthTime = bench::bestTime(repeats, [&] { bench::keep(p.findRoots()); });
+        double companionTime = bench::bestTime(repeats, [&] { bench::keep(companionRoots(c)); });
+        std::printf("%7d %12.3f %6d %10.1e %14.3f %10.1e\n", degree, aberthTime * 1e3, stats.iterations,
+                    backwardError(c, aberth), companionTime * 1e3, backwardError(c, companionRoots(c)));
+    }
+
+    const int count = 2000, degree = 20;
+    std::vector<Polynomial> polynomials;
+    for (int k = 0; k < count; k++)
+        polynomials.emplace_back(degree, bench::randomValues(degree + 1, -1.0, 1.0, 1000 + k));
+    double loopTime = bench::bestTime(3, [&] {
+        for (const Polynomial& p : polynomials)
+            bench::keep(p.findRoots());
+    });
+    double batchTime = bench::bestTime(3, [&] { bench::keep(Polynomial::findRootsBatch(polynomials)); });
+    std::printf("\n%d polynomials of degree %d: loop %.1f ms, batch %.1f ms\n", count, degree, loopTime * 1e3,
+                batchTime * 1e3);
+}
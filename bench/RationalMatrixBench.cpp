@@ -0,0 +1,97 @@
+// Exact determinants over Fraction: RationalMatrix (Bareiss on integer-scaled rows)
+// against plain Gaussian elimination in Fraction arithmetic and against Matrix in
+// double. Inputs are Hilbert matrices, whose determinants are tiny and ill-conditioned,
+// and random integer matrices. A rank check on a nearly singular rational matrix
+// closes the run.
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include "BenchUtil.h"
+#include "GenericMatrix.h"
+#include "Matrix.h"
+
+namespace {
+
+// Gaussian elimination in Fraction arithmetic: every update is a full rational add and
+// multiply, and the entries grow with each step
+Fraction naiveDeterminant(RationalMatrix a) {
+    int n = a.getRows();
+    Fraction det(1);
+    for (int c = 0; c < n; c++) {
+        int p = c;
+        while (p < n && a(p, c).isZero())
+            p++;
+        if (p == n)
+            return Fraction(0);
+        if (p != c) {
+            for (int j = 0; j < n; j++)
+                std::swap(a(p, j), a(c, j));
+            det = -det;
+        }
+        det *= a(c, c);
+        for (int i = c + 1; i < n; i++) {
+            Fraction factor = a(i, c) / a(c, c);
+            for (int j = c; j < n; j++)
+                a(i, j) -= factor * a(c, j);
+        }
+    }
+    return det;
+}
+
+Matrix toDouble(const RationalMatrix& a) {
+    Matrix m(a.getRows(), a.getCols());
+    for (int i = 0; i < a.getRows(); i++)
+        for (int j = 0; j < a.getCols(); j++)
+            m.setElement(i, j, a(i, j).toDouble());
+    return m;
+}
+
+void report(const char* name, const RationalMatrix& a) {
+    Matrix m = toDouble(a);
+    int repeats = a.getRows() <= 12 ? 20 : 3;
+    Fraction exact;
+    double bareissTime = bench::bestTime(repeats, [&] { exact = a.determinant(); });
+    double naiveTime = bench::bestTime(repeats, [&] { bench::keep(naiveDeterminant(a)); });
+    double approximate = 0;
+    double doubleTime = bench::bestTime(repeats, [&] { approximate = Matrix(m).determinant(); });
+    bool agree = naiveDeterminant(a) == exact;
+    double error = std::abs(approximate - exact.toDouble()) / std::abs(exact.toDouble());
+    std::printf("%-12s %4d %12.3f %12.3f %6s %12.4f %10.1e\n", name, a.getRows(), bareissTime * 1e3,
+                naiveTime * 1e3, agree ? "yes" : "NO", doubleTime * 1e3, error);
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-12s %4s %12s %12s %6s %12s %10s\n", "matrix", "n", "bareiss ms", "naive ms", "agree",
+                "double ms", "double err");
+    for (int n : {4, 8, 12, 16, 20}) {
+        RationalMatrix hilbert(n, n);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                hilbert(i, j) = Fraction(1, i + j + 1);
+        report("hilbert", hilbert);
+    }
+    for (int n : {4, 8, 16, 32, 48}) {
+        std::vector<double> values = bench::randomValues(static_cast<std::size_t>(n) * n, -100.0, 100.0, n);
+        RationalMatrix integers(n, n);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                integers(i, j) = Fraction(static_cast<long long>(values[i * n + j]));
+        report("integer", integers);
+    }
+
+    // Last row = first + second + 10^-18 in one entry: exactly full rank, singular in double
+    const int n = 8;
+    RationalMatrix nearlySingular(n, n);
+    std::vector<double> values = bench::randomValues(n * n, -100.0, 100.0, 99);
+    for (int i = 0; i < n - 1; i++)
+        for (int j = 0; j < n; j++)
+            nearlySingular(i, j) = Fraction(static_cast<long long>(values[i * n + j]));
+    for (int j = 0; j < n; j++)
+        nearlySingular(n - 1, j) = nearlySingular(0, j) + nearlySingular(1, j);
+    nearlySingular(n - 1, 0) += Fraction(1, 1000000000000000000LL);
+    std::printf("\nnearly singular %dx%d: exact rank %d, double rank %d\n", n, n, nearlySingular.rank(),
+                toDouble(nearlySingular).rank());
+}
@@ -0,0 +1,46 @@
+// Scaling of the parallel Matrix paths from one thread up to the hardware
+// concurrency: operator* (tiles with work stealing) and an elementwise sum (row
+// bands). Speedups are relative to the single-threaded run of the same code.
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "BenchUtil.h"
+#include "Matrix.h"
+
+namespace {
+
+Matrix randomMatrix(int n, unsigned seed) {
+    std::vector<double> values = bench::randomValues(static_cast<std::size_t>(n) * n, -1.0, 1.0, seed);
+    Matrix m(n, n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            m.setElement(i, j, values[i * n + j]);
+    return m;
+}
+
+} // namespace
+
+int main() {
+    const int n = 1024;
+    Matrix a = randomMatrix(n, 1), b = randomMatrix(n, 2), c(n, n);
+    int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<int> counts;
+    for (int t = 1; t < hardware; t *= 2)
+        counts.push_back(t);
+    counts.push_back(hardware);
+
+    std::printf("n = %d, hardware threads = %d\n", n, hardware);
+    std::printf("%8s %12s %9s %12s %9s\n", "threads", "multiply ms", "speedup", "add ms", "speedup");
+    double multiplyBase = 0, addBase = 0;
+    for (int threads : counts) {
+        Matrix::setThreadCount(threads);
+        double multiply = bench::bestTime(3, [&] { c = a * b; });
+        double add = bench::bestTime(10, [&] { c = a + b; });
+        if (threads == 1) {
+            multiplyBase = multiply;
+            addBase = add;
+        }
+        std::printf("%8d %12.2f %9.2f %12.3f %9.2f\n", threads, multiply * 1e3, multiplyBase / multiply,
+                    add * 1e3, addBase / add);
+    }
+}
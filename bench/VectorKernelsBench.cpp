@@ -0,0 +1,122 @@
+// Level-1 kernels against plain loops: bandwidth of dot, axpy and scale at sizes that
+// sit in L1, L2 and main memory, then the relative error of each summation mode on
+// ill-conditioned dot products (Ogita-Rump-Oishi GenDot), with a __float128 reference.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "AlignedAllocator.h"
+#include "BenchUtil.h"
+#include "VectorKernels.h"
+
+namespace {
+
+using vectorkernels::Summation;
+
+__attribute__((noinline)) double naiveDot(const double* a, const double* b, std::size_t n) {
+    double sum = 0;
+    for (std::size_t i = 0; i < n; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+__attribute__((noinline)) void naiveAxpy(double alpha, const double* x, double* y, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++)
+        y[i] += alpha * x[i];
+}
+
+__attribute__((noinline)) void naiveScale(double* a, std::size_t n, double s) {
+    for (std::size_t i = 0; i < n; i++)
+        a[i] *= s;
+}
+
+__float128 exactDot(const std::vector<double>& x, const std::vector<double>& y) {
+    __float128 sum = 0;
+    for (std::size_t i = 0; i < x.size(); i++)
+        sum += static_cast<__float128>(x[i]) * y[i];
+    return sum;
+}
+
+// Dot product of condition number about 10^decades: the first half spans the exponent
+// range, the second half is chosen to cancel the running sum down toward zero
+void illConditioned(std::size_t n, int decades, std::vector<double>& x, std::vector<double>& y, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    double b = decades * std::log2(10.0);
+    std::size_t half = n / 2;
+    x.assign(n, 0);
+    y.assign(n, 0);
+    std::vector<int> exponents(half);
+    for (std::size_t i = 0; i < half; i++)
+        exponents[i] = static_cast<int>(std::lround(std::uniform_real_distribution<double>(0, b / 2)(rng)));
+    exponents[0] = static_cast<int>(std::lround(b / 2)) + 1;
+    exponents[half - 1] = 0;
+    for (std::size_t i = 0; i < half; i++) {
+        x[i] = std::ldexp(unit(rng), exponents[i]);
+        y[i] = std::ldexp(unit(rng), exponents[i]);
+    }
+    for (std::size_t i = half; i < n; i++) {
+        double e = std::lround(b / 2 * (n - 1 - i) / (n - 1 - half));
+        x[i] = std::ldexp(unit(rng), static_cast<int>(e));
+        __float128 partial = 0;
+        for (std::size_t k = 0; k < i; k++)
+            partial += static_cast<__float128>(x[k]) * y[k];
+        y[i] = static_cast<double>((static_cast<__float128>(std::ldexp(unit(rng), static_cast<int>(e))) - partial) / x[i]);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::printf("implementation: %s\n\n", vectorkernels::implementation());
+    std::printf("%10s %8s %12s %12s\n", "n", "op", "naive GB/s", "kernel GB/s");
+    for (std::size_t n : {std::size_t(1) << 10, std::size_t(1) << 14, std::size_t(1) << 23}) {
+        std::vector<double> values = bench::randomValues(2 * n);
+        AlignedVector<double> a(values.begin(), values.begin() + n), b(values.begin() + n, values.end());
+        int repeats = n < (1 << 20) ? 20 : 5;
+        int inner = static_cast<int>(std::max<std::size_t>(1, (std::size_t(1) << 22) / n));
+        double bytes = static_cast<double>(n) * sizeof(double) * inner;
+        auto rate = [&](double streams, auto f) {
+            return streams * bytes / bench::bestTime(repeats, [&] {
+                for (int k = 0; k < inner; k++)
+                    f();
+            }) * 1e-9;
+        };
+        double naive = rate(2, [&] { bench::keep(naiveDot(a.data(), b.data(), n)); });
+        double kernel = rate(2, [&] { bench::keep(vectorkernels::dot(a.data(), b.data(), n)); });
+        std::printf("%10zu %8s %12.1f %12.1f\n", n, "dot", naive, kernel);
+        // axpy reads x and y and writes y; alternate the sign so y stays bounded
+        double alpha = 1e-3;
+        naive = rate(3, [&] { naiveAxpy(alpha, a.data(), b.data(), n); alpha = -alpha; });
+        kernel = rate(3, [&] { vectorkernels::axpy(alpha, a.data(), b.data(), n); alpha = -alpha; });
+        std::printf("%10zu %8s %12.1f %12.1f\n", n, "axpy", naive, kernel);
+        double s = 1.0 + 1e-9;
+        naive = rate(2, [&] { naiveScale(b.data(), n, s); s = 1 / s; });
+        kernel = rate(2, [&] { vectorkernels::scale(b.data(), n, s); s = 1 / s; });
+        std::printf("%10zu %8s %12.1f %12.1f\n", n, "scale", naive, kernel);
+    }
+
+    std::printf("\nrelative error of dot, n = 1000\n");
+    std::printf("%10s %12s %12s %12s %12s\n", "cond ~", "naive", "fast", "pairwise", "compensated");
+    for (int decades : {4, 8, 12, 16, 20, 24, 28}) {
+        std::vector<double> x, y;
+        illConditioned(1000, decades, x, y, decades);
+        double exact = static_cast<double>(exactDot(x, y));
+        auto error = [&](double computed) { return std::min(1.0, std::abs(computed - exact) / std::abs(exact)); };
+        std::printf("%10s %12.1e %12.1e %12.1e %12.1e\n", ("1e" + std::to_string(decades)).c_str(),
+                    error(naiveDot(x.data(), y.data(), x.size())),
+                    error(vectorkernels::dot(x.data(), y.data(), x.size(), Summation::Fast)),
+                    error(vectorkernels::dot(x.data(), y.data(), x.size(), Summation::Pairwise)),
+                    error(vectorkernels::dot(x.data(), y.data(), x.size(), Summation::Compensated)));
+    }
+
+    std::vector<double> values = bench::randomValues(2 << 20);
+    const double* a = values.data();
+    const double* b = values.data() + (1 << 20);
+    std::printf("\ndot over 2^20 values, ms:");
+    for (Summation mode : {Summation::Fast, Summation::Pairwise, Summation::Compensated})
+        std::printf(" %.3f", bench::bestTime(10, [&] { bench::keep(vectorkernels::dot(a, b, 1 << 20, mode)); }) * 1e3);
+    std::printf(" (fast, pairwise, compensated)\n");
+}